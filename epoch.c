@@ -0,0 +1,375 @@
+/** !
+ * Epoch based reclamation
+ *
+ * @file epoch.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/epoch.h>
+
+// Preprocessor definitions
+// Retired allocations wait in one of three lists, by epoch modulo three
+#define EPOCH_LISTS 3
+
+// Platform dependent macros
+#ifdef _WIN64
+#define EPOCH_THREAD_LOCAL __declspec(thread)
+#else
+#define EPOCH_THREAD_LOCAL _Thread_local
+#endif
+
+// Forward declarations
+struct epoch_node_s;
+
+// Type definitions
+typedef struct epoch_node_s epoch_node;
+
+// Structure definitions
+// A record is free IF state is 0 ELSE its thread is inside epoch state >> 1.
+// Records are padded to a cache line, so readers do not share lines
+struct epoch_record_s
+{
+    epoch_record *p_next;
+    size_t        state;
+    char          _padding[64 - sizeof(epoch_record *) - sizeof(size_t)];
+};
+
+// A retired allocation
+struct epoch_node_s
+{
+    epoch_node *p_next;
+    void       *p_pointer;
+};
+
+struct epoch_s
+{
+    size_t        global,
+                  id,
+                  pending;
+    epoch_record *p_records;
+    epoch_node   *p_lists[EPOCH_LISTS];
+};
+
+// Data
+// Domains are numbered, so a thread can tell the domain of its last record
+static size_t epoch_ids = 0;
+
+// The last record of the calling thread, and the number of its domain
+static EPOCH_THREAD_LOCAL struct
+{
+    size_t        id;
+    epoch_record *p_record;
+} epoch_last = { 0 };
+
+/** !
+ * Take a free record, and mark it inside the current epoch
+ *
+ * @param p_epoch  the domain
+ * @param p_record the record
+ *
+ * @return true IF the record was free ELSE false
+ */
+static bool epoch_record_take ( epoch *const p_epoch, epoch_record *const p_record )
+{
+
+    // Initialized data
+    size_t free_state = 0;
+
+    // A stale epoch is safe. It only holds the domain back, until the thread exits
+    return __atomic_compare_exchange_n(&p_record->state, &free_state, ( __atomic_load_n(&p_epoch->global, __ATOMIC_SEQ_CST) << 1 ) | 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+int epoch_construct ( epoch **const pp_epoch )
+{
+
+    // Argument check
+    if ( pp_epoch == (void *) 0 ) goto no_epoch;
+
+    // Initialized data
+    epoch *p_epoch = SET_CALLOC(1, sizeof(epoch));
+
+    // Error check
+    if ( p_epoch == (void *) 0 ) goto no_mem;
+
+    // Number the domain. Zero is never a number
+    p_epoch->id = __atomic_add_fetch(&epoch_ids, 1, __ATOMIC_RELAXED);
+
+    // Return a pointer to the caller
+    *pp_epoch = p_epoch;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_epoch:
+                #ifndef NDEBUG
+                    printf("[set] [epoch] Null pointer provided for parameter \"pp_epoch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t epoch_pending ( const epoch *const p_epoch )
+{
+
+    // Done
+    return ( p_epoch ) ? __atomic_load_n(&p_epoch->pending, __ATOMIC_RELAXED) : 0;
+}
+
+epoch_record *epoch_enter ( epoch *const p_epoch )
+{
+
+    // Argument check
+    if ( p_epoch == (void *) 0 ) return (void *) 0;
+
+    // Initialized data
+    epoch_record *p_record = (void *) 0;
+
+    // Try the last record of the thread first. It is usually still free
+    if ( epoch_last.id == p_epoch->id && epoch_record_take(p_epoch, epoch_last.p_record) ) return epoch_last.p_record;
+
+    // Take any free record
+    for (p_record = __atomic_load_n(&p_epoch->p_records, __ATOMIC_ACQUIRE); p_record; p_record = p_record->p_next)
+        if ( epoch_record_take(p_epoch, p_record) ) goto done;
+
+    // Every record is taken. Make another one
+    p_record = SET_CALLOC(1, sizeof(epoch_record));
+
+    // Error check
+    if ( p_record == (void *) 0 ) return (void *) 0;
+
+    // Take the record, before any other thread can see it
+    (void)epoch_record_take(p_epoch, p_record);
+
+    // Push the record. Records are never removed until the domain is destroyed
+    p_record->p_next = __atomic_load_n(&p_epoch->p_records, __ATOMIC_RELAXED);
+    while ( __atomic_compare_exchange_n(&p_epoch->p_records, &p_record->p_next, p_record, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED) == false );
+
+    done:
+
+    // Remember the record
+    epoch_last.id       = p_epoch->id,
+    epoch_last.p_record = p_record;
+
+    // Done
+    return p_record;
+}
+
+void epoch_exit ( epoch_record *const p_record )
+{
+
+    // Free the record
+    if ( p_record ) __atomic_store_n(&p_record->state, 0, __ATOMIC_RELEASE);
+
+    // Done
+    return;
+}
+
+int epoch_retire ( epoch *const p_epoch, void *const p_pointer )
+{
+
+    // Argument check
+    if ( p_epoch   == (void *) 0 ) goto no_epoch;
+    if ( p_pointer == (void *) 0 ) goto no_pointer;
+
+    // Initialized data
+    epoch_node *p_node = SET_REALLOC(0, sizeof(epoch_node)),
+              **pp_list = (void *) 0;
+
+    // Error check
+    if ( p_node == (void *) 0 ) goto no_mem;
+
+    // The calling thread is inside the domain, so the epoch can advance at most once before the push
+    pp_list = &p_epoch->p_lists[__atomic_load_n(&p_epoch->global, __ATOMIC_SEQ_CST) % EPOCH_LISTS];
+
+    // Push the allocation onto the list of the epoch
+    p_node->p_pointer = p_pointer,
+    p_node->p_next    = __atomic_load_n(pp_list, __ATOMIC_RELAXED);
+    while ( __atomic_compare_exchange_n(pp_list, &p_node->p_next, p_node, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED) == false );
+
+    // Count it
+    __atomic_add_fetch(&p_epoch->pending, 1, __ATOMIC_RELAXED);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_epoch:
+                #ifndef NDEBUG
+                    printf("[set] [epoch] Null pointer provided for parameter \"p_epoch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_pointer:
+                #ifndef NDEBUG
+                    printf("[set] [epoch] Null pointer provided for parameter \"p_pointer\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t epoch_reclaim ( epoch *const p_epoch )
+{
+
+    // Argument check
+    if ( p_epoch == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t      global = __atomic_load_n(&p_epoch->global, __ATOMIC_SEQ_CST),
+                freed  = 0;
+    epoch_node *p_node = (void *) 0;
+
+    // Every thread inside the domain must have seen the current epoch
+    for (epoch_record *p_record = __atomic_load_n(&p_epoch->p_records, __ATOMIC_ACQUIRE); p_record; p_record = p_record->p_next)
+    {
+
+        // Initialized data
+        size_t state = __atomic_load_n(&p_record->state, __ATOMIC_SEQ_CST);
+
+        // A thread is still inside an older epoch
+        if ( ( state & 1 ) && ( state >> 1 ) != global ) return 0;
+    }
+
+    // Advance the epoch, unless another thread got there first
+    if ( __atomic_compare_exchange_n(&p_epoch->global, &global, global + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED) == false ) return 0;
+
+    // The list of the epoch before last is out of reach. The calling thread
+    // is inside the domain, so the epoch can not come around to it again
+    p_node = __atomic_exchange_n(&p_epoch->p_lists[( global + 2 ) % EPOCH_LISTS], (void *) 0, __ATOMIC_ACQUIRE);
+
+    // Free each allocation
+    while ( p_node )
+    {
+
+        // Initialized data
+        epoch_node *p_next = p_node->p_next;
+
+        // Free the allocation, and its node
+        SET_FREE(p_node->p_pointer);
+        SET_FREE(p_node);
+
+        // Next
+        p_node = p_next,
+        freed++;
+    }
+
+    // Uncount them
+    if ( freed ) __atomic_sub_fetch(&p_epoch->pending, freed, __ATOMIC_RELAXED);
+
+    // Done
+    return freed;
+}
+
+int epoch_destroy ( epoch **const pp_epoch )
+{
+
+    // Argument check
+    if ( pp_epoch == (void *) 0 ) goto no_epoch;
+
+    // Initialized data
+    epoch *p_epoch = *pp_epoch;
+
+    // Nothing to do
+    if ( p_epoch == (void *) 0 ) return 1;
+
+    // No more domain for caller
+    *pp_epoch = (void *) 0;
+
+    // Free every retired allocation
+    for (size_t i = 0; i < EPOCH_LISTS; i++)
+    {
+
+        // Initialized data
+        epoch_node *p_node = p_epoch->p_lists[i];
+
+        // Free each allocation, and its node
+        while ( p_node )
+        {
+
+            // Initialized data
+            epoch_node *p_next = p_node->p_next;
+
+            // Free
+            SET_FREE(p_node->p_pointer);
+            SET_FREE(p_node);
+
+            // Next
+            p_node = p_next;
+        }
+    }
+
+    // Free the records
+    while ( p_epoch->p_records )
+    {
+
+        // Initialized data
+        epoch_record *p_next = p_epoch->p_records->p_next;
+
+        // Free the record
+        SET_FREE(p_epoch->p_records);
+
+        // Next
+        p_epoch->p_records = p_next;
+    }
+
+    // Free the domain
+    SET_FREE(p_epoch);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_epoch:
+                #ifndef NDEBUG
+                    printf("[set] [epoch] Null pointer provided for parameter \"pp_epoch\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
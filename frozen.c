@@ -0,0 +1,533 @@
+/** !
+ * Compressed, immutable sorted sequence of integers
+ *
+ * @file frozen.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/frozen.h>
+
+// Preprocessor definitions
+// The quantity of integers in each block
+#define FROZEN_BLOCK 128
+
+// Forward declarations
+struct frozen_skip_s;
+struct frozen_cursor_s;
+
+// Type definitions
+typedef struct frozen_skip_s   frozen_skip;
+typedef struct frozen_cursor_s frozen_cursor;
+
+// Structure definitions
+// The first integer of a block, and the offset of its varints
+struct frozen_skip_s
+{
+    uint64_t first;
+    size_t   offset;
+};
+
+// The skip table and the varints follow the structure, in the same allocation
+struct frozen_s
+{
+    size_t       count;
+    size_t       blocks;
+    size_t       bytes;
+    frozen_skip *p_skips;
+    uint8_t     *p_varints;
+};
+
+// Decodes a frozen sequence one integer at a time
+struct frozen_cursor_s
+{
+    const frozen  *p_frozen;
+    const uint8_t *p_next;
+    size_t         index;
+    size_t         block_end;
+    uint64_t       value;
+};
+
+/** !
+ * Get the quantity of bytes needed to encode an integer as a varint
+ *
+ * @param value the integer
+ *
+ * @return the quantity of bytes
+ */
+static size_t frozen_varint_size ( uint64_t value )
+{
+
+    // Initialized data
+    size_t size = 1;
+
+    // Count the groups of 7 bits
+    while ( value >= 0x80 ) value >>= 7, size++;
+
+    // Done
+    return size;
+}
+
+/** !
+ * Decode a varint
+ *
+ * @param pp_next pointer to the next byte. Advanced past the varint
+ *
+ * @return the integer
+ */
+static uint64_t frozen_varint_decode ( const uint8_t **const pp_next )
+{
+
+    // Initialized data
+    const uint8_t *p    = *pp_next;
+    uint64_t       v    = *p & 0x7f;
+    int            s    = 7;
+
+    // Fast path for one byte
+    if ( ( *p++ & 0x80 ) == 0 ) { *pp_next = p; return v; }
+
+    // Accumulate groups of 7 bits
+    do { v |= (uint64_t) ( *p & 0x7f ) << s, s += 7; } while ( *p++ & 0x80 );
+
+    // Advance the caller
+    *pp_next = p;
+
+    // Done
+    return v;
+}
+
+/** !
+ * Move a cursor to the start of a block
+ *
+ * @param p_cursor the cursor
+ * @param block    the block
+ *
+ * @return void
+ */
+static void frozen_cursor_block ( frozen_cursor *const p_cursor, size_t block )
+{
+
+    // Initialized data
+    const frozen *p_frozen = p_cursor->p_frozen;
+
+    // Load the block
+    p_cursor->index     = block * FROZEN_BLOCK,
+    p_cursor->block_end = ( p_cursor->index + FROZEN_BLOCK < p_frozen->count ) ? p_cursor->index + FROZEN_BLOCK : p_frozen->count,
+    p_cursor->value     = p_frozen->p_skips[block].first,
+    p_cursor->p_next    = &p_frozen->p_varints[p_frozen->p_skips[block].offset];
+
+    // Done
+    return;
+}
+
+/** !
+ * Construct a cursor at the first integer of a frozen sequence
+ *
+ * @param p_cursor return
+ * @param p_frozen the frozen sequence
+ *
+ * @return true IF the frozen sequence has an integer ELSE false
+ */
+static bool frozen_cursor_construct ( frozen_cursor *const p_cursor, const frozen *const p_frozen )
+{
+
+    // Initialize the cursor
+    *p_cursor = (frozen_cursor) { .p_frozen = p_frozen };
+
+    // Empty
+    if ( p_frozen->count == 0 ) return false;
+
+    // Load the first block
+    frozen_cursor_block(p_cursor, 0);
+
+    // Done
+    return true;
+}
+
+/** !
+ * Advance a cursor to the next integer
+ *
+ * @param p_cursor the cursor
+ *
+ * @return true IF the cursor has an integer ELSE false
+ */
+static bool frozen_cursor_next ( frozen_cursor *const p_cursor )
+{
+
+    // Advance
+    p_cursor->index++;
+
+    // End of the sequence
+    if ( p_cursor->index == p_cursor->p_frozen->count ) return false;
+
+    // End of the block
+    if ( p_cursor->index == p_cursor->block_end )
+    {
+        frozen_cursor_block(p_cursor, p_cursor->index / FROZEN_BLOCK);
+        return true;
+    }
+
+    // Decode the next difference
+    p_cursor->value += frozen_varint_decode(&p_cursor->p_next) + 1;
+
+    // Done
+    return true;
+}
+
+/** !
+ * Advance a cursor to the first integer not less than a target, skipping
+ * blocks that end before the target
+ *
+ * @param p_cursor the cursor
+ * @param target   the target
+ *
+ * @return true IF the cursor has an integer ELSE false
+ */
+static bool frozen_cursor_seek ( frozen_cursor *const p_cursor, uint64_t target )
+{
+
+    // Initialized data
+    const frozen *p_frozen = p_cursor->p_frozen;
+    size_t        block    = p_cursor->index / FROZEN_BLOCK,
+                  lo       = block + 1,
+                  hi       = p_frozen->blocks;
+
+    // Fast exit
+    if ( p_cursor->value >= target ) return true;
+
+    // Find the first block that starts after the target
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        // Narrow the range
+        if ( p_frozen->p_skips[mid].first <= target ) lo = mid + 1;
+        else                                          hi = mid;
+    }
+
+    // Jump to the last block that starts at or before the target
+    if ( lo - 1 > block ) frozen_cursor_block(p_cursor, lo - 1);
+
+    // Decode until the target
+    while ( p_cursor->value < target )
+        if ( frozen_cursor_next(p_cursor) == false ) return false;
+
+    // Done
+    return true;
+}
+
+int frozen_construct ( frozen **const pp_frozen, void *const *const pp_elements, size_t count )
+{
+
+    // Argument check
+    if ( pp_frozen   == (void *) 0 ) goto no_frozen;
+    if ( pp_elements == (void *) 0 && count ) goto no_elements;
+
+    // Initialized data
+    frozen  *p_frozen = (void *) 0;
+    size_t   blocks   = ( count + FROZEN_BLOCK - 1 ) / FROZEN_BLOCK,
+             bytes    = 0;
+    uint8_t *p_out    = (void *) 0;
+
+    // Measure the varints
+    for (size_t i = 1; i < count; i++)
+        if ( i % FROZEN_BLOCK ) bytes += frozen_varint_size((uint64_t) (uintptr_t) pp_elements[i] - (uint64_t) (uintptr_t) pp_elements[i - 1] - 1);
+
+    // Allocate the frozen sequence, the skip table, and the varints at once
+    p_frozen = SET_REALLOC(0, sizeof(frozen) + blocks * sizeof(frozen_skip) + bytes);
+
+    // Error check
+    if ( p_frozen == (void *) 0 ) goto no_mem;
+
+    // Initialize the frozen sequence
+    *p_frozen = (frozen)
+    {
+        .count     = count,
+        .blocks    = blocks,
+        .bytes     = bytes,
+        .p_skips   = (frozen_skip *) ( p_frozen + 1 ),
+        .p_varints = (uint8_t *) ( p_frozen + 1 ) + blocks * sizeof(frozen_skip)
+    };
+
+    // Initialized data
+    p_out = p_frozen->p_varints;
+
+    // Encode each integer
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        uint64_t value = (uint64_t) (uintptr_t) pp_elements[i];
+
+        // The first integer of a block goes in the skip table
+        if ( i % FROZEN_BLOCK == 0 )
+        {
+            p_frozen->p_skips[i / FROZEN_BLOCK] = (frozen_skip) { .first = value, .offset = (size_t) ( p_out - p_frozen->p_varints ) };
+            continue;
+        }
+
+        // The rest of the block are differences
+        value -= (uint64_t) (uintptr_t) pp_elements[i - 1] + 1;
+
+        // Encode the difference
+        while ( value >= 0x80 ) *p_out++ = (uint8_t) ( value | 0x80 ), value >>= 7;
+        *p_out++ = (uint8_t) value;
+    }
+
+    // Return a pointer to the caller
+    *pp_frozen = p_frozen;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_frozen:
+                #ifndef NDEBUG
+                    printf("[set] [frozen] Null pointer provided for parameter \"pp_frozen\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_elements:
+                #ifndef NDEBUG
+                    printf("[set] [frozen] Null pointer provided for parameter \"pp_elements\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool frozen_contains ( const frozen *const p_frozen, const void *const p_element )
+{
+
+    // Argument check
+    if ( p_frozen == (void *) 0 ) return false;
+
+    // Initialized data
+    frozen_cursor cursor = { 0 };
+    uint64_t      value  = (uint64_t) (uintptr_t) p_element;
+
+    // Empty
+    if ( frozen_cursor_construct(&cursor, p_frozen) == false ) return false;
+
+    // Seek the integer
+    return frozen_cursor_seek(&cursor, value) && cursor.value == value;
+}
+
+bool frozen_isdisjoint ( const frozen *const p_a, const frozen *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return true;
+    if ( p_b == (void *) 0 ) return true;
+
+    // Initialized data
+    frozen_cursor a     = { 0 },
+                  b     = { 0 };
+    bool          a_any = frozen_cursor_construct(&a, p_a),
+                  b_any = frozen_cursor_construct(&b, p_b);
+
+    // Leapfrog, stopping at the first common integer
+    while ( a_any && b_any )
+    {
+        if      ( a.value < b.value ) a_any = frozen_cursor_seek(&a, b.value);
+        else if ( b.value < a.value ) b_any = frozen_cursor_seek(&b, a.value);
+        else                          return false;
+    }
+
+    // No common integers
+    return true;
+}
+
+bool frozen_issubset ( const frozen *const p_a, const frozen *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return true;
+    if ( p_b == (void *) 0 ) return p_a->count == 0;
+
+    // A larger sequence is never a subset
+    if ( p_a->count > p_b->count ) return false;
+
+    // Initialized data
+    frozen_cursor a     = { 0 },
+                  b     = { 0 };
+    bool          a_any = frozen_cursor_construct(&a, p_a),
+                  b_any = frozen_cursor_construct(&b, p_b);
+
+    // Seek each integer of A in B, stopping at the first one that is missing
+    for (; a_any; a_any = frozen_cursor_next(&a))
+    {
+
+        // Seek
+        if ( b_any ) b_any = frozen_cursor_seek(&b, a.value);
+
+        // Missing integer
+        if ( b_any == false || b.value != a.value ) return false;
+    }
+
+    // Every integer of A is in B
+    return true;
+}
+
+size_t frozen_count ( const frozen *const p_frozen )
+{
+
+    // Done
+    return ( p_frozen ) ? p_frozen->count : 0;
+}
+
+size_t frozen_size ( const frozen *const p_frozen )
+{
+
+    // Done
+    return ( p_frozen ) ? sizeof(frozen) + p_frozen->blocks * sizeof(frozen_skip) + p_frozen->bytes : 0;
+}
+
+size_t frozen_contents ( const frozen *const p_frozen, void **const pp_contents )
+{
+
+    // Argument check
+    if ( p_frozen    == (void *) 0 ) return 0;
+    if ( pp_contents == (void *) 0 ) return 0;
+
+    // Initialized data
+    frozen_cursor cursor = { 0 };
+    size_t        k      = 0;
+
+    // Decode each integer
+    for (bool any = frozen_cursor_construct(&cursor, p_frozen); any; any = frozen_cursor_next(&cursor))
+        pp_contents[k++] = (void *) (uintptr_t) cursor.value;
+
+    // Done
+    return k;
+}
+
+size_t frozen_intersection ( const frozen *const p_a, const frozen *const p_b, void **const pp_result )
+{
+
+    // Argument check
+    if ( p_a       == (void *) 0 ) return 0;
+    if ( p_b       == (void *) 0 ) return 0;
+
+    // Initialized data
+    frozen_cursor a     = { 0 },
+                  b     = { 0 };
+    bool          a_any = frozen_cursor_construct(&a, p_a),
+                  b_any = frozen_cursor_construct(&b, p_b);
+    size_t        k     = 0;
+
+    // Leapfrog. Each cursor seeks the other, skipping whole blocks
+    while ( a_any && b_any )
+    {
+
+        // Advance the lesser cursor
+        if      ( a.value < b.value ) a_any = frozen_cursor_seek(&a, b.value);
+        else if ( b.value < a.value ) b_any = frozen_cursor_seek(&b, a.value);
+
+        // Common integer
+        else
+        {
+            if ( pp_result ) pp_result[k] = (void *) (uintptr_t) a.value;
+            k++;
+            a_any = frozen_cursor_next(&a),
+            b_any = frozen_cursor_next(&b);
+        }
+    }
+
+    // Done
+    return k;
+}
+
+int frozen_foreach_i ( const frozen *const p_frozen, void (*const function)(void *const value, size_t index) )
+{
+
+    // Argument check
+    if ( p_frozen == (void *) 0 ) goto no_frozen;
+    if ( function == (void *) 0 ) goto no_function;
+
+    // Initialized data
+    frozen_cursor cursor = { 0 };
+
+    // Decode each integer
+    for (bool any = frozen_cursor_construct(&cursor, p_frozen); any; any = frozen_cursor_next(&cursor))
+        function((void *) (uintptr_t) cursor.value, cursor.index);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_frozen:
+                #ifndef NDEBUG
+                    printf("[set] [frozen] Null pointer provided for parameter \"p_frozen\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    printf("[set] [frozen] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int frozen_destroy ( frozen **const pp_frozen )
+{
+
+    // Argument check
+    if ( pp_frozen == (void *) 0 ) goto no_frozen;
+
+    // Free the frozen sequence, along with its skip table and varints
+    SET_FREE(*pp_frozen);
+
+    // No more frozen sequence for caller
+    *pp_frozen = (void *) 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_frozen:
+                #ifndef NDEBUG
+                    printf("[set] [frozen] Null pointer provided for parameter \"pp_frozen\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
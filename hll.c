@@ -0,0 +1,310 @@
+/** !
+ * HyperLogLog cardinality sketch
+ *
+ * @file hll.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/hll.h>
+
+// Standard library
+#include <math.h>
+
+// Structure definitions
+// The registers follow the structure, in the same allocation
+struct hll_s
+{
+    int     precision;
+    size_t  max;
+    uint8_t registers[];
+};
+
+/** !
+ * Compute 2 ^ -rank by writing the exponent of a double, without dividing
+ *
+ * @param rank the rank
+ *
+ * @return 2 ^ -rank
+ */
+static inline double hll_inverse_power ( uint8_t rank )
+{
+
+    // Initialized data
+    uint64_t bits  = (uint64_t) ( 1023 - rank ) << 52;
+    double   value = 0;
+
+    // Reinterpret the bits
+    memcpy(&value, &bits, sizeof(double));
+
+    // Done
+    return value;
+}
+
+/** !
+ * Estimate a cardinality from a register sum
+ *
+ * @param max   the quantity of registers
+ * @param sum   the sum of 2 ^ -register over every register
+ * @param zeros the quantity of registers that are zero
+ *
+ * @return the estimate
+ */
+static double hll_estimate_from ( size_t max, double sum, size_t zeros )
+{
+
+    // Initialized data
+    double m     = (double) max,
+           alpha = ( max == 16 ) ? 0.673 : ( max == 32 ) ? 0.697 : ( max == 64 ) ? 0.709 : 0.7213 / ( 1.0 + 1.079 / m ),
+           e     = alpha * m * m / sum;
+
+    // Small cardinalities are estimated by linear counting
+    if ( e <= 2.5 * m && zeros ) e = m * log(m / (double) zeros);
+
+    // Done
+    return e;
+}
+
+int hll_construct ( hll **const pp_hll, int precision )
+{
+
+    // Argument check
+    if ( pp_hll    == (void *) 0        ) goto no_hll;
+    if ( precision <  HLL_PRECISION_MIN ) goto precision_out_of_range;
+    if ( precision >  HLL_PRECISION_MAX ) goto precision_out_of_range;
+
+    // Initialized data
+    size_t  max   = (size_t) 1 << precision;
+    hll    *p_hll = SET_CALLOC(1, sizeof(hll) + max);
+
+    // Error check
+    if ( p_hll == (void *) 0 ) goto no_mem;
+
+    // Store the size
+    p_hll->precision = precision,
+    p_hll->max       = max;
+
+    // Return a pointer to the caller
+    *pp_hll = p_hll;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_hll:
+                #ifndef NDEBUG
+                    printf("[set] [hll] Null pointer provided for parameter \"pp_hll\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            precision_out_of_range:
+                #ifndef NDEBUG
+                    printf("[set] [hll] Parameter \"precision\" must be between %d and %d in call to function \"%s\"\n", HLL_PRECISION_MIN, HLL_PRECISION_MAX, __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int hll_precision ( const hll *const p_hll )
+{
+
+    // Done
+    return ( p_hll ) ? p_hll->precision : 0;
+}
+
+double hll_estimate ( const hll *const p_hll )
+{
+
+    // Argument check
+    if ( p_hll == (void *) 0 ) return 0;
+
+    // Initialized data
+    double sum   = 0;
+    size_t zeros = 0;
+
+    // Accumulate the registers
+    for (size_t i = 0; i < p_hll->max; i++)
+        sum   += hll_inverse_power(p_hll->registers[i]),
+        zeros += p_hll->registers[i] == 0;
+
+    // Done
+    return hll_estimate_from(p_hll->max, sum, zeros);
+}
+
+double hll_union_estimate ( const hll *const p_a, const hll *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return -1;
+    if ( p_b == (void *) 0 ) return -1;
+    if ( p_a->precision != p_b->precision ) return -1;
+
+    // Initialized data
+    double sum   = 0;
+    size_t zeros = 0;
+
+    // Accumulate the greater of each pair of registers
+    for (size_t i = 0; i < p_a->max; i++)
+    {
+
+        // Initialized data
+        uint8_t r = ( p_a->registers[i] > p_b->registers[i] ) ? p_a->registers[i] : p_b->registers[i];
+
+        // Accumulate
+        sum   += hll_inverse_power(r),
+        zeros += r == 0;
+    }
+
+    // Done
+    return hll_estimate_from(p_a->max, sum, zeros);
+}
+
+double hll_intersection_estimate ( const hll *const p_a, const hll *const p_b )
+{
+
+    // Initialized data
+    double u = hll_union_estimate(p_a, p_b),
+           a = 0,
+           b = 0,
+           e = 0;
+
+    // Error check
+    if ( u < 0 ) return -1;
+
+    // Inclusion and exclusion
+    a = hll_estimate(p_a),
+    b = hll_estimate(p_b),
+    e = a + b - u;
+
+    // Clamp to the possible range
+    if ( e < 0 ) e = 0;
+    if ( e > a ) e = a;
+    if ( e > b ) e = b;
+
+    // Done
+    return e;
+}
+
+void hll_add ( hll *const p_hll, uint64_t hash )
+{
+
+    // Initialized data
+    size_t   i    = (size_t) ( hash >> ( 64 - p_hll->precision ) );
+    uint64_t rest = ( hash << p_hll->precision ) | ( 1ULL << ( p_hll->precision - 1 ) );
+    uint8_t  rank = (uint8_t) ( __builtin_clzll(rest) + 1 );
+
+    // Keep the greatest rank
+    if ( rank > p_hll->registers[i] ) p_hll->registers[i] = rank;
+
+    // Done
+    return;
+}
+
+int hll_merge ( hll *const p_a, const hll *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+    if ( p_a->precision != p_b->precision ) goto precision_mismatch;
+
+    // Keep the greater of each pair of registers
+    for (size_t i = 0; i < p_a->max; i++)
+        if ( p_b->registers[i] > p_a->registers[i] ) p_a->registers[i] = p_b->registers[i];
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] [hll] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] [hll] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            precision_mismatch:
+                #ifndef NDEBUG
+                    printf("[set] [hll] Sketches have different precisions in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void hll_clear ( hll *const p_hll )
+{
+
+    // Zero the registers
+    if ( p_hll ) memset(p_hll->registers, 0, p_hll->max);
+
+    // Done
+    return;
+}
+
+int hll_destroy ( hll **const pp_hll )
+{
+
+    // Argument check
+    if ( pp_hll == (void *) 0 ) goto no_hll;
+
+    // Free the sketch, along with its registers
+    SET_FREE(*pp_hll);
+
+    // No more sketch for caller
+    *pp_hll = (void *) 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_hll:
+                #ifndef NDEBUG
+                    printf("[set] [hll] Null pointer provided for parameter \"pp_hll\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
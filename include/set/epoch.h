@@ -0,0 +1,115 @@
+/** !
+ * @file set/epoch.h
+ *
+ * @author Jacob Smith
+ *
+ * Epoch based reclamation, for structures that readers traverse without
+ * locking.
+ *
+ * A thread enters the domain before it reads shared memory, and exits
+ * when it holds no more pointers into it. Memory that was unlinked is
+ * retired instead of freed. The domain counts epochs, and only advances
+ * once every thread inside it has seen the current epoch, so memory
+ * retired in an epoch is freed two epochs later, after every thread that
+ * could have seen it has left.
+ *
+ * A thread may retire memory, and reclaim, only while it is inside the
+ * domain. Threads inside the domain never wait; a thread that stays
+ * inside for a long time only delays reclamation.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct epoch_s;
+struct epoch_record_s;
+
+// Type definitions
+typedef struct epoch_s        epoch;
+typedef struct epoch_record_s epoch_record;
+
+// Constructors
+/** !
+ *  Construct a reclamation domain
+ *
+ * @param pp_epoch return
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int epoch_construct ( epoch **const pp_epoch );
+
+// Accessors
+/** !
+ *  Get the quantity of retired allocations that have not been freed
+ *
+ * @param p_epoch the domain
+ *
+ * @return the quantity of retired allocations
+ */
+DLLEXPORT size_t epoch_pending ( const epoch *const p_epoch );
+
+// Functions
+/** !
+ *  Enter a domain, before reading memory that it protects. Entries do
+ *  not nest
+ *
+ * @param p_epoch the domain
+ *
+ * @sa epoch_exit
+ *
+ * @return the record of the calling thread IF successful ELSE null
+ */
+DLLEXPORT epoch_record *epoch_enter ( epoch *const p_epoch );
+
+/** !
+ *  Exit a domain. The calling thread must not use any pointer that it
+ *  read inside the domain
+ *
+ * @param p_record the record returned by epoch_enter
+ *
+ * @return void
+ */
+DLLEXPORT void epoch_exit ( epoch_record *const p_record );
+
+/** !
+ *  Retire an allocation that no reader can reach anymore. It is freed
+ *  once every thread that could have read it has exited. The calling
+ *  thread must be inside the domain
+ *
+ * @param p_epoch   the domain
+ * @param p_pointer the allocation
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int epoch_retire ( epoch *const p_epoch, void *const p_pointer );
+
+/** !
+ *  Advance the epoch IF every thread inside the domain has seen it, and
+ *  free the allocations that no thread can read anymore. The calling
+ *  thread must be inside the domain
+ *
+ * @param p_epoch the domain
+ *
+ * @return the quantity of allocations freed
+ */
+DLLEXPORT size_t epoch_reclaim ( epoch *const p_epoch );
+
+// Destructors
+/** !
+ *  Destroy a domain, and free every retired allocation. No thread may be
+ *  inside the domain
+ *
+ * @param pp_epoch pointer to domain pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int epoch_destroy ( epoch **const pp_epoch );
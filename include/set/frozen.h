@@ -0,0 +1,137 @@
+/** !
+ * @file set/frozen.h
+ *
+ * @author Jacob Smith
+ *
+ * Compressed, immutable sorted sequence of integers, for cold sets.
+ *
+ * Integers are split into blocks of 128. A skip table holds the first
+ * integer of each block, and the offset of the block. The rest of each
+ * block is stored as the differences between neighbors, minus one, in
+ * little endian base 128 varints. Dense sets of IDs cost one or two
+ * bytes per integer, instead of eight.
+ *
+ * Integers are exchanged with the set library as ( void * ) casts, in
+ * ascending order.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct frozen_s;
+
+// Type definitions
+typedef struct frozen_s frozen;
+
+// Constructors
+/** !
+ *  Construct a frozen sequence from integers in strictly ascending order
+ *
+ * @param pp_frozen   return
+ * @param pp_elements the integers, as ( void * ) casts
+ * @param count       the quantity of integers
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int frozen_construct ( frozen **const pp_frozen, void *const *const pp_elements, size_t count );
+
+// Accessors
+/** !
+ *  Test if a frozen sequence contains an integer
+ *
+ * @param p_frozen  the frozen sequence
+ * @param p_element the integer, as a ( void * ) cast
+ *
+ * @return true IF the integer is in the frozen sequence ELSE false
+ */
+DLLEXPORT bool frozen_contains ( const frozen *const p_frozen, const void *const p_element );
+
+/** !
+ *  Test if two frozen sequences have no integers in common
+ *
+ * @param p_a frozen sequence A
+ * @param p_b frozen sequence B
+ *
+ * @return true IF the frozen sequences are disjoint ELSE false
+ */
+DLLEXPORT bool frozen_isdisjoint ( const frozen *const p_a, const frozen *const p_b );
+
+/** !
+ *  Test if every integer of frozen sequence A is in frozen sequence B
+ *
+ * @param p_a frozen sequence A
+ * @param p_b frozen sequence B
+ *
+ * @return true IF frozen sequence A is a subset of frozen sequence B ELSE false
+ */
+DLLEXPORT bool frozen_issubset ( const frozen *const p_a, const frozen *const p_b );
+
+/** !
+ *  Get the quantity of integers in a frozen sequence
+ *
+ * @param p_frozen the frozen sequence
+ *
+ * @return the quantity of integers
+ */
+DLLEXPORT size_t frozen_count ( const frozen *const p_frozen );
+
+/** !
+ *  Get the quantity of bytes used by a frozen sequence
+ *
+ * @param p_frozen the frozen sequence
+ *
+ * @return the quantity of bytes
+ */
+DLLEXPORT size_t frozen_size ( const frozen *const p_frozen );
+
+/** !
+ *  Decode the integers of a frozen sequence, in ascending order
+ *
+ * @param p_frozen    the frozen sequence
+ * @param pp_contents return. Must have room for frozen_count integers
+ *
+ * @return the quantity of integers written
+ */
+DLLEXPORT size_t frozen_contents ( const frozen *const p_frozen, void **const pp_contents );
+
+/** !
+ *  Intersect two frozen sequences without decoding either of them in
+ *  full. Blocks that can not hold a common integer are skipped
+ *
+ * @param p_a       frozen sequence A
+ * @param p_b       frozen sequence B
+ * @param pp_result return. Must have room for the smaller frozen_count. May be null, to only count
+ *
+ * @return the quantity of integers in the intersection
+ */
+DLLEXPORT size_t frozen_intersection ( const frozen *const p_a, const frozen *const p_b, void **const pp_result );
+
+// Iterators
+/** !
+ *  Call a function on each integer in a frozen sequence, in ascending order
+ *
+ * @param p_frozen the frozen sequence
+ * @param function pointer to a function of type void (*)(void *value, size_t index)
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int frozen_foreach_i ( const frozen *const p_frozen, void (*const function)(void *const value, size_t index) );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a frozen sequence
+ *
+ * @param pp_frozen pointer to frozen sequence pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int frozen_destroy ( frozen **const pp_frozen );
@@ -0,0 +1,143 @@
+/** !
+ * @file set/kernel.h
+ *
+ * @author Jacob Smith
+ *
+ * Set operation kernels for sorted arrays of unsigned integers.
+ *
+ * Each kernel has a scalar implementation, and where the processor
+ * supports it, an SSE4.2 or AVX2 implementation that compares four keys
+ * at a time. The fastest implementation is selected at runtime. The union
+ * of 64 bit keys is always scalar.
+ *
+ * Inputs must be sorted in ascending order, and free of duplicates.
+ * Outputs are sorted in ascending order, and free of duplicates.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+
+// set
+#include <set/set.h>
+
+// Initializer
+/** !
+ * Select the fastest kernels for this processor. Called by set_init
+ *
+ * @param void
+ *
+ * @return void
+ */
+DLLEXPORT void set_kernel_init ( void );
+
+// 32 bit kernels
+/** !
+ *  Intersect two sorted arrays of 32 bit keys
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ * @param p_result return. Must have room for the smaller of a_count and b_count keys
+ *
+ * @return the quantity of keys in the intersection
+ */
+DLLEXPORT size_t set_kernel_intersection_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result );
+
+/** !
+ *  Count the keys that are in both of two sorted arrays of 32 bit keys,
+ *  without writing the intersection
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ *
+ * @return the quantity of keys in the intersection
+ */
+DLLEXPORT size_t set_kernel_intersection_count_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count );
+
+/** !
+ *  Union two sorted arrays of 32 bit keys
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ * @param p_result return. Must have room for a_count + b_count keys
+ *
+ * @return the quantity of keys in the union
+ */
+DLLEXPORT size_t set_kernel_union_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result );
+
+/** !
+ *  Compute the keys of a sorted array of 32 bit keys that are not in
+ *  another sorted array of 32 bit keys
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ * @param p_result return. Must have room for a_count keys
+ *
+ * @return the quantity of keys in the difference
+ */
+DLLEXPORT size_t set_kernel_difference_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result );
+
+// 64 bit kernels
+/** !
+ *  Intersect two sorted arrays of 64 bit keys
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ * @param p_result return. Must have room for the smaller of a_count and b_count keys
+ *
+ * @return the quantity of keys in the intersection
+ */
+DLLEXPORT size_t set_kernel_intersection_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result );
+
+/** !
+ *  Count the keys that are in both of two sorted arrays of 64 bit keys,
+ *  without writing the intersection
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ *
+ * @return the quantity of keys in the intersection
+ */
+DLLEXPORT size_t set_kernel_intersection_count_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count );
+
+/** !
+ *  Union two sorted arrays of 64 bit keys
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ * @param p_result return. Must have room for a_count + b_count keys
+ *
+ * @return the quantity of keys in the union
+ */
+DLLEXPORT size_t set_kernel_union_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result );
+
+/** !
+ *  Compute the keys of a sorted array of 64 bit keys that are not in
+ *  another sorted array of 64 bit keys
+ *
+ * @param p_a      sorted array A
+ * @param a_count  quantity of keys in array A
+ * @param p_b      sorted array B
+ * @param b_count  quantity of keys in array B
+ * @param p_result return. Must have room for a_count keys
+ *
+ * @return the quantity of keys in the difference
+ */
+DLLEXPORT size_t set_kernel_difference_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result );
@@ -0,0 +1,107 @@
+/** !
+ * @file set/lockfree.h
+ *
+ * @author Jacob Smith
+ *
+ * Lock free hashed set.
+ *
+ * Elements live in an open addressing table. A slot is claimed for a key
+ * by compare and swap, and keeps that key for the life of the table. A
+ * second word in the slot says whether the key is present, so removing
+ * an element leaves a tombstone, and adding it again revives the slot.
+ * Add, remove and membership tests are linearizable, and no thread ever
+ * waits for another. Since tombstones keep their keys, elements compared
+ * by a custom equality function must stay valid until the set is 
+ * destroyed, even after they are removed.
+ *
+ * When a table fills up, a bigger one is chained after it, and every
+ * thread that touches the set copies a chunk of slots until the old
+ * table is empty. A slot that is being copied is frozen, so a thread that
+ * meets a frozen slot copies it, and continues in the next table. Lookups
+ * never lock, even during a resize. Tables that were outgrown are freed 
+ * by epoch based reclamation, once every operation that could be probing
+ * them has finished.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct lockfree_s;
+
+// Type definitions
+typedef struct lockfree_s lockfree;
+
+// Constructors
+/** !
+ *  Construct an empty lock free set
+ *
+ * @param pp_lockfree  return
+ * @param size         the expected quantity of elements. The set grows as elements are added
+ * @param pfn_is_equal function for testing equality of elements IF parameter is not null ELSE default
+ * @param pfn_hash     function for hashing elements IF parameter is not null ELSE default
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int lockfree_construct ( lockfree **const pp_lockfree, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash );
+
+// Accessors
+/** !
+ *  Test if an element is in a lock free set
+ *
+ * @param p_lockfree the lock free set
+ * @param p_element  the element
+ *
+ * @return true IF the element is in the lock free set ELSE false
+ */
+DLLEXPORT bool lockfree_contains ( lockfree *const p_lockfree, const void *const p_element );
+
+/** !
+ *  Get the quantity of elements in a lock free set. The count is exact
+ *  when no writer is running
+ *
+ * @param p_lockfree the lock free set
+ *
+ * @return the quantity of elements
+ */
+DLLEXPORT size_t lockfree_count ( const lockfree *const p_lockfree );
+
+// Mutators
+/** !
+ *  Add an element to a lock free set, unless it is already there
+ *
+ * @param p_lockfree the lock free set
+ * @param p_element  the element
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int lockfree_add ( lockfree *const p_lockfree, void *const p_element );
+
+/** !
+ *  Remove an element from a lock free set. When many threads remove the 
+ *  same element at once, exactly one of them removes it
+ *
+ * @param p_lockfree the lock free set
+ * @param p_element  the element
+ *
+ * @return 1 IF the element was removed ELSE 0
+ */
+DLLEXPORT int lockfree_remove ( lockfree *const p_lockfree, void *const p_element );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a lock free set. No other thread may be using it
+ *
+ * @param pp_lockfree pointer to lock free set pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int lockfree_destroy ( lockfree **const pp_lockfree );
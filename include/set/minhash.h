@@ -0,0 +1,95 @@
+/** !
+ * @file set/minhash.h
+ *
+ * @author Jacob Smith
+ *
+ * MinHash signature, for estimating the Jaccard similarity of sets.
+ *
+ * A signature of k slots keeps, in each slot, the least value of an
+ * independent hash function over every element. Two sets agree on a
+ * slot with probability |A ∩ B| / |A ∪ B|, so the fraction of agreeing
+ * slots estimates the Jaccard similarity, with a standard error of
+ * about 1 / sqrt(k).
+ *
+ * Signatures only grow. Removing an element from a set does not remove
+ * it from the signature.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct minhash_s;
+
+// Type definitions
+typedef struct minhash_s minhash;
+
+// Constructors
+/** !
+ *  Construct an empty signature
+ *
+ * @param pp_minhash return
+ * @param k          the quantity of slots
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int minhash_construct ( minhash **const pp_minhash, size_t k );
+
+// Accessors
+/** !
+ *  Get the quantity of slots in a signature
+ *
+ * @param p_minhash the signature
+ *
+ * @return the quantity of slots
+ */
+DLLEXPORT size_t minhash_size ( const minhash *const p_minhash );
+
+/** !
+ *  Estimate the Jaccard similarity of the sets of two signatures, in O(k)
+ *
+ * @param p_a signature A
+ * @param p_b signature B. Must have as many slots as signature A
+ *
+ * @return the estimate, from 0 to 1, IF the sizes match ELSE -1
+ */
+DLLEXPORT double minhash_jaccard ( const minhash *const p_a, const minhash *const p_b );
+
+// Mutators
+/** !
+ *  Add a hash to a signature. Hashes must be well mixed
+ *
+ * @param p_minhash the signature
+ * @param hash      the hash
+ *
+ * @return void
+ */
+DLLEXPORT void minhash_add ( minhash *const p_minhash, uint64_t hash );
+
+/** !
+ *  Merge signature B into signature A, so signature A signs the union
+ *
+ * @param p_a signature A
+ * @param p_b signature B. Must have as many slots as signature A
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int minhash_merge ( minhash *const p_a, const minhash *const p_b );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a signature
+ *
+ * @param pp_minhash pointer to signature pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int minhash_destroy ( minhash **const pp_minhash );
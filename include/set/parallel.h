@@ -0,0 +1,135 @@
+/** !
+ * @file set/parallel.h
+ *
+ * @author Jacob Smith
+ *
+ * Worker threads, locks and hashing for set operations.
+ *
+ * A batch runs the same task over an array of arguments, one thread per
+ * argument. The calling thread runs the first argument itself, and waits
+ * for the rest. Tasks must not lock a set that the caller has locked.
+ *
+ * A reader/writer lock admits any quantity of readers, or one writer.
+ * Waiting writers are served before new readers, so a steady stream of
+ * readers does not starve them. Locks are not recursive.
+ *
+ * Hashed sets, sharded sets and lock free sets mix each hash the same way.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Platform dependent headers
+#ifndef _WIN64
+#include <pthread.h>
+#endif
+
+// Type definitions
+#ifdef _WIN64
+    typedef struct { void *p_lock; } set_rwlock; // Same layout as SRWLOCK
+#else
+    typedef pthread_rwlock_t set_rwlock;
+#endif
+
+/** !
+ *  @brief The type definition for a task. Returns 1 on success, 0 on error
+ */
+typedef int (set_task_fn)(void *const p_argument);
+
+// Constructors
+/** !
+ *  Construct a reader/writer lock
+ *
+ * @param p_rwlock the lock
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_rwlock_create ( set_rwlock *const p_rwlock );
+
+// Accessors
+/** !
+ *  Get the quantity of hardware threads
+ *
+ * @param void
+ *
+ * @return the quantity of hardware threads, at least 1
+ */
+DLLEXPORT size_t set_parallel_hardware_threads ( void );
+
+// Functions
+/** !
+ *  Run a task once for each argument, each on its own thread, and wait
+ *  for every task to finish
+ *
+ * @param pfn_task    the task
+ * @param p_arguments the arguments, in an array
+ * @param size        the size of each argument, in bytes
+ * @param count       the quantity of arguments
+ *
+ * @return 1 IF every task succeeded ELSE 0
+ */
+DLLEXPORT int set_parallel_run ( set_task_fn *pfn_task, void *const p_arguments, size_t size, size_t count );
+
+/** !
+ *  Scramble the bits of a hash, so weak hash functions (like pointers) 
+ *  still spread evenly across an index
+ *
+ * @param hash the hash
+ *
+ * @return the mixed hash
+ */
+DLLEXPORT unsigned long long set_hash_mix ( unsigned long long hash );
+
+/** !
+ *  Lock a reader/writer lock for reading. Other readers may hold it too
+ *
+ * @param p_rwlock the lock
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_rwlock_read_lock ( set_rwlock *const p_rwlock );
+
+/** !
+ *  Unlock a reader/writer lock held for reading
+ *
+ * @param p_rwlock the lock
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_rwlock_read_unlock ( set_rwlock *const p_rwlock );
+
+/** !
+ *  Lock a reader/writer lock for writing, once every reader has left
+ *
+ * @param p_rwlock the lock
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_rwlock_write_lock ( set_rwlock *const p_rwlock );
+
+/** !
+ *  Unlock a reader/writer lock held for writing
+ *
+ * @param p_rwlock the lock
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_rwlock_write_unlock ( set_rwlock *const p_rwlock );
+
+// Destructors
+/** !
+ *  Destroy a reader/writer lock. The lock must not be held
+ *
+ * @param p_rwlock the lock
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_rwlock_destroy ( set_rwlock *const p_rwlock );
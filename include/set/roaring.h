@@ -0,0 +1,238 @@
+/** !
+ * @file set/roaring.h
+ *
+ * @author Jacob Smith
+ *
+ * Compressed bitmap of 32 bit integers, for sets of integer IDs.
+ *
+ * Integers are partitioned into chunks of 65536 by their high 16 bits.
+ * Each chunk stores its low 16 bits in the smallest of three containers;
+ * a sorted array for sparse chunks, a 65536 bit bitmap for dense chunks,
+ * or a sorted list of runs for chunks of consecutive integers.
+ *
+ * Elements are exchanged with the set library as ( void * ) casts of the
+ * integer, in ascending order.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct roaring_s;
+
+// Type definitions
+typedef struct roaring_s roaring;
+
+// Constructors
+/** !
+ *  Construct an empty roaring bitmap
+ *
+ * @param pp_roaring return
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_construct ( roaring **const pp_roaring );
+
+/** !
+ *  Construct the union of two roaring bitmaps
+ *
+ * @param pp_roaring return
+ * @param p_a        roaring bitmap A
+ * @param p_b        roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_union ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Construct the integers of roaring bitmap A that are not in roaring bitmap B
+ *
+ * @param pp_roaring return
+ * @param p_a        roaring bitmap A
+ * @param p_b        roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_difference ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Construct the intersection of two roaring bitmaps
+ *
+ * @param pp_roaring return
+ * @param p_a        roaring bitmap A
+ * @param p_b        roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_intersection ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Construct the integers that are in exactly one of two roaring bitmaps
+ *
+ * @param pp_roaring return
+ * @param p_a        roaring bitmap A
+ * @param p_b        roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_symmetric_difference ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b );
+
+// Accessors
+/** !
+ *  Test if a roaring bitmap contains an integer
+ *
+ * @param p_roaring the roaring bitmap
+ * @param value     the integer
+ *
+ * @return true IF the integer is in the roaring bitmap ELSE false
+ */
+DLLEXPORT bool roaring_contains ( const roaring *const p_roaring, uint32_t value );
+
+/** !
+ *  Test if two roaring bitmaps have no integers in common
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ *
+ * @return true IF the roaring bitmaps are disjoint ELSE false
+ */
+DLLEXPORT bool roaring_isdisjoint ( const roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Test if every integer of roaring bitmap A is in roaring bitmap B
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ *
+ * @return true IF roaring bitmap A is a subset of roaring bitmap B ELSE false
+ */
+DLLEXPORT bool roaring_issubset ( const roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Count the integers that two roaring bitmaps have in common, without
+ *  building their intersection
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ *
+ * @return the quantity of common integers
+ */
+DLLEXPORT size_t roaring_intersection_count ( const roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Get the quantity of integers in a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ *
+ * @return the quantity of integers
+ */
+DLLEXPORT size_t roaring_count ( const roaring *const p_roaring );
+
+/** !
+ *  Get the quantity of bytes used by a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ *
+ * @return the quantity of bytes
+ */
+DLLEXPORT size_t roaring_size ( const roaring *const p_roaring );
+
+/** !
+ *  Write the integers of a roaring bitmap, in ascending order, as ( void * ) casts
+ *
+ * @param p_roaring   the roaring bitmap
+ * @param pp_contents return. Must have room for roaring_count integers
+ *
+ * @return the quantity of integers written
+ */
+DLLEXPORT size_t roaring_contents ( const roaring *const p_roaring, void **const pp_contents );
+
+// Mutators
+/** !
+ *  Add an integer to a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ * @param value     the integer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_add ( roaring *const p_roaring, uint32_t value );
+
+/** !
+ *  Remove an integer from a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ * @param value     the integer
+ *
+ * @return 1 on success, 0 IF the integer is not in the roaring bitmap
+ */
+DLLEXPORT int roaring_remove ( roaring *const p_roaring, uint32_t value );
+
+/** !
+ *  Remove and return the greatest integer in a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ * @param p_value   return
+ *
+ * @return 1 on success, 0 IF the roaring bitmap is empty
+ */
+DLLEXPORT int roaring_pop ( roaring *const p_roaring, uint32_t *const p_value );
+
+/** !
+ *  Add the integers of roaring bitmap B to roaring bitmap A, in place
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_union_update ( roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Remove the integers of roaring bitmap B from roaring bitmap A, in place
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_difference_update ( roaring *const p_a, const roaring *const p_b );
+
+/** !
+ *  Remove the integers of roaring bitmap A that are not in roaring bitmap B, in place
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_intersection_update ( roaring *const p_a, const roaring *const p_b );
+
+// Iterators
+/** !
+ *  Call a function on each integer in a roaring bitmap, in ascending order
+ *
+ * @param p_roaring the roaring bitmap
+ * @param function  pointer to a function of type void (*)(void *value, size_t index)
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_foreach_i ( const roaring *const p_roaring, void (*const function)(void *const value, size_t index) );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a roaring bitmap
+ *
+ * @param pp_roaring pointer to roaring bitmap pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int roaring_destroy ( roaring **const pp_roaring );
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 // sync submodule
@@ -30,8 +31,19 @@
 #define SET_REALLOC(p, sz) realloc(p,sz)
 #endif
 
+#ifndef SET_CALLOC
+#define SET_CALLOC(n, sz) calloc(n,sz)
+#endif
+
+// Free an allocation. Null pointers are skipped, because realloc(NULL, 0) may allocate
+#ifndef SET_FREE
+#define SET_FREE(p) do { void *p_freed = (void *) (p); if ( p_freed ) p_freed = SET_REALLOC(p_freed, 0); (void)p_freed; } while (0)
+#endif
+
 // Forward declarations
 struct set_s;
+struct hll_s;
+struct minhash_s;
 
 // Type definitions
 /** !
@@ -44,6 +56,17 @@ typedef struct set_s set;
  */
 typedef int (set_equal_fn)(const void *a, const void *b);
 
+/** !
+ *  @brief The type definition for a function that orders two set members. Returns 
+ *         a negative value if a < b, zero if a == b, and a positive value if a > b
+ */
+typedef int (set_compare_fn)(const void *a, const void *b);
+
+/** !
+ *  @brief The type definition for a function that hashes a set member
+ */
+typedef unsigned long long (set_hash_fn)(const void *const p_element);
+
 // Initializer
 /** !
  * This gets called at runtime before main.
@@ -68,10 +91,10 @@ DLLEXPORT int set_create ( set **const pp_set );
 
 // Constructors
 /** !
- *  Construct a set with a specific number of elements
+ *  Construct an empty set
  *
  * @param pp_set       return
- * @param size         number of set elements. 
+ * @param size         initial capacity of the set. The set grows as elements are added
  * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
  * 
  * @sa set_create
@@ -85,7 +108,78 @@ DLLEXPORT int set_create ( set **const pp_set );
 DLLEXPORT int set_construct ( set **const pp_set, size_t size, set_equal_fn *pfn_is_equal );
 
 /** !
- *  Construct a set from an array of elements
+ *  Construct an empty hashed set. Elements are indexed by an open addressing
+ *  hash table, so add, remove and membership tests run in expected constant
+ *  time. When the table fills up, elements are rehashed into a bigger table
+ *  a few at a time by later calls to add and remove.
+ *
+ * @param pp_set       return
+ * @param size         initial capacity of the set. The set grows as elements are added
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param pfn_hash     function for hashing elements in set IF parameter is not null ELSE default
+ * 
+ * @sa set_create
+ * @sa set_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_construct_hashed ( set **const pp_set, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash );
+
+/** !
+ *  Construct an empty sorted set. Elements are kept in ascending order, so 
+ *  membership tests are a binary search, and the union, intersection, 
+ *  difference and symmetric difference of two sorted sets with the same 
+ *  comparator are computed in one linear merge
+ *
+ * @param pp_set      return
+ * @param size        initial capacity of the set. The set grows as elements are added
+ * @param pfn_compare function for ordering elements in set IF parameter is not null ELSE default
+ * 
+ * @sa set_create
+ * @sa set_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_construct_sorted ( set **const pp_set, size_t size, set_compare_fn *pfn_compare );
+
+/** !
+ *  Construct an empty roaring set of 32 bit integers, added as ( void * ) 
+ *  casts. Elements are stored in a roaring bitmap, which partitions the 
+ *  integers into chunks of 65536, and stores each chunk as a sorted array,
+ *  a bitmap, or a list of runs, whichever is smallest. Elements are 
+ *  iterated in ascending order, and set_pop returns the greatest element
+ *
+ * @param pp_set return
+ * 
+ * @sa set_create
+ * @sa set_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_construct_roaring ( set **const pp_set );
+
+/** !
+ *  Construct an empty bitset set of integers less than universe_size, 
+ *  added as ( void * ) casts. Each integer is one bit, so set_add is a 
+ *  bit or, and the union, intersection, difference and symmetric 
+ *  difference of two bitset sets are word by word or, and, and not, and
+ *  xor loops. Elements are iterated in ascending order, and set_pop 
+ *  returns the greatest element
+ *
+ * @param pp_set        return
+ * @param universe_size one more than the greatest integer the set can hold
+ * 
+ * @sa set_create
+ * @sa set_construct
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_construct_bitset ( set **const pp_set, size_t universe_size );
+
+/** !
+ *  Construct a set from an array of elements. Without an equality 
+ *  function, duplicates are found through a temporary index, on worker 
+ *  threads
  *
  * @param pp_set       return
  * @param pp_elements  pointer to array of elements
@@ -94,6 +188,8 @@ DLLEXPORT int set_construct ( set **const pp_set, size_t size, set_equal_fn *pfn
  *
  * @sa set_create
  * @sa set_construct
+ * @sa set_from_elements_hashed
+ * @sa set_from_elements_sorted
  * @sa set_union
  * @sa set_difference
  * @sa set_intersection
@@ -102,6 +198,44 @@ DLLEXPORT int set_construct ( set **const pp_set, size_t size, set_equal_fn *pfn
  */
 DLLEXPORT int set_from_elements ( set **const pp_set, const void **const pp_elements, size_t size, set_equal_fn *pfn_is_equal );
 
+/** !
+ *  Construct a hashed set from an array of elements, on worker threads. 
+ *  Workers claim index slots with compare and swap, and the elements are
+ *  stored in one pass, without locking. The first of each group of equal
+ *  elements is kept, in input order
+ *
+ * @param pp_set       return
+ * @param pp_elements  pointer to array of elements
+ * @param size         number of elements
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param pfn_hash     function for hashing elements IF parameter is not null ELSE hash the address of the element
+ * @param threads      the quantity of worker threads IF positive ELSE one per hardware thread
+ *
+ * @sa set_from_elements
+ * @sa set_construct_hashed
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_from_elements_hashed ( set **const pp_set, const void **const pp_elements, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash, size_t threads );
+
+/** !
+ *  Construct a sorted set from an array of elements, on worker threads.
+ *  Each worker sorts a slice, the slices are merged in pairs, and equal 
+ *  neighbors are dropped, without locking
+ *
+ * @param pp_set      return
+ * @param pp_elements pointer to array of elements
+ * @param size        number of elements
+ * @param pfn_compare function for ordering elements IF parameter is not null ELSE order by address
+ * @param threads     the quantity of worker threads IF positive ELSE one per hardware thread
+ *
+ * @sa set_from_elements
+ * @sa set_construct_sorted
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_from_elements_sorted ( set **const pp_set, const void **const pp_elements, size_t size, set_compare_fn *pfn_compare, size_t threads );
+
 /** !
  *  Construct a set from the union of set A and set B
  *
@@ -155,7 +289,300 @@ DLLEXPORT int set_difference ( set **const pp_set, const set *const p_a, const s
 */
 DLLEXPORT int set_intersection ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal );
 
+/** !
+ *  Construct a set from the symmetric difference of set A and set B
+ * 
+ * @param pp_set return
+ * @param p_a    set A
+ * @param p_b    set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ *
+ * @sa set_union
+ * @sa set_difference
+ * @sa set_intersection
+ * 
+ * @return 1 on success, 0 on error
+*/
+DLLEXPORT int set_symmetric_difference ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal );
+
+/** !
+ *  Construct a set from the union of many sets, in one output allocation.
+ *  Sorted sets are merged in one pass with a heap, and other sets are 
+ *  added to a result that already has room for every element
+ * 
+ * @param pp_set       return
+ * @param pp_sets      the sets
+ * @param count        the quantity of sets. Must be positive
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ *
+ * @sa set_union
+ * @sa set_intersection_n
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_union_n ( set **const pp_set, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal );
+
+/** !
+ *  Construct a set from the intersection of many sets, in one output 
+ *  allocation. The result starts as a copy of the smallest set, and is 
+ *  intersected in place with each larger set, stopping once it is empty
+ * 
+ * @param pp_set       return
+ * @param pp_sets      the sets
+ * @param count        the quantity of sets. Must be positive
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ *
+ * @sa set_intersection
+ * @sa set_union_n
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_intersection_n ( set **const pp_set, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal );
+
+/** !
+ *  Construct a set from the union of set A and set B, on worker 
+ *  threads. Sorted sets are split by key range, and other sets by 
+ *  position. Each thread writes a disjoint slice of the result
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param threads      the quantity of worker threads IF positive ELSE one per hardware thread
+ *
+ * @sa set_union
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_union_parallel ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads );
+
+/** !
+ *  Construct a set from the difference of set A and set B, on worker 
+ *  threads. Sorted sets are split by key range, and other sets by 
+ *  position. Each thread writes a disjoint slice of the result
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param threads      the quantity of worker threads IF positive ELSE one per hardware thread
+ *
+ * @sa set_difference
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_difference_parallel ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads );
+
+/** !
+ *  Construct a set from the intersection of set A and set B, on worker 
+ *  threads. Sorted sets are split by key range, and other sets by 
+ *  position. Each thread writes a disjoint slice of the result
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param threads      the quantity of worker threads IF positive ELSE one per hardware thread
+ *
+ * @sa set_intersection
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_intersection_parallel ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads );
+
 // Accessors
+/** !
+ *  Test if set A and set B have no elements in common. Sorted sets of very 
+ *  different sizes are tested by galloping through the larger set. Stops 
+ *  at the first common element
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return true IF set A and set B are disjoint ELSE false
+ */
+DLLEXPORT bool set_isdisjoint ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Test if every element of set A is in set B. Stops at the first element 
+ *  that is missing, and without looking at either set IF set A is larger 
+ *  than set B
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_issuperset
+ * 
+ * @return true IF set A is a subset of set B ELSE false
+ */
+DLLEXPORT bool set_issubset ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Test if every element of set B is in set A
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_issubset
+ * 
+ * @return true IF set A is a superset of set B ELSE false
+ */
+DLLEXPORT bool set_issuperset ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Count the elements of set A that are also in set B, without constructing
+ *  the intersection. Sorted sets are merged, or galloped, in one pass, and
+ *  compact sets are counted in their own representation
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_intersection
+ * 
+ * @return | A ∩ B |
+ */
+DLLEXPORT size_t set_intersection_count ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Count the elements of set A or set B, without constructing the union
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_union
+ * 
+ * @return | A ∪ B |
+ */
+DLLEXPORT size_t set_union_count ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Count the elements of set A that are not in set B, without constructing
+ *  the difference
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_difference
+ * 
+ * @return | A - B |
+ */
+DLLEXPORT size_t set_difference_count ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Compute the Jaccard similarity, | A ∩ B | / | A ∪ B |, of set A and set B
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_jaccard_estimate
+ * 
+ * @return the similarity, from 0 to 1, or 0 IF both sets are empty, -1 on error
+ */
+DLLEXPORT double set_jaccard ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Compute the overlap coefficient, | A ∩ B | / min( | A |, | B | ), of 
+ *  set A and set B
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return the coefficient, from 0 to 1, or 0 IF either set is empty, -1 on error
+ */
+DLLEXPORT double set_overlap_coefficient ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Test if an element is in a set. IF the set has a Bloom filter, most 
+ *  elements that are not in the set are rejected without searching it.
+ *  Readers share the lock, so tests on many threads run in parallel
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * 
+ * @sa set_enable_bloom
+ * 
+ * @return true IF the element is in the set ELSE false
+ */
+DLLEXPORT bool set_contains ( const set *const p_set, const void *const p_element );
+
+/** !
+ *  Test if each of a batch of elements is in a set. The set is locked 
+ *  once for reading, every key is hashed up front, and the index slots of later keys
+ *  are prefetched while earlier keys are compared
+ * 
+ * @param p_set       the set
+ * @param pp_elements the elements
+ * @param count       the quantity of elements
+ * @param p_results   return true for each element IF it is in the set ELSE false. May be null
+ * 
+ * @sa set_contains
+ * @sa set_add_many
+ * 
+ * @return the quantity of elements that are in the set
+ */
+DLLEXPORT size_t set_contains_many ( const set *const p_set, const void *const *const pp_elements, size_t count, bool *const p_results );
+
+/** !
+ *  Get the cardinality sketch of a set, for merging with hll_merge
+ * 
+ * @param p_set the set
+ * 
+ * @sa set_enable_sketch
+ * 
+ * @return the sketch IF the set has one ELSE null
+ */
+DLLEXPORT const struct hll_s *set_sketch ( const set *const p_set );
+
+/** !
+ *  Estimate the size of the union of set A and set B from their sketches,
+ *  without constructing the union
+ * 
+ * @param p_a set A
+ * @param p_b set B. Must have a sketch of the same precision as set A
+ * 
+ * @sa set_enable_sketch
+ * 
+ * @return the estimate on success, -1 on error
+ */
+DLLEXPORT double set_union_estimate ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Estimate the size of the intersection of set A and set B from their 
+ *  sketches, without constructing the intersection
+ * 
+ * @param p_a set A
+ * @param p_b set B. Must have a sketch of the same precision as set A
+ * 
+ * @sa set_enable_sketch
+ * 
+ * @return the estimate on success, -1 on error
+ */
+DLLEXPORT double set_intersection_estimate ( const set *const p_a, const set *const p_b );
+
+/** !
+ *  Get the MinHash signature of a set
+ * 
+ * @param p_set the set
+ * 
+ * @sa set_enable_minhash
+ * 
+ * @return the signature IF the set has one ELSE null
+ */
+DLLEXPORT const struct minhash_s *set_minhash ( const set *const p_set );
+
+/** !
+ *  Estimate the Jaccard similarity, | A ∩ B | / | A ∪ B |, of set A and 
+ *  set B from their signatures, in O(k)
+ * 
+ * @param p_a set A
+ * @param p_b set B. Must have a signature with as many slots as set A
+ * 
+ * @sa set_enable_minhash
+ * 
+ * @return the estimate, from 0 to 1, on success, -1 on error
+ */
+DLLEXPORT double set_jaccard_estimate ( const set *const p_a, const set *const p_b );
+
 /** !
  *  Return the quantity of elements in the set
  * 
@@ -193,6 +620,23 @@ DLLEXPORT int set_contents ( const set *const p_set, void **const pp_contents );
  */
 DLLEXPORT int set_add ( set *const p_set, void *const p_element );
 
+/** !
+ *  Add a batch of elements to a set. The set is locked once, and grows 
+ *  once. Hashed sets hash every key up front, and prefetch the index 
+ *  slots of later keys while earlier keys are added. Sorted sets merge a
+ *  sorted copy of the batch
+ *
+ * @param p_set       the set
+ * @param pp_elements the elements
+ * @param count       the quantity of elements
+ *
+ * @sa set_add
+ * @sa set_contains_many
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_add_many ( set *const p_set, void *const *const pp_elements, size_t count );
+
 // Remove and return an element from a set
 DLLEXPORT int set_pop ( set *const p_set, void **const pp_value );
 
@@ -200,7 +644,120 @@ DLLEXPORT int set_pop ( set *const p_set, void **const pp_value );
 DLLEXPORT int set_remove ( set *const p_set, void *const p_element );
 
 /** !
- * Call function on every element in p_set
+ *  Add every element of set B to set A, in place. Set A keeps its storage,
+ *  and grows at most once. Sorted sets are merged from the back, and 
+ *  hashed sets size their index for both sets before adding
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_union
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_update ( set *const p_a, const set *const p_b );
+
+/** !
+ *  Remove every element of set B from set A, in place. Set A keeps its 
+ *  storage, and never grows
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_difference
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_difference_update ( set *const p_a, const set *const p_b );
+
+/** !
+ *  Remove every element of set A that is not in set B, in place. Set A 
+ *  keeps its storage, and never grows
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @sa set_intersection
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_intersection_update ( set *const p_a, const set *const p_b );
+
+/** !
+ *  Give a set a blocked Bloom filter, which set_contains tests before it
+ *  searches the set. The filter is kept in sync by set_add, set_pop, and 
+ *  set_remove, and grows with the set. Sets with a custom equality 
+ *  function must be hashed, so equal elements hash alike
+ *
+ * @param p_set the set. Must not be a roaring, bitset, or frozen set
+ *
+ * @sa set_contains
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_enable_bloom ( set *const p_set );
+
+/** !
+ *  Give a set a HyperLogLog cardinality sketch, which set_add keeps up 
+ *  to date. Removed elements stay in the sketch until it is enabled 
+ *  again. Sets with a custom equality function must be hashed, so equal
+ *  elements hash alike
+ *
+ * @param p_set     the set
+ * @param precision the precision of the sketch. 12 uses 4 KiB, with a 1.6% standard error
+ *
+ * @sa set_union_estimate
+ * @sa set_intersection_estimate
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_enable_sketch ( set *const p_set, int precision );
+
+/** !
+ *  Give a set a MinHash signature of k slots, which set_add keeps up to
+ *  date. Removed elements stay in the signature until it is enabled 
+ *  again. Sets with a custom equality function must be hashed, so equal
+ *  elements hash alike
+ *
+ * @param p_set the set
+ * @param k     the quantity of slots. The standard error is about 1 / sqrt(k)
+ *
+ * @sa set_jaccard_estimate
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_enable_minhash ( set *const p_set, size_t k );
+
+/** !
+ *  Compress a set of integers, added as ( void * ) casts, into a frozen 
+ *  set. Elements are sorted and stored as varint encoded differences, 
+ *  with a skip table every 128 elements, so cold sets of IDs use one or
+ *  two bytes per element. Frozen sets are immutable; set_add, set_pop,
+ *  and set_remove fail until the set is thawed. Membership, iteration, 
+ *  and the intersection of two frozen sets run on the compressed form
+ *
+ * @param p_set the set. Must use the default equality and comparison functions
+ *
+ * @sa set_thaw
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_freeze ( set *const p_set );
+
+/** !
+ *  Decompress a frozen set back into a mutable set of the same kind
+ *
+ * @param p_set the frozen set
+ *
+ * @sa set_freeze
+ * 
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int set_thaw ( set *const p_set );
+
+/** !
+ * Call function on every element in p_set. The set is locked for reading
+ * while the function runs, so the function must not call into the same set
  *
  * @param p_set set
  * @param function pointer to function of type void (*)(void *value, size_t index)
@@ -231,15 +788,6 @@ DLLEXPORT int set_destroy ( set **const pp_set );
  */
 DLLEXPORT void set_exit ( void ) __attribute__((destructor));
 
-// TODO: Test if set A and set B are disjoint
-// DLLEXPORT bool set_isdisjoint ( const set *const p_a, const set *const p_b );
-
-// TODO: Test if set A is a subset of set B
-// DLLEXPORT bool set_issubset ( const set *const p_a, const set *const p_b );
-
-// TODO: Test if set A is a superset of set B
-// DLLEXPORT bool set_issuperset ( const set *const p_a, const set *const p_b );
-
 // TODO: Remove all elements from a set
 // DLLEXPORT int set_clear ( set *const p_set );
 
@@ -251,12 +799,3 @@ DLLEXPORT void set_exit ( void ) __attribute__((destructor));
 
 // TODO: Remove an element form an existing set
 // DLLEXPORT void set_discard ( set *const p_set, void *p_element );
-
-// TODO: Update an existing set with the difference of itself and another set 
-// DLLEXPORT int set_difference_update ( set *const p_a, const set *const p_b );
-
-// TODO: Update an existing set with the intersection of itself and another set 
-// DLLEXPORT int set_intersection_update ( set *const p_a, const set *const p_b );
-
-// TODO: Update an existing set with the union of itself and another set 
-// DLLEXPORT int set_update ( set *const p_a, const set *const p_b );
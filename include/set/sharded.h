@@ -0,0 +1,109 @@
+/** !
+ * @file set/sharded.h
+ *
+ * @author Jacob Smith
+ *
+ * Lock striped set, for many concurrent writers.
+ *
+ * Elements are split by hash across a power of two quantity of shards.
+ * Each shard is a hashed set with its own lock, so writers to different
+ * shards never wait for each other. Each shard counts its own elements,
+ * and the count of the sharded set is their sum, taken on demand. The
+ * sum is exact when no writer is running, and otherwise is somewhere
+ * between the counts before and after the concurrent writes.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct sharded_s;
+
+// Type definitions
+typedef struct sharded_s sharded;
+
+// Constructors
+/** !
+ *  Construct an empty sharded set
+ *
+ * @param pp_sharded   return
+ * @param shards       the quantity of shards, rounded up to a power of two, IF positive ELSE four per hardware thread
+ * @param size         the expected quantity of elements, across every shard
+ * @param pfn_is_equal function for testing equality of elements IF parameter is not null ELSE default
+ * @param pfn_hash     function for hashing elements IF parameter is not null ELSE default
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_construct ( sharded **const pp_sharded, size_t shards, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash );
+
+// Accessors
+/** !
+ *  Test if an element is in a sharded set. Only the shard of the element 
+ *  is locked, and only for reading
+ *
+ * @param p_sharded the sharded set
+ * @param p_element the element
+ *
+ * @return true IF the element is in the sharded set ELSE false
+ */
+DLLEXPORT bool sharded_contains ( const sharded *const p_sharded, const void *const p_element );
+
+/** !
+ *  Get the quantity of elements in a sharded set, by summing the count of
+ *  each shard
+ *
+ * @param p_sharded the sharded set
+ *
+ * @return the quantity of elements
+ */
+DLLEXPORT size_t sharded_count ( const sharded *const p_sharded );
+
+/** !
+ *  Get the quantity of shards in a sharded set
+ *
+ * @param p_sharded the sharded set
+ *
+ * @return the quantity of shards
+ */
+DLLEXPORT size_t sharded_shards ( const sharded *const p_sharded );
+
+// Mutators
+/** !
+ *  Add an element to a sharded set, unless it is already there. Only the
+ *  shard of the element is locked
+ *
+ * @param p_sharded the sharded set
+ * @param p_element the element
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_add ( sharded *const p_sharded, void *const p_element );
+
+/** !
+ *  Remove an element from a sharded set. Only the shard of the element is
+ *  locked
+ *
+ * @param p_sharded the sharded set
+ * @param p_element the element
+ *
+ * @return 1 IF the element was removed ELSE 0
+ */
+DLLEXPORT int sharded_remove ( sharded *const p_sharded, void *const p_element );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a sharded set. No other thread may be using it
+ *
+ * @param pp_sharded pointer to sharded set pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int sharded_destroy ( sharded **const pp_sharded );
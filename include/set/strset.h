@@ -0,0 +1,120 @@
+/** !
+ * @file set/strset.h
+ *
+ * @author Jacob Smith
+ *
+ * Hashed set of null terminated strings.
+ *
+ * Keys are copied into an arena of large chunks, so the set owns its
+ * keys, and neighboring keys share cache lines. Each slot of the index
+ * holds the 64 bit hash and the length of its key, next to the pointer.
+ * A lookup only calls memcmp when both the hash and the length match.
+ *
+ * The arena only grows. A removed string keeps its bytes until the string
+ * set is destroyed, so pointers from strset_contents stay valid. String
+ * sets that remove many strings should be rebuilt from their contents.
+ *
+ * Lookups share a reader/writer lock, so they run concurrently. Adds and
+ * removes take it exclusively.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// set
+#include <set/set.h>
+
+// Forward declarations
+struct strset_s;
+
+// Type definitions
+typedef struct strset_s strset;
+
+// Constructors
+/** !
+ *  Construct an empty string set
+ *
+ * @param pp_strset return
+ * @param size      the expected quantity of strings
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int strset_construct ( strset **const pp_strset, size_t size );
+
+// Accessors
+/** !
+ *  Test if a string set contains a string
+ *
+ * @param p_strset the string set
+ * @param p_key    the string
+ *
+ * @return true IF the string is in the string set ELSE false
+ */
+DLLEXPORT bool strset_contains ( strset *const p_strset, const char *const p_key );
+
+/** !
+ *  Get the quantity of strings in a string set
+ *
+ * @param p_strset the string set
+ *
+ * @return the quantity of strings
+ */
+DLLEXPORT size_t strset_count ( const strset *const p_strset );
+
+/** !
+ *  Get the strings of a string set. The strings belong to the string set
+ *
+ * @param p_strset    the string set
+ * @param pp_contents return. Must have room for strset_count strings
+ *
+ * @return the quantity of strings written
+ */
+DLLEXPORT size_t strset_contents ( strset *const p_strset, const char **const pp_contents );
+
+// Mutators
+/** !
+ *  Copy a string into a string set, unless it is already there
+ *
+ * @param p_strset the string set
+ * @param p_key    the string
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int strset_add ( strset *const p_strset, const char *const p_key );
+
+/** !
+ *  Remove a string from a string set. The copy stays in the arena until
+ *  the string set is destroyed
+ *
+ * @param p_strset the string set
+ * @param p_key    the string
+ *
+ * @return 1 on success, 0 IF the string is not in the string set
+ */
+DLLEXPORT int strset_remove ( strset *const p_strset, const char *const p_key );
+
+// Iterators
+/** !
+ *  Call a function on each string in a string set
+ *
+ * @param p_strset the string set
+ * @param function pointer to a function of type void (*)(void *value, size_t index)
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int strset_foreach_i ( strset *const p_strset, void (*const function)(void *const value, size_t index) );
+
+// Destructors
+/** !
+ *  Destroy and deallocate a string set, and every string in it
+ *
+ * @param pp_strset pointer to string set pointer
+ *
+ * @return 1 on success, 0 on error
+ */
+DLLEXPORT int strset_destroy ( strset **const pp_strset );
@@ -0,0 +1,278 @@
+/** !
+ * @file set/typed.h
+ *
+ * @author Jacob Smith
+ *
+ * Generator for type specialized hashed sets.
+ *
+ * SET_DECLARE(name, T, hash, eq) emits a set type called name, and
+ * static inline functions name_construct, name_add, name_contains,
+ * name_remove, name_count, name_contents, name_foreach_i, and
+ * name_destroy. Keys of type T are stored by value, and hash and eq
+ * are expanded in place, so the compiler can inline them.
+ *
+ *     hash(key) -> unsigned long long. The result is mixed, so the
+ *                  key itself is a fine hash for integers
+ *     eq(a, b)  -> 0 IF a and b are equal, like set_equal_fn
+ *
+ * SET_HASH_SCALAR and SET_EQUALS_SCALAR work for integers, pointers,
+ * and enums. For example
+ *
+ *     SET_DECLARE(u64set, uint64_t, SET_HASH_SCALAR, SET_EQUALS_SCALAR)
+ *
+ * declares u64set_add ( u64set *const p_set, uint64_t key ), and so on.
+ *
+ * Typed sets do not lock. Callers that share a typed set between
+ * threads must synchronize access themselves.
+ */
+
+// Include guard
+#pragma once
+
+// Standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// set
+#include <set/set.h>
+
+// Preprocessor definitions
+// Slot states
+#define SET_TYPED_EMPTY     0
+#define SET_TYPED_FULL      1
+#define SET_TYPED_TOMBSTONE 2
+
+// Hash and equality for scalar keys
+#define SET_HASH_SCALAR(key)    ( (unsigned long long) (key) )
+#define SET_EQUALS_SCALAR(a, b) ( (a) != (b) )
+
+/** !
+ * Scramble the bits of a hash, so weak hash functions still spread
+ * evenly across the slots
+ *
+ * @param hash the hash
+ *
+ * @return the mixed hash
+ */
+static inline unsigned long long set_typed_mix ( unsigned long long hash )
+{
+
+    // Fibonacci hashing. The high bits are the best mixed
+    hash *= 0x9E3779B97F4A7C15ULL;
+
+    // Done
+    return hash ^ ( hash >> 32 );
+}
+
+/** !
+ * Declare a type specialized hashed set
+ *
+ * @param name the name of the set type, and the prefix of its functions
+ * @param T    the key type
+ * @param hash function or macro of type unsigned long long (*)(T key)
+ * @param eq   function or macro of type int (*)(T a, T b). Returns 0 IF equal
+ */
+#define SET_DECLARE(name, T, hash, eq)                                                                  \
+                                                                                                        \
+/* The keys and the slot states share one allocation */                                                 \
+typedef struct name##_s                                                                                 \
+{                                                                                                       \
+    T       *p_keys;                                                                                    \
+    uint8_t *p_states;                                                                                  \
+    size_t   count,                                                                                     \
+             used,                                                                                      \
+             max;                                                                                       \
+} name;                                                                                                 \
+                                                                                                        \
+/* Find a key. Returns true IF found, and the slot of the key IF found ELSE the slot to insert at */   \
+static inline bool name##_find ( const name *const p_set, T key, size_t *const p_slot )                 \
+{                                                                                                       \
+    size_t mask      = p_set->max - 1,                                                                  \
+           i         = (size_t) set_typed_mix(hash(key)) & mask,                                        \
+           tombstone = SIZE_MAX;                                                                        \
+                                                                                                        \
+    /* Probe until an empty slot */                                                                     \
+    for (;; i = ( i + 1 ) & mask)                                                                       \
+    {                                                                                                   \
+        if ( p_set->p_states[i] == SET_TYPED_EMPTY )                                                    \
+        {                                                                                               \
+            *p_slot = ( tombstone == SIZE_MAX ) ? i : tombstone;                                        \
+            return false;                                                                               \
+        }                                                                                               \
+        if ( p_set->p_states[i] == SET_TYPED_TOMBSTONE ) { if ( tombstone == SIZE_MAX ) tombstone = i; }\
+        else if ( eq(p_set->p_keys[i], key) == 0 ) { *p_slot = i; return true; }                      \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+/* Move every key into a new allocation of max slots. Returns 1 on success, 0 on error */              \
+static inline int name##_resize ( name *const p_set, size_t max )                                       \
+{                                                                                                       \
+    name  old     = *p_set;                                                                             \
+    void *p_block = SET_CALLOC(max, sizeof(T) + 1);                                                     \
+                                                                                                        \
+    /* Error check */                                                                                   \
+    if ( p_block == (void *) 0 ) return 0;                                                              \
+                                                                                                        \
+    /* Store the new slots */                                                                           \
+    p_set->p_keys   = (T *) p_block,                                                                    \
+    p_set->p_states = (uint8_t *) p_block + max * sizeof(T),                                            \
+    p_set->used     = p_set->count,                                                                     \
+    p_set->max      = max;                                                                              \
+                                                                                                        \
+    /* Reinsert each key, dropping tombstones */                                                        \
+    for (size_t i = 0; i < old.max; i++)                                                                \
+    {                                                                                                   \
+        size_t slot = 0;                                                                                \
+        if ( old.p_states[i] != SET_TYPED_FULL ) continue;                                              \
+        (void)name##_find(p_set, old.p_keys[i], &slot);                                                 \
+        p_set->p_keys[slot] = old.p_keys[i], p_set->p_states[slot] = SET_TYPED_FULL;                    \
+    }                                                                                                   \
+                                                                                                        \
+    /* Free the old slots */                                                                            \
+    SET_FREE(old.p_keys);                                                                               \
+                                                                                                        \
+    /* Success */                                                                                       \
+    return 1;                                                                                           \
+}                                                                                                       \
+                                                                                                        \
+/* Construct a typed set with room for size keys. Returns 1 on success, 0 on error */                  \
+static inline int name##_construct ( name **const pp_set, size_t size )                                 \
+{                                                                                                       \
+    name   *p_set = (void *) 0;                                                                         \
+    size_t  max   = 8;                                                                                  \
+                                                                                                        \
+    /* Argument check */                                                                                \
+    if ( pp_set == (void *) 0 ) return 0;                                                               \
+                                                                                                        \
+    /* Keep the load factor at most one half */                                                         \
+    while ( max < size * 2 ) max <<= 1;                                                                 \
+                                                                                                        \
+    /* Allocate the set */                                                                              \
+    p_set = SET_REALLOC(0, sizeof(name));                                                               \
+    if ( p_set == (void *) 0 ) return 0;                                                                \
+    *p_set = (name) { 0 };                                                                              \
+                                                                                                        \
+    /* Allocate the slots */                                                                            \
+    if ( name##_resize(p_set, max) == 0 ) { SET_FREE(p_set); return 0; }                                \
+                                                                                                        \
+    /* Return a pointer to the caller */                                                                \
+    *pp_set = p_set;                                                                                    \
+                                                                                                        \
+    /* Success */                                                                                       \
+    return 1;                                                                                           \
+}                                                                                                       \
+                                                                                                        \
+/* Add a key. Returns 1 on success, 0 on error */                                                       \
+static inline int name##_add ( name *const p_set, T key )                                               \
+{                                                                                                       \
+    size_t slot = 0;                                                                                    \
+                                                                                                        \
+    /* Argument check */                                                                                \
+    if ( p_set == (void *) 0 ) return 0;                                                                \
+                                                                                                        \
+    /* If the key is a duplicate, there is nothing to do */                                             \
+    if ( name##_find(p_set, key, &slot) ) return 1;                                                     \
+                                                                                                        \
+    /* Grow at three quarters load, counting tombstones */                                              \
+    if ( p_set->p_states[slot] == SET_TYPED_EMPTY && p_set->used + 1 > p_set->max / 4 * 3 )             \
+    {                                                                                                   \
+        if ( name##_resize(p_set, ( p_set->count + 1 > p_set->max / 4 ) ? p_set->max * 2 : p_set->max ) == 0 ) return 0; \
+        (void)name##_find(p_set, key, &slot);                                                           \
+    }                                                                                                   \
+                                                                                                        \
+    /* Account for the slot, unless it is a recycled tombstone */                                       \
+    p_set->used += p_set->p_states[slot] == SET_TYPED_EMPTY;                                            \
+                                                                                                        \
+    /* Store the key */                                                                                 \
+    p_set->p_keys[slot]   = key,                                                                        \
+    p_set->p_states[slot] = SET_TYPED_FULL;                                                             \
+    p_set->count++;                                                                                     \
+                                                                                                        \
+    /* Success */                                                                                       \
+    return 1;                                                                                           \
+}                                                                                                       \
+                                                                                                        \
+/* Test if a key is in the set */                                                                       \
+static inline bool name##_contains ( const name *const p_set, T key )                                   \
+{                                                                                                       \
+    size_t slot = 0;                                                                                    \
+                                                                                                        \
+    /* Done */                                                                                          \
+    return p_set && name##_find(p_set, key, &slot);                                                     \
+}                                                                                                       \
+                                                                                                        \
+/* Remove a key. Returns 1 on success, 0 IF the key is not in the set */                               \
+static inline int name##_remove ( name *const p_set, T key )                                            \
+{                                                                                                       \
+    size_t slot = 0;                                                                                    \
+                                                                                                        \
+    /* Error check */                                                                                   \
+    if ( p_set == (void *) 0 || name##_find(p_set, key, &slot) == false ) return 0;                     \
+                                                                                                        \
+    /* Tombstone the slot */                                                                            \
+    p_set->p_states[slot] = SET_TYPED_TOMBSTONE;                                                        \
+    p_set->count--;                                                                                     \
+                                                                                                        \
+    /* Success */                                                                                       \
+    return 1;                                                                                           \
+}                                                                                                       \
+                                                                                                        \
+/* Get the quantity of keys in the set */                                                               \
+static inline size_t name##_count ( const name *const p_set )                                           \
+{                                                                                                       \
+    return ( p_set ) ? p_set->count : 0;                                                                \
+}                                                                                                       \
+                                                                                                        \
+/* Copy the keys into p_contents, which must have room for name_count keys. Returns the quantity */    \
+static inline size_t name##_contents ( const name *const p_set, T *const p_contents )                   \
+{                                                                                                       \
+    size_t k = 0;                                                                                       \
+                                                                                                        \
+    /* Argument check */                                                                                \
+    if ( p_set == (void *) 0 || p_contents == (void *) 0 ) return 0;                                    \
+                                                                                                        \
+    /* Copy each key */                                                                                 \
+    for (size_t i = 0; i < p_set->max; i++)                                                             \
+        if ( p_set->p_states[i] == SET_TYPED_FULL ) p_contents[k++] = p_set->p_keys[i];                 \
+                                                                                                        \
+    /* Done */                                                                                          \
+    return k;                                                                                           \
+}                                                                                                       \
+                                                                                                        \
+/* Call function on each key. Returns 1 on success, 0 on error */                                       \
+static inline int name##_foreach_i ( const name *const p_set, void (*const function)(T key, size_t index) ) \
+{                                                                                                       \
+    size_t k = 0;                                                                                       \
+                                                                                                        \
+    /* Argument check */                                                                                \
+    if ( p_set == (void *) 0 || function == (void *) 0 ) return 0;                                      \
+                                                                                                        \
+    /* Call the function on each key */                                                                 \
+    for (size_t i = 0; i < p_set->max; i++)                                                             \
+        if ( p_set->p_states[i] == SET_TYPED_FULL ) function(p_set->p_keys[i], k++);                    \
+                                                                                                        \
+    /* Success */                                                                                       \
+    return 1;                                                                                           \
+}                                                                                                       \
+                                                                                                        \
+/* Destroy and deallocate a typed set. Returns 1 on success, 0 on error */                              \
+static inline int name##_destroy ( name **const pp_set )                                                \
+{                                                                                                       \
+    /* Argument check */                                                                                \
+    if ( pp_set == (void *) 0 ) return 0;                                                               \
+                                                                                                        \
+    /* Nothing to do */                                                                                 \
+    if ( *pp_set == (void *) 0 ) return 1;                                                              \
+                                                                                                        \
+    /* Free the slots, and the set */                                                                   \
+    SET_FREE((*pp_set)->p_keys);                                                                        \
+    SET_FREE(*pp_set);                                                                                  \
+                                                                                                        \
+    /* No more set for caller */                                                                        \
+    *pp_set = (void *) 0;                                                                               \
+                                                                                                        \
+    /* Success */                                                                                       \
+    return 1;                                                                                           \
+}
@@ -0,0 +1,767 @@
+/** !
+ * Set operation kernels for sorted arrays of unsigned integers
+ *
+ * @file kernel.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/kernel.h>
+
+// Vector kernels are only built for x86 compilers that support per function targets
+#if ( defined(__x86_64__) || defined(__i386__) ) && ( defined(__GNUC__) || defined(__clang__) )
+    #define SET_KERNEL_X86
+    #include <immintrin.h>
+#endif
+
+// Type definitions
+typedef size_t (set_kernel_u32_fn)(const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result);
+typedef size_t (set_kernel_u64_fn)(const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result);
+
+// Forward declarations
+static size_t intersection_u32_scalar ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result );
+static size_t union_u32_scalar        ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result );
+static size_t difference_u32_scalar   ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result );
+static size_t intersection_u64_scalar ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result );
+static size_t union_u64_scalar        ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result );
+static size_t difference_u64_scalar   ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result );
+
+// Data. Kernels default to the scalar implementations until set_kernel_init runs
+static set_kernel_u32_fn *pfn_intersection_u32 = &intersection_u32_scalar,
+                         *pfn_union_u32        = &union_u32_scalar,
+                         *pfn_difference_u32   = &difference_u32_scalar;
+static set_kernel_u64_fn *pfn_intersection_u64 = &intersection_u64_scalar,
+                         *pfn_union_u64        = &union_u64_scalar,
+                         *pfn_difference_u64   = &difference_u64_scalar;
+
+// Scalar kernels
+static size_t intersection_u32_scalar ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Initialized data
+    size_t i = 0,
+           j = 0,
+           k = 0;
+
+    // Merge without branching on the comparison
+    while ( i < a_count && j < b_count )
+    {
+
+        // Initialized data
+        uint32_t a = p_a[i],
+                 b = p_b[j];
+
+        // Speculatively store the key, and keep it IF it is a match
+        if ( p_result ) p_result[k] = a;
+        k += ( a == b );
+
+        // Advance the lesser key, or both
+        i += ( a <= b );
+        j += ( b <= a );
+    }
+
+    // Done
+    return k;
+}
+
+static size_t union_u32_scalar ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Initialized data
+    size_t i = 0,
+           j = 0,
+           k = 0;
+
+    // Merge
+    while ( i < a_count && j < b_count )
+    {
+
+        // Initialized data
+        uint32_t a = p_a[i],
+                 b = p_b[j];
+
+        // Store the lesser key
+        p_result[k++] = ( a <= b ) ? a : b;
+
+        // Advance the lesser key, or both
+        i += ( a <= b );
+        j += ( b <= a );
+    }
+
+    // Copy the rest
+    while ( i < a_count ) p_result[k++] = p_a[i++];
+    while ( j < b_count ) p_result[k++] = p_b[j++];
+
+    // Done
+    return k;
+}
+
+static size_t difference_u32_scalar ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Initialized data
+    size_t i = 0,
+           j = 0,
+           k = 0;
+
+    // Merge
+    while ( i < a_count && j < b_count )
+    {
+
+        // Initialized data
+        uint32_t a = p_a[i],
+                 b = p_b[j];
+
+        // Speculatively store the key, and keep it IF it is only in A
+        p_result[k] = a;
+        k += ( a < b );
+
+        // Advance the lesser key, or both
+        i += ( a <= b );
+        j += ( b <= a );
+    }
+
+    // Copy the rest of A
+    while ( i < a_count ) p_result[k++] = p_a[i++];
+
+    // Done
+    return k;
+}
+
+static size_t intersection_u64_scalar ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Initialized data
+    size_t i = 0,
+           j = 0,
+           k = 0;
+
+    // Merge without branching on the comparison
+    while ( i < a_count && j < b_count )
+    {
+
+        // Initialized data
+        uint64_t a = p_a[i],
+                 b = p_b[j];
+
+        // Speculatively store the key, and keep it IF it is a match
+        if ( p_result ) p_result[k] = a;
+        k += ( a == b );
+
+        // Advance the lesser key, or both
+        i += ( a <= b );
+        j += ( b <= a );
+    }
+
+    // Done
+    return k;
+}
+
+static size_t union_u64_scalar ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Initialized data
+    size_t i = 0,
+           j = 0,
+           k = 0;
+
+    // Merge
+    while ( i < a_count && j < b_count )
+    {
+
+        // Initialized data
+        uint64_t a = p_a[i],
+                 b = p_b[j];
+
+        // Store the lesser key
+        p_result[k++] = ( a <= b ) ? a : b;
+
+        // Advance the lesser key, or both
+        i += ( a <= b );
+        j += ( b <= a );
+    }
+
+    // Copy the rest
+    while ( i < a_count ) p_result[k++] = p_a[i++];
+    while ( j < b_count ) p_result[k++] = p_b[j++];
+
+    // Done
+    return k;
+}
+
+static size_t difference_u64_scalar ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Initialized data
+    size_t i = 0,
+           j = 0,
+           k = 0;
+
+    // Merge
+    while ( i < a_count && j < b_count )
+    {
+
+        // Initialized data
+        uint64_t a = p_a[i],
+                 b = p_b[j];
+
+        // Speculatively store the key, and keep it IF it is only in A
+        p_result[k] = a;
+        k += ( a < b );
+
+        // Advance the lesser key, or both
+        i += ( a <= b );
+        j += ( b <= a );
+    }
+
+    // Copy the rest of A
+    while ( i < a_count ) p_result[k++] = p_a[i++];
+
+    // Done
+    return k;
+}
+
+#ifdef SET_KERNEL_X86
+
+// Data
+// Byte shuffles that pack the selected 32 bit lanes of a 128 bit vector to the front
+static const uint8_t compact_u32_sse42[16][16] __attribute__((aligned(16))) =
+{
+    { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x80, 0x80, 0x80, 0x80 },
+    { 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80 },
+    { 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80 },
+    { 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80 },
+    { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+};
+
+// Dword permutations that pack the selected 64 bit lanes of a 256 bit vector to the front
+static const uint32_t compact_u64_avx2[16][8] __attribute__((aligned(32))) =
+{
+    { 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 0, 1, 0, 0, 0, 0, 0, 0 },
+    { 2, 3, 0, 0, 0, 0, 0, 0 },
+    { 0, 1, 2, 3, 0, 0, 0, 0 },
+    { 4, 5, 0, 0, 0, 0, 0, 0 },
+    { 0, 1, 4, 5, 0, 0, 0, 0 },
+    { 2, 3, 4, 5, 0, 0, 0, 0 },
+    { 0, 1, 2, 3, 4, 5, 0, 0 },
+    { 6, 7, 0, 0, 0, 0, 0, 0 },
+    { 0, 1, 6, 7, 0, 0, 0, 0 },
+    { 2, 3, 6, 7, 0, 0, 0, 0 },
+    { 0, 1, 2, 3, 6, 7, 0, 0 },
+    { 4, 5, 6, 7, 0, 0, 0, 0 },
+    { 0, 1, 4, 5, 6, 7, 0, 0 },
+    { 2, 3, 4, 5, 6, 7, 0, 0 },
+    { 0, 1, 2, 3, 4, 5, 6, 7 },
+};
+
+// SSE4.2 kernels for 32 bit keys
+/** !
+ * Compare each lane of A against every lane of B
+ *
+ * @param a vector A
+ * @param b vector B
+ *
+ * @return a 4 bit mask of the lanes of A that are in B
+ */
+__attribute__((target("sse4.2,popcnt")))
+static inline int match_u32_sse42 ( __m128i a, __m128i b )
+{
+
+    // Compare A against each rotation of B
+    __m128i r0 = _mm_cmpeq_epi32(a, b),
+            r1 = _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1))),
+            r2 = _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))),
+            r3 = _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)));
+
+    // Done
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_or_si128(r0, r1), _mm_or_si128(r2, r3))));
+}
+
+/** !
+ * Store the selected lanes of a vector contiguously. Always writes 16 bytes
+ *
+ * @param p_result return
+ * @param v        the vector
+ * @param mask     4 bit mask of lanes to store
+ *
+ * @return the quantity of lanes stored
+ */
+__attribute__((target("sse4.2,popcnt")))
+static inline size_t compact_store_u32_sse42 ( uint32_t *p_result, __m128i v, int mask )
+{
+
+    // Pack the selected lanes, and store them
+    _mm_storeu_si128((__m128i *) p_result, _mm_shuffle_epi8(v, _mm_load_si128((const __m128i *) compact_u32_sse42[mask])));
+
+    // Done
+    return (size_t) __builtin_popcount(mask);
+}
+
+/** !
+ * Merge two sorted vectors into the 4 least keys and the 4 greatest keys
+ *
+ * @param a     sorted vector A
+ * @param b     sorted vector B
+ * @param p_min return the 4 least keys, sorted
+ * @param p_max return the 4 greatest keys, sorted
+ *
+ * @return void
+ */
+__attribute__((target("sse4.2,popcnt")))
+static inline void merge_u32_sse42 ( __m128i a, __m128i b, __m128i *p_min, __m128i *p_max )
+{
+
+    // Initialized data
+    __m128i lo = _mm_min_epu32(a, b),
+            hi = _mm_max_epu32(a, b);
+
+    // Rotate the minima past the maxima, one lane at a time
+    lo = _mm_alignr_epi8(lo, lo, 4);
+    a  = _mm_min_epu32(lo, hi), hi = _mm_max_epu32(lo, hi);
+    lo = _mm_alignr_epi8(a, a, 4);
+    a  = _mm_min_epu32(lo, hi), hi = _mm_max_epu32(lo, hi);
+    lo = _mm_alignr_epi8(a, a, 4);
+    a  = _mm_min_epu32(lo, hi), hi = _mm_max_epu32(lo, hi);
+
+    // Return the result to the caller
+    *p_min = _mm_alignr_epi8(a, a, 4),
+    *p_max = hi;
+
+    // Done
+    return;
+}
+
+/** !
+ * Store the lanes of a sorted vector that do not repeat their predecessor
+ *
+ * @param p_result return. Always writes 16 bytes
+ * @param previous the previously stored vector
+ * @param v        the vector
+ *
+ * @return the quantity of lanes stored
+ */
+__attribute__((target("sse4.2,popcnt")))
+static inline size_t store_unique_u32_sse42 ( uint32_t *p_result, __m128i previous, __m128i v )
+{
+
+    // Shift the last lane of the previous vector into the predecessors of each lane
+    __m128i predecessors = _mm_alignr_epi8(v, previous, 12);
+    int     repeats      = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(predecessors, v)));
+
+    // Store the lanes that are not repeats
+    return compact_store_u32_sse42(p_result, v, ~repeats & 0xf);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t intersection_u32_sse42 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Initialized data
+    size_t i     = 0,
+           j     = 0,
+           k     = 0,
+           a_end = a_count & ~(size_t) 3,
+           b_end = b_count & ~(size_t) 3,
+           room  = ( a_count < b_count ) ? a_count : b_count;
+
+    // Compare blocks of 4 keys. Each key of A is compared to each key of B
+    while ( i < a_end && j < b_end )
+    {
+
+        // Initialized data
+        __m128i  a     = _mm_loadu_si128((const __m128i *) &p_a[i]),
+                 b     = _mm_loadu_si128((const __m128i *) &p_b[j]);
+        int      mask  = match_u32_sse42(a, b);
+        uint32_t a_max = p_a[i + 3],
+                 b_max = p_b[j + 3];
+
+        // Count the matches
+        if ( p_result == (void *) 0 ) k += (size_t) __builtin_popcount(mask);
+
+        // Store the matches, a lane at a time near the end of the result
+        else if ( k + 4 <= room ) k += compact_store_u32_sse42(&p_result[k], a, mask);
+        else for (size_t l = 0; l < 4; l++) if ( mask & ( 1 << l ) ) p_result[k++] = p_a[i + l];
+
+        // Advance the block with the lesser maximum, or both
+        i += ( a_max <= b_max ) << 2;
+        j += ( b_max <= a_max ) << 2;
+    }
+
+    // Finish the partial blocks
+    return k + intersection_u32_scalar(&p_a[i], a_count - i, &p_b[j], b_count - j, ( p_result ) ? &p_result[k] : (void *) 0);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t union_u32_sse42 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Initialized data
+    size_t   i        = 4,
+             j        = 4,
+             k        = 0,
+             a_end    = a_count & ~(size_t) 3,
+             b_end    = b_count & ~(size_t) 3;
+    __m128i  lo, hi, previous;
+    uint32_t tail[4]  = { 0 },
+             last     = 0;
+    size_t   t        = 0;
+
+    // Small inputs
+    if ( a_end == 0 || b_end == 0 ) return union_u32_scalar(p_a, a_count, p_b, b_count, p_result);
+
+    // Merge the first block of each array
+    merge_u32_sse42(_mm_loadu_si128((const __m128i *) p_a), _mm_loadu_si128((const __m128i *) p_b), &lo, &hi);
+
+    // Make sure the first key is not mistaken for a repeat
+    previous = _mm_xor_si128(_mm_shuffle_epi32(lo, 0), _mm_set1_epi32(-1));
+
+    // Store the least keys
+    k += store_unique_u32_sse42(&p_result[k], previous, lo);
+    previous = lo;
+
+    // Merge the block with the lesser first key into the greatest keys
+    while ( i < a_end && j < b_end )
+    {
+
+        // Initialized data
+        __m128i v;
+
+        // Load the next block
+        if ( p_a[i] <= p_b[j] ) v = _mm_loadu_si128((const __m128i *) &p_a[i]), i += 4;
+        else                    v = _mm_loadu_si128((const __m128i *) &p_b[j]), j += 4;
+
+        // Merge
+        merge_u32_sse42(v, hi, &lo, &hi);
+
+        // Store the least keys
+        k += store_unique_u32_sse42(&p_result[k], previous, lo);
+        previous = lo;
+    }
+
+    // Spill the greatest keys, and the last stored key
+    last = (uint32_t) _mm_extract_epi32(previous, 3);
+    _mm_storeu_si128((__m128i *) tail, hi);
+
+    // Merge the spilled keys with the rest of both arrays, skipping repeats
+    while ( t < 4 || i < a_count || j < b_count )
+    {
+
+        // Initialized data
+        uint32_t key = UINT32_MAX;
+        int      src = -1;
+
+        // Find the least key of the three sequences
+        if ( t < 4                                          ) key = tail[t], src = 0;
+        if ( i < a_count && ( src == -1 || p_a[i] < key ) ) key = p_a[i],  src = 1;
+        if ( j < b_count && ( src == -1 || p_b[j] < key ) ) key = p_b[j],  src = 2;
+
+        // Consume the key
+        if      ( src == 0 ) t++;
+        else if ( src == 1 ) i++;
+        else                 j++;
+
+        // Store the key IF it is not a repeat
+        if ( key != last ) p_result[k++] = key, last = key;
+    }
+
+    // Done
+    return k;
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t difference_u32_sse42 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Initialized data
+    size_t i     = 0,
+           j     = 0,
+           k     = 0,
+           a_end = a_count & ~(size_t) 3,
+           b_end = b_count & ~(size_t) 3;
+    int    found = 0;
+
+    // Compare blocks of 4 keys, accumulating the keys of A that are in B
+    while ( i < a_end && j < b_end )
+    {
+
+        // Initialized data
+        __m128i  a     = _mm_loadu_si128((const __m128i *) &p_a[i]),
+                 b     = _mm_loadu_si128((const __m128i *) &p_b[j]);
+        uint32_t a_max = p_a[i + 3],
+                 b_max = p_b[j + 3];
+
+        // Accumulate matches
+        found |= match_u32_sse42(a, b);
+
+        // IF the block of A is done, store the keys that were never matched
+        if ( a_max <= b_max )
+        {
+            k += compact_store_u32_sse42(&p_result[k], a, ~found & 0xf);
+            i += 4, found = 0;
+        }
+
+        // Advance B
+        if ( b_max <= a_max ) j += 4;
+    }
+
+    // Finish the block of A that was in flight
+    if ( found )
+    {
+
+        // Iterate over each key in the block
+        for (size_t l = 0; l < 4; l++, i++)
+        {
+
+            // Skip keys that were matched
+            if ( found & ( 1 << l ) ) continue;
+
+            // Search the rest of B
+            while ( j < b_count && p_b[j] < p_a[i] ) j++;
+
+            // Store the key IF it is not in B
+            if ( j == b_count || p_b[j] != p_a[i] ) p_result[k++] = p_a[i];
+        }
+    }
+
+    // Finish the partial blocks
+    return k + difference_u32_scalar(&p_a[i], a_count - i, &p_b[j], b_count - j, &p_result[k]);
+}
+
+// AVX2 kernels for 64 bit keys
+/** !
+ * Compare each lane of A against every lane of B
+ *
+ * @param a vector A
+ * @param b vector B
+ *
+ * @return a 4 bit mask of the lanes of A that are in B
+ */
+__attribute__((target("avx2,popcnt")))
+static inline int match_u64_avx2 ( __m256i a, __m256i b )
+{
+
+    // Compare A against each rotation of B
+    __m256i r0 = _mm256_cmpeq_epi64(a, b),
+            r1 = _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, 0x39)),
+            r2 = _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, 0x4e)),
+            r3 = _mm256_cmpeq_epi64(a, _mm256_permute4x64_epi64(b, 0x93));
+
+    // Done
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_or_si256(r0, r1), _mm256_or_si256(r2, r3))));
+}
+
+/** !
+ * Store the selected lanes of a vector contiguously. Always writes 32 bytes
+ *
+ * @param p_result return
+ * @param v        the vector
+ * @param mask     4 bit mask of lanes to store
+ *
+ * @return the quantity of lanes stored
+ */
+__attribute__((target("avx2,popcnt")))
+static inline size_t compact_store_u64_avx2 ( uint64_t *p_result, __m256i v, int mask )
+{
+
+    // Pack the selected lanes, and store them
+    _mm256_storeu_si256((__m256i *) p_result, _mm256_permutevar8x32_epi32(v, _mm256_load_si256((const __m256i *) compact_u64_avx2[mask])));
+
+    // Done
+    return (size_t) __builtin_popcount(mask);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t intersection_u64_avx2 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Initialized data
+    size_t i     = 0,
+           j     = 0,
+           k     = 0,
+           a_end = a_count & ~(size_t) 3,
+           b_end = b_count & ~(size_t) 3,
+           room  = ( a_count < b_count ) ? a_count : b_count;
+
+    // Compare blocks of 4 keys. Each key of A is compared to each key of B
+    while ( i < a_end && j < b_end )
+    {
+
+        // Initialized data
+        __m256i  a     = _mm256_loadu_si256((const __m256i *) &p_a[i]),
+                 b     = _mm256_loadu_si256((const __m256i *) &p_b[j]);
+        int      mask  = match_u64_avx2(a, b);
+        uint64_t a_max = p_a[i + 3],
+                 b_max = p_b[j + 3];
+
+        // Count the matches
+        if ( p_result == (void *) 0 ) k += (size_t) __builtin_popcount(mask);
+
+        // Store the matches, a lane at a time near the end of the result
+        else if ( k + 4 <= room ) k += compact_store_u64_avx2(&p_result[k], a, mask);
+        else for (size_t l = 0; l < 4; l++) if ( mask & ( 1 << l ) ) p_result[k++] = p_a[i + l];
+
+        // Advance the block with the lesser maximum, or both
+        i += ( a_max <= b_max ) << 2;
+        j += ( b_max <= a_max ) << 2;
+    }
+
+    // Finish the partial blocks
+    return k + intersection_u64_scalar(&p_a[i], a_count - i, &p_b[j], b_count - j, ( p_result ) ? &p_result[k] : (void *) 0);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t difference_u64_avx2 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Initialized data
+    size_t i     = 0,
+           j     = 0,
+           k     = 0,
+           a_end = a_count & ~(size_t) 3,
+           b_end = b_count & ~(size_t) 3;
+    int    found = 0;
+
+    // Compare blocks of 4 keys, accumulating the keys of A that are in B
+    while ( i < a_end && j < b_end )
+    {
+
+        // Initialized data
+        __m256i  a     = _mm256_loadu_si256((const __m256i *) &p_a[i]),
+                 b     = _mm256_loadu_si256((const __m256i *) &p_b[j]);
+        uint64_t a_max = p_a[i + 3],
+                 b_max = p_b[j + 3];
+
+        // Accumulate matches
+        found |= match_u64_avx2(a, b);
+
+        // IF the block of A is done, store the keys that were never matched
+        if ( a_max <= b_max )
+        {
+            k += compact_store_u64_avx2(&p_result[k], a, ~found & 0xf);
+            i += 4, found = 0;
+        }
+
+        // Advance B
+        if ( b_max <= a_max ) j += 4;
+    }
+
+    // Finish the block of A that was in flight
+    if ( found )
+    {
+
+        // Iterate over each key in the block
+        for (size_t l = 0; l < 4; l++, i++)
+        {
+
+            // Skip keys that were matched
+            if ( found & ( 1 << l ) ) continue;
+
+            // Search the rest of B
+            while ( j < b_count && p_b[j] < p_a[i] ) j++;
+
+            // Store the key IF it is not in B
+            if ( j == b_count || p_b[j] != p_a[i] ) p_result[k++] = p_a[i];
+        }
+    }
+
+    // Finish the partial blocks
+    return k + difference_u64_scalar(&p_a[i], a_count - i, &p_b[j], b_count - j, &p_result[k]);
+}
+#endif
+
+void set_kernel_init ( void )
+{
+
+    #ifdef SET_KERNEL_X86
+
+        // Initialize CPU feature detection
+        __builtin_cpu_init();
+
+        // 32 bit keys
+        if ( __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt") )
+        {
+            pfn_intersection_u32 = &intersection_u32_sse42;
+            pfn_union_u32        = &union_u32_sse42;
+            pfn_difference_u32   = &difference_u32_sse42;
+        }
+
+        // 64 bit keys. AVX2 has no unsigned 64 bit min / max, so the union stays scalar
+        if ( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") )
+        {
+            pfn_intersection_u64 = &intersection_u64_avx2;
+            pfn_difference_u64   = &difference_u64_avx2;
+        }
+    #endif
+
+    // Done
+    return;
+}
+
+size_t set_kernel_intersection_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Done
+    return pfn_intersection_u32(p_a, a_count, p_b, b_count, p_result);
+}
+
+size_t set_kernel_intersection_count_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count )
+{
+
+    // Done
+    return pfn_intersection_u32(p_a, a_count, p_b, b_count, (void *) 0);
+}
+
+size_t set_kernel_union_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Done
+    return pfn_union_u32(p_a, a_count, p_b, b_count, p_result);
+}
+
+size_t set_kernel_difference_u32 ( const uint32_t *p_a, size_t a_count, const uint32_t *p_b, size_t b_count, uint32_t *p_result )
+{
+
+    // Done
+    return pfn_difference_u32(p_a, a_count, p_b, b_count, p_result);
+}
+
+size_t set_kernel_intersection_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Done
+    return pfn_intersection_u64(p_a, a_count, p_b, b_count, p_result);
+}
+
+size_t set_kernel_intersection_count_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count )
+{
+
+    // Done
+    return pfn_intersection_u64(p_a, a_count, p_b, b_count, (void *) 0);
+}
+
+size_t set_kernel_union_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Done
+    return pfn_union_u64(p_a, a_count, p_b, b_count, p_result);
+}
+
+size_t set_kernel_difference_u64 ( const uint64_t *p_a, size_t a_count, const uint64_t *p_b, size_t b_count, uint64_t *p_result )
+{
+
+    // Done
+    return pfn_difference_u64(p_a, a_count, p_b, b_count, p_result);
+}
@@ -0,0 +1,928 @@
+/** !
+ * Lock free hashed set
+ *
+ * @file lockfree.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/lockfree.h>
+#include <set/epoch.h>
+#include <set/parallel.h>
+
+// Preprocessor definitions
+// The quantity of slots that a thread copies at a time, while a table is resized
+#ifndef LOCKFREE_COPY_CHUNK
+#define LOCKFREE_COPY_CHUNK 1024
+#endif
+
+// Slot states. A key is present IF its state is LOCKFREE_PRESENT, and the
+// moved bit freezes a slot, once its table is being copied
+#define LOCKFREE_UNSET   0
+#define LOCKFREE_ABSENT  1
+#define LOCKFREE_PRESENT 2
+#define LOCKFREE_MOVED   4
+
+// Chunk states. A chunk that fails to copy is released, so any thread may
+// claim it again
+#define LOCKFREE_CHUNK_FREE    0
+#define LOCKFREE_CHUNK_CLAIMED 1
+#define LOCKFREE_CHUNK_COPIED  2
+
+// Enumeration definitions
+enum lockfree_probe_e
+{
+    LOCKFREE_FOUND,
+    LOCKFREE_NOT_FOUND,
+    LOCKFREE_NEXT
+};
+
+// Forward declarations
+struct lockfree_slot_s;
+struct lockfree_table_s;
+
+// Type definitions
+typedef enum   lockfree_probe_e lockfree_probe;
+typedef struct lockfree_slot_s  lockfree_slot;
+typedef struct lockfree_table_s lockfree_table;
+
+// Data
+// Empty slots of a table that is being copied point here, so no key is
+// claimed behind the copy
+static char lockfree_closed[1] = { 0 };
+
+// Structure definitions
+// A slot is empty IF p_key is null ELSE closed IF p_key is lockfree_closed
+struct lockfree_slot_s
+{
+    void      *p_key;
+    uintptr_t  state;
+};
+
+// The slots follow the structure, and the chunk states follow the slots,
+// in the same allocation
+struct lockfree_table_s
+{
+    size_t          max,
+                    chunks,
+                    used,
+                    claimed,
+                    copied;
+    bool            done;
+    unsigned char  *p_chunks;
+    lockfree_table *p_next,
+                   *p_retired;
+    lockfree_slot   slots[];
+};
+
+// The count is written by every writer, so it gets its own cache line.
+// Outgrown tables are retired to the epoch, or kept on the retired list
+// until the set is destroyed IF the epoch is out of memory
+struct lockfree_s
+{
+    lockfree_table *p_head,
+                   *p_retired;
+    epoch          *p_epoch;
+    set_equal_fn   *pfn_is_equal;
+    set_hash_fn    *pfn_hash;
+    uintptr_t       null_state;
+    char            _padding[64];
+    size_t          count;
+};
+
+/** !
+ * Compute the mixed hash of an element
+ *
+ * @param p_lockfree the lock free set
+ * @param p_element  the element
+ *
+ * @return the hash
+ */
+static unsigned long long lockfree_hash ( const lockfree *const p_lockfree, const void *const p_element )
+{
+
+    // Done
+    return set_hash_mix(( p_lockfree->pfn_hash ) ? p_lockfree->pfn_hash(p_element) : (unsigned long long) (uintptr_t) p_element);
+}
+
+/** !
+ * Construct an empty table
+ *
+ * @param max the quantity of slots. Must be a power of two
+ *
+ * @return the table IF successful ELSE null
+ */
+static lockfree_table *lockfree_table_construct ( size_t max )
+{
+
+    // Initialized data
+    size_t          chunks  = ( max + LOCKFREE_COPY_CHUNK - 1 ) / LOCKFREE_COPY_CHUNK;
+    lockfree_table *p_table = SET_CALLOC(1, sizeof(lockfree_table) + max * sizeof(lockfree_slot) + chunks);
+
+    // Error check
+    if ( p_table == (void *) 0 ) return (void *) 0;
+
+    // Store the size, and find the chunk states
+    p_table->max      = max,
+    p_table->chunks   = chunks,
+    p_table->p_chunks = (unsigned char *) &p_table->slots[max];
+
+    // Done
+    return p_table;
+}
+
+/** !
+ * Get the table after a table, starting a resize IF there is none
+ *
+ * @param p_lockfree the lock free set
+ * @param p_table    the table
+ *
+ * @return the next table IF successful ELSE null
+ */
+static lockfree_table *lockfree_resize ( lockfree *const p_lockfree, lockfree_table *const p_table )
+{
+
+    // Initialized data
+    lockfree_table *p_next = __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE),
+                   *p_new  = (void *) 0;
+    size_t          count  = __atomic_load_n(&p_lockfree->count, __ATOMIC_RELAXED),
+                    max    = p_table->max;
+
+    // Another thread started the resize
+    if ( p_next ) return p_next;
+
+    // A remove can count before the add it undoes
+    if ( (ptrdiff_t) count < 0 ) count = 0;
+
+    // Grow until the live elements fill at most half of the table. A table
+    // that is full of tombstones is copied into one of the same size
+    while ( max / 2 < count && max < SIZE_MAX / 2 ) max <<= 1;
+
+    // Construct the next table
+    p_new = lockfree_table_construct(max);
+
+    // Error check
+    if ( p_new == (void *) 0 ) return (void *) 0;
+
+    // Publish the next table, unless another thread got there first
+    if ( __atomic_compare_exchange_n(&p_table->p_next, &p_next, p_new, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) return p_new;
+
+    // Clean up
+    SET_FREE(p_new);
+
+    // Done
+    return p_next;
+}
+
+/** !
+ * Find the slot of a key in one table, and optionally claim an empty one
+ *
+ * @param p_lockfree the lock free set
+ * @param p_table    the table
+ * @param p_key      the key
+ * @param hash       the mixed hash of the key
+ * @param claim      true IF an empty slot should be claimed for the key ELSE false
+ * @param p_slot     return the slot
+ *
+ * @return LOCKFREE_FOUND IF the key has a slot ELSE LOCKFREE_NEXT IF the key belongs in the next table ELSE LOCKFREE_NOT_FOUND
+ */
+static lockfree_probe lockfree_probe_table ( lockfree *const p_lockfree, lockfree_table *const p_table, const void *const p_key, unsigned long long hash, bool claim, size_t *const p_slot )
+{
+
+    // Initialized data
+    size_t mask = p_table->max - 1;
+
+    // Linear probe
+    for (size_t i = 0; i < p_table->max; i++)
+    {
+
+        // Initialized data
+        size_t         j      = (size_t) ( hash + i ) & mask;
+        lockfree_slot *p      = &p_table->slots[j];
+        void          *p_seen = __atomic_load_n(&p->p_key, __ATOMIC_ACQUIRE);
+
+        // Empty slot. Failed swaps reload the slot
+        while ( p_seen == (void *) 0 )
+        {
+
+            // Lookups stop at the first empty slot
+            if ( claim == false ) return LOCKFREE_NOT_FOUND;
+
+            // Tables that are being copied take no new keys. Close the slot,
+            // so no other thread claims it for the key, and continue in the
+            // next table
+            if ( __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE) )
+            {
+                if ( __atomic_compare_exchange_n(&p->p_key, &p_seen, (void *) lockfree_closed, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) return LOCKFREE_NEXT;
+                continue;
+            }
+
+            // Claim the slot
+            if ( __atomic_compare_exchange_n(&p->p_key, &p_seen, (void *) p_key, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+            {
+
+                // Start a resize, once the table is three quarters full
+                if ( __atomic_add_fetch(&p_table->used, 1, __ATOMIC_RELAXED) > p_table->max / 4 * 3 ) (void)lockfree_resize(p_lockfree, p_table);
+
+                // Done
+                *p_slot = j;
+                return LOCKFREE_FOUND;
+            }
+        }
+
+        // Closed slot
+        if ( p_seen == lockfree_closed ) return LOCKFREE_NEXT;
+
+        // Same key
+        if ( p_seen == p_key || ( p_lockfree->pfn_is_equal && p_lockfree->pfn_is_equal(p_seen, p_key) == 0 ) )
+        {
+
+            // Done
+            *p_slot = j;
+            return LOCKFREE_FOUND;
+        }
+    }
+
+    // The table is full
+    return ( claim || __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE) ) ? LOCKFREE_NEXT : LOCKFREE_NOT_FOUND;
+}
+
+/** !
+ * Find the slot of a key, starting at a table, and following the chain of
+ * tables that are being resized
+ *
+ * @param p_lockfree the lock free set
+ * @param pp_table   the first table. Return the table of the slot
+ * @param p_key      the key
+ * @param hash       the mixed hash of the key
+ * @param claim      true IF an empty slot should be claimed for the key ELSE false
+ * @param p_slot     return the slot
+ *
+ * @return 1 IF found, 0 IF not found, -1 on error
+ */
+static int lockfree_locate ( lockfree *const p_lockfree, lockfree_table **const pp_table, const void *const p_key, unsigned long long hash, bool claim, size_t *const p_slot )
+{
+
+    // Initialized data
+    lockfree_table *p_table = *pp_table;
+
+    // Probe each table, until the key is found
+    for (;;)
+    {
+
+        // Probe
+        switch ( lockfree_probe_table(p_lockfree, p_table, p_key, hash, claim, p_slot) )
+        {
+            case LOCKFREE_FOUND:
+                *pp_table = p_table;
+                return 1;
+
+            case LOCKFREE_NOT_FOUND:
+                return 0;
+
+            default:
+                break;
+        }
+
+        // Continue in the next table
+        p_table = lockfree_resize(p_lockfree, p_table);
+
+        // Error check
+        if ( p_table == (void *) 0 ) return -1;
+    }
+}
+
+/** !
+ * Store a copied key in the first table that will hold it, unless an
+ * operation on the key got there first
+ *
+ * @param p_lockfree the lock free set
+ * @param p_table    the table after the table of the copied slot
+ * @param p_key      the key
+ *
+ * @return 1 on success, 0 on error
+ */
+static int lockfree_transfer ( lockfree *const p_lockfree, lockfree_table *p_table, void *const p_key )
+{
+
+    // Initialized data
+    unsigned long long hash = lockfree_hash(p_lockfree, p_key);
+
+    // Follow the chain of tables
+    for (;;)
+    {
+
+        // Initialized data
+        size_t    slot  = 0;
+        uintptr_t state = LOCKFREE_UNSET;
+
+        // Claim a slot for the key
+        if ( lockfree_locate(p_lockfree, &p_table, p_key, hash, true, &slot) < 1 ) return 0;
+
+        // Only the first write to the slot counts. Later writes already saw the copied key
+        if ( __atomic_compare_exchange_n(&p_table->slots[slot].state, &state, LOCKFREE_PRESENT, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) return 1;
+        if ( state != ( LOCKFREE_UNSET | LOCKFREE_MOVED ) ) return 1;
+
+        // The slot froze before it was written. Continue in the next table
+        p_table = __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE);
+    }
+}
+
+/** !
+ * Copy one slot of a table into the next table. Copies are idempotent, so
+ * any quantity of threads may copy the same slot
+ *
+ * @param p_lockfree the lock free set
+ * @param p_table    the table. Must have a next table
+ * @param i          the slot
+ *
+ * @return 1 on success, 0 on error
+ */
+static int lockfree_copy_slot ( lockfree *const p_lockfree, lockfree_table *const p_table, size_t i )
+{
+
+    // Initialized data
+    lockfree_slot *p      = &p_table->slots[i];
+    void          *p_key  = __atomic_load_n(&p->p_key, __ATOMIC_ACQUIRE);
+    uintptr_t      state  = 0;
+
+    // Close empty slots
+    while ( p_key == (void *) 0 )
+        if ( __atomic_compare_exchange_n(&p->p_key, &p_key, (void *) lockfree_closed, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) return 1;
+
+    // Closed slots hold nothing
+    if ( p_key == lockfree_closed ) return 1;
+
+    // Freeze the slot
+    state = __atomic_load_n(&p->state, __ATOMIC_ACQUIRE);
+    while ( ( state & LOCKFREE_MOVED ) == 0 )
+        if ( __atomic_compare_exchange_n(&p->state, &state, state | LOCKFREE_MOVED, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) break;
+
+    // Only present keys move
+    if ( ( state & ~(uintptr_t) LOCKFREE_MOVED ) != LOCKFREE_PRESENT ) return 1;
+
+    // Copy the key
+    return lockfree_transfer(p_lockfree, __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE), p_key);
+}
+
+/** !
+ * Retire each table at the head of the chain that has been copied
+ *
+ * @param p_lockfree the lock free set
+ *
+ * @return void
+ */
+static void lockfree_promote ( lockfree *const p_lockfree )
+{
+
+    // Initialized data
+    lockfree_table *p_head = __atomic_load_n(&p_lockfree->p_head, __ATOMIC_ACQUIRE);
+
+    // Advance past every copied table. Failed swaps reload the head
+    while ( __atomic_load_n(&p_head->done, __ATOMIC_ACQUIRE) )
+    {
+
+        // Initialized data
+        lockfree_table *p_next = __atomic_load_n(&p_head->p_next, __ATOMIC_ACQUIRE);
+
+        // Advance the head
+        if ( __atomic_compare_exchange_n(&p_lockfree->p_head, &p_head, p_next, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == false ) continue;
+
+        // Free the old head, once every thread that might be probing it has left
+        if ( epoch_retire(p_lockfree->p_epoch, p_head) == 0 )
+        {
+
+            // Keep the old head until the set is destroyed
+            p_head->p_retired = __atomic_load_n(&p_lockfree->p_retired, __ATOMIC_RELAXED);
+            while ( __atomic_compare_exchange_n(&p_lockfree->p_retired, &p_head->p_retired, p_head, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED) == false );
+        }
+
+        // Continue with the new head
+        p_head = p_next;
+    }
+
+    // Done
+    return;
+}
+
+/** !
+ * Copy a chunk of a table that is being resized. Chunks are handed out in
+ * order, and once every chunk has been handed out, chunks that failed to 
+ * copy are claimed again
+ *
+ * @param p_lockfree the lock free set
+ * @param p_table    the table
+ *
+ * @return 1 on success, 0 on error
+ */
+static int lockfree_help ( lockfree *const p_lockfree, lockfree_table *const p_table )
+{
+
+    // Initialized data
+    size_t        chunk = __atomic_fetch_add(&p_table->claimed, 1, __ATOMIC_RELAXED),
+                  start = 0,
+                  end   = 0;
+    unsigned char state = LOCKFREE_CHUNK_FREE;
+
+    // Every chunk was handed out. Look for a chunk that was released
+    if ( chunk >= p_table->chunks )
+    {
+        for (chunk = 0; chunk < p_table->chunks; chunk++, state = LOCKFREE_CHUNK_FREE)
+            if ( __atomic_compare_exchange_n(&p_table->p_chunks[chunk], &state, LOCKFREE_CHUNK_CLAIMED, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) ) break;
+    }
+
+    // Claim the chunk that was handed out, unless a thread looking for a released chunk got there first
+    else if ( __atomic_compare_exchange_n(&p_table->p_chunks[chunk], &state, LOCKFREE_CHUNK_CLAIMED, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) == false ) return 1;
+
+    // Every chunk is claimed or copied
+    if ( chunk >= p_table->chunks ) return 1;
+
+    // Copy the chunk. Copies are idempotent, so the slots of a chunk that
+    // is released are safe to copy again
+    start = chunk * LOCKFREE_COPY_CHUNK,
+    end   = ( start + LOCKFREE_COPY_CHUNK < p_table->max ) ? start + LOCKFREE_COPY_CHUNK : p_table->max;
+    for (size_t i = start; i < end; i++)
+        if ( lockfree_copy_slot(p_lockfree, p_table, i) == 0 ) goto failed_to_copy;
+
+    // Mark the chunk copied
+    __atomic_store_n(&p_table->p_chunks[chunk], LOCKFREE_CHUNK_COPIED, __ATOMIC_RELEASE);
+
+    // The last chunk finishes the copy
+    if ( __atomic_add_fetch(&p_table->copied, end - start, __ATOMIC_ACQ_REL) == p_table->max )
+        __atomic_store_n(&p_table->done, true, __ATOMIC_RELEASE), lockfree_promote(p_lockfree);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Lock free set errors
+        {
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] [lockfree] Failed to copy a chunk of a table in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Release the chunk, so another thread can copy it
+                __atomic_store_n(&p_table->p_chunks[chunk], LOCKFREE_CHUNK_FREE, __ATOMIC_RELEASE);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Get the head table, after helping to copy it IF it is being resized, 
+ * and freeing outgrown tables IF no thread can be probing them. The 
+ * calling thread must be inside the epoch
+ *
+ * @param p_lockfree the lock free set
+ *
+ * @return the head table IF successful ELSE null
+ */
+static lockfree_table *lockfree_head ( lockfree *const p_lockfree )
+{
+
+    // Initialized data
+    lockfree_table *p_head = __atomic_load_n(&p_lockfree->p_head, __ATOMIC_ACQUIRE);
+
+    // Help the resize along
+    if ( __atomic_load_n(&p_head->p_next, __ATOMIC_ACQUIRE) )
+        if ( lockfree_help(p_lockfree, p_head) == 0 ) return (void *) 0;
+
+    // Free outgrown tables
+    if ( epoch_pending(p_lockfree->p_epoch) ) (void)epoch_reclaim(p_lockfree->p_epoch);
+
+    // Done
+    return p_head;
+}
+
+int lockfree_construct ( lockfree **const pp_lockfree, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash )
+{
+
+    // Argument check
+    if ( pp_lockfree == (void *) 0 ) goto no_lockfree;
+
+    // Initialized data
+    size_t    max        = 8;
+    lockfree *p_lockfree = SET_CALLOC(1, sizeof(lockfree));
+
+    // Error check
+    if ( p_lockfree == (void *) 0 ) goto no_mem;
+
+    // Double until the load factor is at most one half
+    while ( max < size * 2 ) max <<= 1;
+
+    // Store the functions
+    p_lockfree->pfn_is_equal = pfn_is_equal,
+    p_lockfree->pfn_hash     = pfn_hash,
+    p_lockfree->null_state   = LOCKFREE_ABSENT;
+
+    // Construct the epoch, and the first table
+    if ( epoch_construct(&p_lockfree->p_epoch) == 0 ) goto no_mem;
+    p_lockfree->p_head = lockfree_table_construct(max);
+
+    // Error check
+    if ( p_lockfree->p_head == (void *) 0 ) goto no_mem;
+
+    // Return a pointer to the caller
+    *pp_lockfree = p_lockfree;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_lockfree:
+                #ifndef NDEBUG
+                    printf("[set] [lockfree] Null pointer provided for parameter \"pp_lockfree\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_lockfree ) (void)epoch_destroy(&p_lockfree->p_epoch);
+                SET_FREE(p_lockfree);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool lockfree_contains ( lockfree *const p_lockfree, const void *const p_element )
+{
+
+    // Argument check
+    if ( p_lockfree == (void *) 0 ) return false;
+
+    // The null element has a slot of its own
+    if ( p_element == (void *) 0 ) return __atomic_load_n(&p_lockfree->null_state, __ATOMIC_ACQUIRE) == LOCKFREE_PRESENT;
+
+    // Initialized data
+    epoch_record       *p_record = epoch_enter(p_lockfree->p_epoch);
+    lockfree_table     *p_table  = (void *) 0;
+    unsigned long long  hash     = lockfree_hash(p_lockfree, p_element);
+    size_t              slot     = 0;
+    uintptr_t           state    = 0;
+
+    // Error check
+    if ( p_record == (void *) 0 ) return false;
+
+    // Find the head table
+    p_table = lockfree_head(p_lockfree);
+
+    // Follow frozen slots to the table that holds the key
+    while ( p_table )
+    {
+
+        // Find the slot of the key
+        if ( lockfree_locate(p_lockfree, &p_table, p_element, hash, false, &slot) < 1 ) break;
+
+        // Read the state
+        state = __atomic_load_n(&p_table->slots[slot].state, __ATOMIC_ACQUIRE);
+
+        // Done
+        if ( ( state & LOCKFREE_MOVED ) == 0 ) break;
+
+        // Copy the frozen slot, and continue in the next table
+        if ( lockfree_copy_slot(p_lockfree, p_table, slot) == 0 ) break;
+        p_table = __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE);
+    }
+
+    // Leave the epoch
+    epoch_exit(p_record);
+
+    // Done
+    return state == LOCKFREE_PRESENT;
+}
+
+size_t lockfree_count ( const lockfree *const p_lockfree )
+{
+
+    // Argument check
+    if ( p_lockfree == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t count = __atomic_load_n(&p_lockfree->count, __ATOMIC_RELAXED);
+
+    // A remove can count before the add it undoes
+    return ( (ptrdiff_t) count < 0 ) ? 0 : count;
+}
+
+int lockfree_add ( lockfree *const p_lockfree, void *const p_element )
+{
+
+    // Argument check
+    if ( p_lockfree == (void *) 0 ) goto no_lockfree;
+
+    // Initialized data
+    epoch_record       *p_record = (void *) 0;
+    lockfree_table     *p_table  = (void *) 0;
+    unsigned long long  hash     = 0;
+    uintptr_t           state    = LOCKFREE_ABSENT;
+    size_t              slot     = 0;
+
+    // The null element has a slot of its own
+    if ( p_element == (void *) 0 )
+    {
+
+        // Mark the null element present
+        if ( __atomic_compare_exchange_n(&p_lockfree->null_state, &state, LOCKFREE_PRESENT, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+            __atomic_add_fetch(&p_lockfree->count, 1, __ATOMIC_RELAXED);
+
+        // Success
+        return 1;
+    }
+
+    // Enter the epoch
+    p_record = epoch_enter(p_lockfree->p_epoch);
+
+    // Error check
+    if ( p_record == (void *) 0 ) goto no_mem;
+
+    // Find the head table, and hash the element
+    p_table = lockfree_head(p_lockfree),
+    hash    = lockfree_hash(p_lockfree, p_element);
+
+    // Error check
+    if ( p_table == (void *) 0 ) goto no_mem;
+
+    // Follow frozen slots to the table that holds the key
+    for (;;)
+    {
+
+        // Find or claim the slot of the key
+        if ( lockfree_locate(p_lockfree, &p_table, p_element, hash, true, &slot) < 1 ) goto no_mem;
+
+        // Read the state
+        state = __atomic_load_n(&p_table->slots[slot].state, __ATOMIC_ACQUIRE);
+
+        // Mark the key present. Failed swaps reload the state
+        while ( ( state & LOCKFREE_MOVED ) == 0 )
+        {
+
+            // The key is already present
+            if ( state == LOCKFREE_PRESENT ) goto done;
+
+            // Mark the key present, and count it
+            if ( __atomic_compare_exchange_n(&p_table->slots[slot].state, &state, LOCKFREE_PRESENT, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+            {
+                __atomic_add_fetch(&p_lockfree->count, 1, __ATOMIC_RELAXED);
+                goto done;
+            }
+        }
+
+        // Copy the frozen slot, and continue in the next table
+        if ( lockfree_copy_slot(p_lockfree, p_table, slot) == 0 ) goto no_mem;
+        p_table = __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE);
+    }
+
+    done:
+
+    // Leave the epoch
+    epoch_exit(p_record);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_lockfree:
+                #ifndef NDEBUG
+                    printf("[set] [lockfree] Null pointer provided for parameter \"p_lockfree\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                epoch_exit(p_record);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int lockfree_remove ( lockfree *const p_lockfree, void *const p_element )
+{
+
+    // Argument check
+    if ( p_lockfree == (void *) 0 ) goto no_lockfree;
+
+    // Initialized data
+    epoch_record       *p_record = (void *) 0;
+    lockfree_table     *p_table  = (void *) 0;
+    unsigned long long  hash     = 0;
+    uintptr_t           state    = LOCKFREE_PRESENT;
+    size_t              slot     = 0;
+
+    // The null element has a slot of its own
+    if ( p_element == (void *) 0 )
+    {
+
+        // Mark the null element absent
+        if ( __atomic_compare_exchange_n(&p_lockfree->null_state, &state, LOCKFREE_ABSENT, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == false ) return 0;
+
+        // Uncount it
+        __atomic_sub_fetch(&p_lockfree->count, 1, __ATOMIC_RELAXED);
+
+        // Success
+        return 1;
+    }
+
+    // Enter the epoch
+    p_record = epoch_enter(p_lockfree->p_epoch);
+
+    // Error check
+    if ( p_record == (void *) 0 ) goto no_mem;
+
+    // Find the head table, and hash the element
+    p_table = lockfree_head(p_lockfree),
+    hash    = lockfree_hash(p_lockfree, p_element);
+
+    // Error check
+    if ( p_table == (void *) 0 ) goto no_mem;
+
+    // Follow frozen slots to the table that holds the key
+    for (;;)
+    {
+
+        // Find the slot of the key
+        switch ( lockfree_locate(p_lockfree, &p_table, p_element, hash, false, &slot) )
+        {
+            case 1:
+                break;
+
+            case 0:
+                goto not_present;
+
+            default:
+                goto no_mem;
+        }
+
+        // Read the state
+        state = __atomic_load_n(&p_table->slots[slot].state, __ATOMIC_ACQUIRE);
+
+        // Leave a tombstone. Failed swaps reload the state
+        while ( ( state & LOCKFREE_MOVED ) == 0 )
+        {
+
+            // The key is not present
+            if ( state != LOCKFREE_PRESENT ) goto not_present;
+
+            // Mark the key absent, and uncount it
+            if ( __atomic_compare_exchange_n(&p_table->slots[slot].state, &state, LOCKFREE_ABSENT, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+            {
+                __atomic_sub_fetch(&p_lockfree->count, 1, __ATOMIC_RELAXED);
+                goto done;
+            }
+        }
+
+        // Copy the frozen slot, and continue in the next table
+        if ( lockfree_copy_slot(p_lockfree, p_table, slot) == 0 ) goto no_mem;
+        p_table = __atomic_load_n(&p_table->p_next, __ATOMIC_ACQUIRE);
+    }
+
+    done:
+
+    // Leave the epoch
+    epoch_exit(p_record);
+
+    // Success
+    return 1;
+
+    // The key is not present
+    not_present:
+
+        // Leave the epoch
+        epoch_exit(p_record);
+
+        // Done
+        return 0;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_lockfree:
+                #ifndef NDEBUG
+                    printf("[set] [lockfree] Null pointer provided for parameter \"p_lockfree\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                epoch_exit(p_record);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int lockfree_destroy ( lockfree **const pp_lockfree )
+{
+
+    // Argument check
+    if ( pp_lockfree == (void *) 0 ) goto no_lockfree;
+
+    // Initialized data
+    lockfree       *p_lockfree = *pp_lockfree;
+    lockfree_table *p_table    = (void *) 0;
+
+    // Nothing to do
+    if ( p_lockfree == (void *) 0 ) return 1;
+
+    // No more lock free set for caller
+    *pp_lockfree = (void *) 0;
+
+    // Free the tables that are waiting on the epoch
+    (void)epoch_destroy(&p_lockfree->p_epoch);
+
+    // Free the tables that were kept until now
+    for (p_table = p_lockfree->p_retired; p_table; )
+    {
+
+        // Initialized data
+        lockfree_table *p_retired = p_table->p_retired;
+
+        // Free the table
+        SET_FREE(p_table);
+
+        // Next
+        p_table = p_retired;
+    }
+
+    // Free the head table, and any tables chained after it
+    for (p_table = p_lockfree->p_head; p_table; )
+    {
+
+        // Initialized data
+        lockfree_table *p_next = p_table->p_next;
+
+        // Free the table
+        SET_FREE(p_table);
+
+        // Next
+        p_table = p_next;
+    }
+
+    // Free the lock free set
+    SET_FREE(p_lockfree);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_lockfree:
+                #ifndef NDEBUG
+                    printf("[set] [lockfree] Null pointer provided for parameter \"pp_lockfree\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,207 @@
+/** !
+ * MinHash signature
+ *
+ * @file minhash.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/minhash.h>
+
+// Structure definitions
+// The slots follow the structure, in the same allocation. Empty slots are UINT64_MAX
+struct minhash_s
+{
+    size_t   k;
+    uint64_t slots[];
+};
+
+int minhash_construct ( minhash **const pp_minhash, size_t k )
+{
+
+    // Argument check
+    if ( pp_minhash == (void *) 0 ) goto no_minhash;
+    if ( k          == 0          ) goto no_slots;
+
+    // Initialized data
+    minhash *p_minhash = SET_REALLOC(0, sizeof(minhash) + k * sizeof(uint64_t));
+
+    // Error check
+    if ( p_minhash == (void *) 0 ) goto no_mem;
+
+    // Empty every slot
+    p_minhash->k = k;
+    memset(p_minhash->slots, 0xff, k * sizeof(uint64_t));
+
+    // Return a pointer to the caller
+    *pp_minhash = p_minhash;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_minhash:
+                #ifndef NDEBUG
+                    printf("[set] [minhash] Null pointer provided for parameter \"pp_minhash\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_slots:
+                #ifndef NDEBUG
+                    printf("[set] [minhash] Parameter \"k\" must be positive in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t minhash_size ( const minhash *const p_minhash )
+{
+
+    // Done
+    return ( p_minhash ) ? p_minhash->k : 0;
+}
+
+double minhash_jaccard ( const minhash *const p_a, const minhash *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return -1;
+    if ( p_b == (void *) 0 ) return -1;
+    if ( p_a->k != p_b->k  ) return -1;
+
+    // Initialized data
+    size_t agree = 0,
+           used  = 0;
+
+    // Count the slots that agree. Slots that are empty in both are skipped
+    for (size_t i = 0; i < p_a->k; i++)
+        agree += p_a->slots[i] == p_b->slots[i] && p_a->slots[i] != UINT64_MAX,
+        used  += ( p_a->slots[i] & p_b->slots[i] ) != UINT64_MAX;
+
+    // Done
+    return ( used ) ? (double) agree / (double) used : 0;
+}
+
+void minhash_add ( minhash *const p_minhash, uint64_t hash )
+{
+
+    // Keep the least value of each hash function. Slot i hashes with
+    // its own seed, so the loop has no dependencies, and vectorizes
+    for (size_t i = 0; i < p_minhash->k; i++)
+    {
+
+        // Initialized data
+        uint64_t x = hash ^ ( ( i + 1 ) * 0x9E3779B97F4A7C15ULL );
+
+        // Mix
+        x ^= x >> 32;
+        x *= 0xD6E8FEB86659FD93ULL;
+        x ^= x >> 32;
+
+        // Keep the least value. UINT64_MAX marks an empty slot
+        x -= x == UINT64_MAX;
+        if ( x < p_minhash->slots[i] ) p_minhash->slots[i] = x;
+    }
+
+    // Done
+    return;
+}
+
+int minhash_merge ( minhash *const p_a, const minhash *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+    if ( p_a->k != p_b->k  ) goto size_mismatch;
+
+    // Keep the lesser of each pair of slots
+    for (size_t i = 0; i < p_a->k; i++)
+        if ( p_b->slots[i] < p_a->slots[i] ) p_a->slots[i] = p_b->slots[i];
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] [minhash] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] [minhash] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            size_mismatch:
+                #ifndef NDEBUG
+                    printf("[set] [minhash] Signatures have different sizes in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int minhash_destroy ( minhash **const pp_minhash )
+{
+
+    // Argument check
+    if ( pp_minhash == (void *) 0 ) goto no_minhash;
+
+    // Free the signature, along with its slots
+    SET_FREE(*pp_minhash);
+
+    // No more signature for caller
+    *pp_minhash = (void *) 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_minhash:
+                #ifndef NDEBUG
+                    printf("[set] [minhash] Null pointer provided for parameter \"pp_minhash\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
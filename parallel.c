@@ -0,0 +1,447 @@
+/** !
+ * Worker threads, locks and hashing for set operations
+ *
+ * @file parallel.c
+ *
+ * @author Jacob Smith
+ */
+
+// Feature test macros, for pthread_rwlockattr_setkind_np
+#if !defined(_WIN64) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+// Headers
+#include <set/parallel.h>
+
+// Platform dependent headers
+#ifdef _WIN64
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Forward declarations
+struct set_parallel_job_s;
+
+// Type definitions
+typedef struct set_parallel_job_s set_parallel_job;
+
+// Structure definitions
+// One task, and its result
+struct set_parallel_job_s
+{
+    set_task_fn *pfn_task;
+    void        *p_argument;
+    int          result;
+};
+
+/** !
+ * Run one job on a worker thread
+ *
+ * @param p_job the job
+ *
+ * @return 0
+ */
+#ifdef _WIN64
+static DWORD WINAPI set_parallel_worker ( void *p_job )
+#else
+static void *set_parallel_worker ( void *p_job )
+#endif
+{
+
+    // Initialized data
+    set_parallel_job *p = p_job;
+
+    // Run the task
+    p->result = p->pfn_task(p->p_argument);
+
+    // Done
+    return 0;
+}
+
+int set_rwlock_create ( set_rwlock *const p_rwlock )
+{
+
+    // Argument check
+    if ( p_rwlock == (void *) 0 ) goto no_rwlock;
+
+    #ifdef _WIN64
+
+        // Slim reader/writer locks never fail to initialize
+        InitializeSRWLock((PSRWLOCK) p_rwlock);
+    #else
+    {
+
+        // Initialized data
+        pthread_rwlockattr_t attributes;
+        int                  result = 0;
+
+        // Error check
+        if ( pthread_rwlockattr_init(&attributes) ) goto failed_to_create_lock;
+
+        // glibc prefers readers by default, which starves writers under a
+        // steady stream of readers. Nonrecursive locks may prefer writers
+        #ifdef __GLIBC__
+            (void)pthread_rwlockattr_setkind_np(&attributes, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+        #endif
+
+        // Construct the lock
+        result = pthread_rwlock_init(p_rwlock, &attributes);
+
+        // Clean up
+        (void)pthread_rwlockattr_destroy(&attributes);
+
+        // Error check
+        if ( result ) goto failed_to_create_lock;
+    }
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_rwlock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_rwlock\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Platform errors
+        #ifndef _WIN64
+        {
+            failed_to_create_lock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Failed to create reader/writer lock in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+        #endif
+    }
+}
+
+size_t set_parallel_hardware_threads ( void )
+{
+
+    // Initialized data
+    long threads = 1;
+
+    // Ask the operating system
+    #ifdef _WIN64
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        threads = (long) info.dwNumberOfProcessors;
+    }
+    #else
+        threads = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+
+    // Done
+    return ( threads > 1 ) ? (size_t) threads : 1;
+}
+
+int set_parallel_run ( set_task_fn *pfn_task, void *const p_arguments, size_t size, size_t count )
+{
+
+    // Argument check
+    if ( pfn_task    == (void *) 0 ) goto no_task;
+    if ( p_arguments == (void *) 0 ) goto no_arguments;
+
+    // One task runs on the calling thread
+    if ( count < 2 ) return ( count ) ? pfn_task(p_arguments) : 1;
+
+    // Initialized data
+    set_parallel_job *p_jobs    = SET_CALLOC(count, sizeof(set_parallel_job));
+    #ifdef _WIN64
+        HANDLE       *p_threads = SET_CALLOC(count, sizeof(HANDLE));
+    #else
+        pthread_t    *p_threads = SET_CALLOC(count, sizeof(pthread_t));
+    #endif
+    bool             *p_started = SET_CALLOC(count, sizeof(bool));
+    int               result    = 1;
+
+    // Error check
+    if ( p_jobs    == (void *) 0 ) goto no_mem;
+    if ( p_threads == (void *) 0 ) goto no_mem;
+    if ( p_started == (void *) 0 ) goto no_mem;
+
+    // Start a thread for every job but the first
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Store the job
+        p_jobs[i] = (set_parallel_job)
+        {
+            .pfn_task   = pfn_task,
+            .p_argument = (char *) p_arguments + i * size,
+            .result     = 0
+        };
+
+        // The first job runs on the calling thread
+        if ( i == 0 ) continue;
+
+        // Start a thread
+        #ifdef _WIN64
+            p_threads[i] = CreateThread((void *) 0, 0, &set_parallel_worker, &p_jobs[i], 0, (void *) 0);
+            p_started[i] = p_threads[i] != (void *) 0;
+        #else
+            p_started[i] = pthread_create(&p_threads[i], (void *) 0, &set_parallel_worker, &p_jobs[i]) == 0;
+        #endif
+    }
+
+    // Run the first job
+    (void)set_parallel_worker(&p_jobs[0]);
+
+    // Wait for the other jobs
+    for (size_t i = 1; i < count; i++)
+    {
+
+        // Jobs that could not start a thread run on the calling thread
+        if ( p_started[i] == false ) (void)set_parallel_worker(&p_jobs[i]);
+
+        // Join the thread
+        else
+        {
+            #ifdef _WIN64
+                WaitForSingleObject(p_threads[i], INFINITE), CloseHandle(p_threads[i]);
+            #else
+                pthread_join(p_threads[i], (void *) 0);
+            #endif
+        }
+    }
+
+    // Accumulate the results
+    for (size_t i = 0; i < count; i++) result &= p_jobs[i].result;
+
+    // Clean up
+    SET_FREE(p_jobs);
+    SET_FREE(p_threads);
+    SET_FREE(p_started);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_task:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"pfn_task\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_arguments:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_arguments\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_jobs);
+                SET_FREE(p_threads);
+                SET_FREE(p_started);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+unsigned long long set_hash_mix ( unsigned long long hash )
+{
+
+    // Finalize the hash
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    // Success
+    return hash;
+}
+
+int set_rwlock_read_lock ( set_rwlock *const p_rwlock )
+{
+
+    // Argument check
+    if ( p_rwlock == (void *) 0 ) goto no_rwlock;
+
+    // Share the lock
+    #ifdef _WIN64
+        AcquireSRWLockShared((PSRWLOCK) p_rwlock);
+    #else
+        if ( pthread_rwlock_rdlock(p_rwlock) ) return 0;
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_rwlock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_rwlock\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_rwlock_read_unlock ( set_rwlock *const p_rwlock )
+{
+
+    // Argument check
+    if ( p_rwlock == (void *) 0 ) goto no_rwlock;
+
+    // Leave the lock
+    #ifdef _WIN64
+        ReleaseSRWLockShared((PSRWLOCK) p_rwlock);
+    #else
+        if ( pthread_rwlock_unlock(p_rwlock) ) return 0;
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_rwlock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_rwlock\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_rwlock_write_lock ( set_rwlock *const p_rwlock )
+{
+
+    // Argument check
+    if ( p_rwlock == (void *) 0 ) goto no_rwlock;
+
+    // Own the lock
+    #ifdef _WIN64
+        AcquireSRWLockExclusive((PSRWLOCK) p_rwlock);
+    #else
+        if ( pthread_rwlock_wrlock(p_rwlock) ) return 0;
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_rwlock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_rwlock\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_rwlock_write_unlock ( set_rwlock *const p_rwlock )
+{
+
+    // Argument check
+    if ( p_rwlock == (void *) 0 ) goto no_rwlock;
+
+    // Release the lock
+    #ifdef _WIN64
+        ReleaseSRWLockExclusive((PSRWLOCK) p_rwlock);
+    #else
+        if ( pthread_rwlock_unlock(p_rwlock) ) return 0;
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_rwlock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_rwlock\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_rwlock_destroy ( set_rwlock *const p_rwlock )
+{
+
+    // Argument check
+    if ( p_rwlock == (void *) 0 ) goto no_rwlock;
+
+    // Destroy the lock. Slim reader/writer locks hold no resources
+    #ifdef _WIN64
+        (void)p_rwlock;
+    #else
+        if ( pthread_rwlock_destroy(p_rwlock) ) return 0;
+    #endif
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_rwlock:
+                #ifndef NDEBUG
+                    printf("[set] [parallel] Null pointer provided for parameter \"p_rwlock\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,2095 @@
+/** !
+ * Roaring bitmap of 32 bit integers
+ *
+ * @file roaring.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/roaring.h>
+
+// Preprocessor definitions
+#define ROARING_ARRAY  0
+#define ROARING_BITMAP 1
+#define ROARING_RUN    2
+
+// Array containers with more integers than this are stored as bitmaps
+#define ROARING_ARRAY_MAX 4096
+
+// A bitmap container covers 65536 integers with 1024 words
+#define ROARING_WORDS 1024
+
+// Run containers with more runs than this are larger than a bitmap
+#define ROARING_RUN_MAX 2048
+
+// How two containers are combined
+#define ROARING_OR     0
+#define ROARING_AND    1
+#define ROARING_ANDNOT 2
+#define ROARING_XOR    3
+
+// Forward declarations
+struct roaring_run_s;
+struct roaring_container_s;
+
+// Type definitions
+typedef struct roaring_run_s       roaring_run;
+typedef struct roaring_container_s roaring_container;
+
+// Structure definitions
+// A run covers [ start, start + length ]
+struct roaring_run_s
+{
+    uint16_t start,
+             length;
+};
+
+// The low 16 bits of each integer in one chunk of 65536 integers
+struct roaring_container_s
+{
+    uint16_t key;
+    uint8_t  type;
+    uint32_t cardinality;
+
+    // Only used by array and run containers. Quantity of array entries,
+    // or quantity of runs, and capacity of the allocation
+    uint32_t quantity,
+             max;
+
+    union
+    {
+        void        *p_data;
+        uint16_t    *p_array;
+        uint64_t    *p_bitmap;
+        roaring_run *p_runs;
+    };
+};
+
+struct roaring_s
+{
+    roaring_container *p_containers;
+    size_t             count;
+    size_t             max;
+    size_t             cardinality;
+};
+
+/** !
+ * Set a range of bits in a bitmap
+ *
+ * @param p_words the bitmap
+ * @param start   the first bit
+ * @param end     the last bit
+ *
+ * @return void
+ */
+static void roaring_words_set_range ( uint64_t *const p_words, uint32_t start, uint32_t end )
+{
+
+    // Initialized data
+    size_t   first      = start >> 6,
+             last       = end   >> 6;
+    uint64_t first_mask = ~0ULL << ( start & 63 ),
+             last_mask  = ~0ULL >> ( 63 - ( end & 63 ) );
+
+    // The range is in one word
+    if ( first == last ) { p_words[first] |= first_mask & last_mask; return; }
+
+    // Fill the words of the range
+    p_words[first] |= first_mask;
+    for (size_t i = first + 1; i < last; i++) p_words[i] = ~0ULL;
+    p_words[last] |= last_mask;
+
+    // Done
+    return;
+}
+
+/** !
+ * Count the runs of set bits in a bitmap
+ *
+ * @param p_words the bitmap
+ *
+ * @return the quantity of runs
+ */
+static size_t roaring_words_runs ( const uint64_t *const p_words )
+{
+
+    // Initialized data
+    size_t   runs  = 0;
+    uint64_t carry = 0;
+
+    // Count the bits that start a run
+    for (size_t i = 0; i < ROARING_WORDS; i++)
+    {
+        runs  += (size_t) __builtin_popcountll(p_words[i] & ~( ( p_words[i] << 1 ) | carry ));
+        carry  = p_words[i] >> 63;
+    }
+
+    // Done
+    return runs;
+}
+
+/** !
+ * Search a sorted array for an integer
+ *
+ * @param p_array  the array
+ * @param quantity the quantity of integers in the array
+ * @param value    the integer
+ * @param p_found  return true IF the integer is in the array ELSE false
+ *
+ * @return the index of the integer, or the index it would be inserted at
+ */
+static size_t roaring_array_search ( const uint16_t *const p_array, size_t quantity, uint16_t value, bool *const p_found )
+{
+
+    // Initialized data
+    size_t lo = 0,
+           hi = quantity;
+
+    // Binary search
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        // Narrow the range
+        if ( p_array[mid] < value ) lo = mid + 1;
+        else                        hi = mid;
+    }
+
+    // Return the result to the caller
+    *p_found = ( lo < quantity && p_array[lo] == value );
+
+    // Done
+    return lo;
+}
+
+/** !
+ * Search a sorted list of runs for an integer
+ *
+ * @param p_runs   the runs
+ * @param quantity the quantity of runs
+ * @param value    the integer
+ *
+ * @return the quantity of runs that start at or before the integer
+ */
+static size_t roaring_run_search ( const roaring_run *const p_runs, size_t quantity, uint16_t value )
+{
+
+    // Initialized data
+    size_t lo = 0,
+           hi = quantity;
+
+    // Binary search
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        // Narrow the range
+        if ( p_runs[mid].start <= value ) lo = mid + 1;
+        else                              hi = mid;
+    }
+
+    // Done
+    return lo;
+}
+
+/** !
+ * Set the bits of a bitmap for each integer in a container
+ *
+ * @param p_container the container
+ * @param p_words     the bitmap
+ *
+ * @return void
+ */
+static void roaring_container_words ( const roaring_container *const p_container, uint64_t *const p_words )
+{
+
+    // Array
+    if ( p_container->type == ROARING_ARRAY )
+        for (size_t i = 0; i < p_container->quantity; i++)
+            p_words[p_container->p_array[i] >> 6] |= 1ULL << ( p_container->p_array[i] & 63 );
+
+    // Bitmap
+    else if ( p_container->type == ROARING_BITMAP )
+        for (size_t i = 0; i < ROARING_WORDS; i++)
+            p_words[i] |= p_container->p_bitmap[i];
+
+    // Run
+    else
+        for (size_t i = 0; i < p_container->quantity; i++)
+            roaring_words_set_range(p_words, p_container->p_runs[i].start, (uint32_t) p_container->p_runs[i].start + p_container->p_runs[i].length);
+
+    // Done
+    return;
+}
+
+/** !
+ * Construct the smallest container for the integers in a bitmap
+ *
+ * @param p_container return
+ * @param key         the high 16 bits of each integer
+ * @param p_words     the bitmap
+ * @param cardinality the quantity of set bits in the bitmap
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_container_from_words ( roaring_container *const p_container, uint16_t key, const uint64_t *const p_words, uint32_t cardinality )
+{
+
+    // Initialized data
+    size_t runs         = roaring_words_runs(p_words),
+           array_bytes  = ( cardinality <= ROARING_ARRAY_MAX ) ? cardinality * sizeof(uint16_t) : SIZE_MAX,
+           run_bytes    = runs * sizeof(roaring_run),
+           bitmap_bytes = ROARING_WORDS * sizeof(uint64_t);
+
+    // Store the key and the cardinality
+    *p_container = (roaring_container)
+    {
+        .key         = key,
+        .cardinality = cardinality
+    };
+
+    // Empty
+    if ( cardinality == 0 ) return 1;
+
+    // Run
+    if ( run_bytes < array_bytes && run_bytes < bitmap_bytes )
+    {
+
+        // Initialized data
+        size_t   i = 0,
+                 k = 0;
+        uint64_t w = p_words[0];
+
+        // Allocate the runs
+        p_container->p_runs = SET_REALLOC(0, run_bytes);
+
+        // Error check
+        if ( p_container->p_runs == (void *) 0 ) goto no_mem;
+
+        // Walk the runs
+        for (;;)
+        {
+
+            // Initialized data
+            uint32_t start = 0,
+                     end   = 0;
+
+            // Find the next set bit
+            while ( w == 0 && i + 1 < ROARING_WORDS ) w = p_words[++i];
+
+            // No more runs
+            if ( w == 0 ) break;
+
+            // The run starts at the lowest set bit
+            start = (uint32_t) ( i * 64 + (size_t) __builtin_ctzll(w) );
+
+            // Fill the bits below the run, then find the end of the run
+            w |= w - 1;
+            while ( w == ~0ULL && i + 1 < ROARING_WORDS ) w = p_words[++i];
+
+            // The run ends at the last bit, or before the lowest clear bit
+            end = ( w == ~0ULL ) ? 65535 : (uint32_t) ( i * 64 + (size_t) __builtin_ctzll(~w) - 1 );
+
+            // Store the run
+            p_container->p_runs[k++] = (roaring_run) { .start = (uint16_t) start, .length = (uint16_t) ( end - start ) };
+
+            // The last run
+            if ( end == 65535 ) break;
+
+            // Clear the run
+            w &= w + 1;
+        }
+
+        // Store the run quantity
+        p_container->type     = ROARING_RUN,
+        p_container->quantity = (uint32_t) k,
+        p_container->max      = (uint32_t) k;
+    }
+
+    // Array
+    else if ( array_bytes <= bitmap_bytes )
+    {
+
+        // Initialized data
+        size_t k = 0;
+
+        // Allocate the array
+        p_container->p_array = SET_REALLOC(0, array_bytes);
+
+        // Error check
+        if ( p_container->p_array == (void *) 0 ) goto no_mem;
+
+        // Store the index of each set bit
+        for (size_t i = 0; i < ROARING_WORDS; i++)
+            for (uint64_t w = p_words[i]; w; w &= w - 1)
+                p_container->p_array[k++] = (uint16_t) ( i * 64 + (size_t) __builtin_ctzll(w) );
+
+        // Store the array quantity
+        p_container->type     = ROARING_ARRAY,
+        p_container->quantity = cardinality,
+        p_container->max      = cardinality;
+    }
+
+    // Bitmap
+    else
+    {
+
+        // Allocate the bitmap
+        p_container->p_bitmap = SET_REALLOC(0, bitmap_bytes);
+
+        // Error check
+        if ( p_container->p_bitmap == (void *) 0 ) goto no_mem;
+
+        // Copy the bitmap
+        memcpy(p_container->p_bitmap, p_words, bitmap_bytes);
+
+        // Store the type
+        p_container->type = ROARING_BITMAP;
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Convert a container to its smallest representation
+ *
+ * @param p_container the container
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_container_pack ( roaring_container *const p_container )
+{
+
+    // Initialized data
+    uint64_t          words[ROARING_WORDS] = { 0 };
+    roaring_container packed               = { 0 };
+
+    // Expand the container
+    roaring_container_words(p_container, words);
+
+    // Construct the smallest container
+    if ( roaring_container_from_words(&packed, p_container->key, words, p_container->cardinality) == 0 ) goto failed_to_pack;
+
+    // Replace the container
+    SET_FREE(p_container->p_data);
+    *p_container = packed;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Roaring errors
+        {
+            failed_to_pack:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to pack container in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Make room for more entries in an array or run container
+ *
+ * @param p_container the container
+ * @param quantity    the quantity of entries
+ * @param size        the size of each entry
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_container_reserve ( roaring_container *const p_container, uint32_t quantity, size_t size )
+{
+
+    // Initialized data
+    uint32_t  max    = ( p_container->max ) ? p_container->max * 2 : 4;
+    void     *p_data = (void *) 0;
+
+    // Fast exit
+    if ( quantity <= p_container->max ) return 1;
+
+    // Grow geometrically
+    if ( max < quantity ) max = quantity;
+
+    // Grow the allocation
+    p_data = SET_REALLOC(p_container->p_data, max * size);
+
+    // Error check
+    if ( p_data == (void *) 0 ) goto no_mem;
+
+    // Store the allocation
+    p_container->p_data = p_data,
+    p_container->max    = max;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Test if a container contains an integer
+ *
+ * @param p_container the container
+ * @param value       the low 16 bits of the integer
+ *
+ * @return true IF the container contains the integer ELSE false
+ */
+static bool roaring_container_contains ( const roaring_container *const p_container, uint16_t value )
+{
+
+    // Array
+    if ( p_container->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        bool found = false;
+
+        // Binary search
+        (void)roaring_array_search(p_container->p_array, p_container->quantity, value, &found);
+
+        // Done
+        return found;
+    }
+
+    // Bitmap
+    if ( p_container->type == ROARING_BITMAP ) return ( p_container->p_bitmap[value >> 6] >> ( value & 63 ) ) & 1;
+
+    // Run
+    {
+
+        // Initialized data
+        size_t i = roaring_run_search(p_container->p_runs, p_container->quantity, value);
+
+        // Done
+        return i && value <= (uint32_t) p_container->p_runs[i - 1].start + p_container->p_runs[i - 1].length;
+    }
+}
+
+/** !
+ * Add an integer to a container
+ *
+ * @param p_container the container
+ * @param value       the low 16 bits of the integer
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_container_add ( roaring_container *const p_container, uint16_t value )
+{
+
+    // Array
+    if ( p_container->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        bool   found = false;
+        size_t i     = roaring_array_search(p_container->p_array, p_container->quantity, value, &found);
+
+        // If the integer is a duplicate, there is nothing to do
+        if ( found ) return 1;
+
+        // A full array becomes a bitmap
+        if ( p_container->cardinality == ROARING_ARRAY_MAX )
+        {
+
+            // Initialized data
+            uint64_t *p_bitmap = SET_CALLOC(ROARING_WORDS, sizeof(uint64_t));
+
+            // Error check
+            if ( p_bitmap == (void *) 0 ) goto no_mem;
+
+            // Convert the array
+            roaring_container_words(p_container, p_bitmap);
+            SET_FREE(p_container->p_data);
+
+            // Store the bitmap
+            p_container->p_bitmap = p_bitmap,
+            p_container->type     = ROARING_BITMAP,
+            p_container->quantity = 0,
+            p_container->max      = 0;
+
+            // Add the integer to the bitmap
+            return roaring_container_add(p_container, value);
+        }
+
+        // Make room for the integer
+        if ( roaring_container_reserve(p_container, p_container->quantity + 1, sizeof(uint16_t)) == 0 ) goto failed_to_reserve;
+        memmove(&p_container->p_array[i + 1], &p_container->p_array[i], ( p_container->quantity - i ) * sizeof(uint16_t));
+
+        // Store the integer
+        p_container->p_array[i] = value;
+        p_container->quantity++,
+        p_container->cardinality++;
+    }
+
+    // Bitmap
+    else if ( p_container->type == ROARING_BITMAP )
+    {
+
+        // Initialized data
+        uint64_t bit = 1ULL << ( value & 63 );
+
+        // If the integer is a duplicate, there is nothing to do
+        if ( p_container->p_bitmap[value >> 6] & bit ) return 1;
+
+        // Store the integer
+        p_container->p_bitmap[value >> 6] |= bit;
+        p_container->cardinality++;
+
+        // A full bitmap becomes one run
+        if ( p_container->cardinality == 65536 ) return roaring_container_pack(p_container);
+    }
+
+    // Run
+    else
+    {
+
+        // Initialized data
+        roaring_run *p_runs = p_container->p_runs;
+        size_t       i      = roaring_run_search(p_runs, p_container->quantity, value);
+        bool         before = false,
+                     after  = false;
+
+        // If the integer is in the preceding run, there is nothing to do
+        if ( i && value <= (uint32_t) p_runs[i - 1].start + p_runs[i - 1].length ) return 1;
+
+        // Test if the integer extends the preceding run, or the following run
+        before = ( i                           && (uint32_t) p_runs[i - 1].start + p_runs[i - 1].length + 1 == value );
+        after  = ( i < p_container->quantity   && (uint32_t) value + 1 == p_runs[i].start );
+
+        // Join the neighboring runs
+        if ( before && after )
+        {
+            p_runs[i - 1].length += (uint16_t) ( p_runs[i].length + 2 );
+            memmove(&p_runs[i], &p_runs[i + 1], ( p_container->quantity - i - 1 ) * sizeof(roaring_run));
+            p_container->quantity--;
+        }
+
+        // Extend the preceding run
+        else if ( before ) p_runs[i - 1].length++;
+
+        // Extend the following run
+        else if ( after ) p_runs[i].start--, p_runs[i].length++;
+
+        // Start a new run
+        else
+        {
+
+            // Make room for the run
+            if ( roaring_container_reserve(p_container, p_container->quantity + 1, sizeof(roaring_run)) == 0 ) goto failed_to_reserve;
+            p_runs = p_container->p_runs;
+            memmove(&p_runs[i + 1], &p_runs[i], ( p_container->quantity - i ) * sizeof(roaring_run));
+
+            // Store the run
+            p_runs[i] = (roaring_run) { .start = value, .length = 0 };
+            p_container->quantity++;
+        }
+
+        // Increment the cardinality
+        p_container->cardinality++;
+
+        // Too many runs are larger than a bitmap
+        if ( p_container->quantity > ROARING_RUN_MAX ) return roaring_container_pack(p_container);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Roaring errors
+        {
+            failed_to_reserve:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to grow container in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Remove an integer from a container
+ *
+ * @param p_container the container
+ * @param value       the low 16 bits of the integer
+ *
+ * @return 1 on success, 0 IF the integer is not in the container
+ */
+static int roaring_container_remove ( roaring_container *const p_container, uint16_t value )
+{
+
+    // Array
+    if ( p_container->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        bool   found = false;
+        size_t i     = roaring_array_search(p_container->p_array, p_container->quantity, value, &found);
+
+        // The integer is not in the container
+        if ( found == false ) return 0;
+
+        // Remove the integer
+        memmove(&p_container->p_array[i], &p_container->p_array[i + 1], ( p_container->quantity - i - 1 ) * sizeof(uint16_t));
+        p_container->quantity--,
+        p_container->cardinality--;
+    }
+
+    // Bitmap
+    else if ( p_container->type == ROARING_BITMAP )
+    {
+
+        // Initialized data
+        uint64_t bit = 1ULL << ( value & 63 );
+
+        // The integer is not in the container
+        if ( ( p_container->p_bitmap[value >> 6] & bit ) == 0 ) return 0;
+
+        // Remove the integer
+        p_container->p_bitmap[value >> 6] &= ~bit;
+        p_container->cardinality--;
+
+        // A sparse bitmap becomes an array, or runs
+        if ( p_container->cardinality == ROARING_ARRAY_MAX ) (void)roaring_container_pack(p_container);
+    }
+
+    // Run
+    else
+    {
+
+        // Initialized data
+        roaring_run *p_runs = p_container->p_runs;
+        size_t       i      = roaring_run_search(p_runs, p_container->quantity, value);
+        uint32_t     start  = 0,
+                     end    = 0;
+
+        // The integer is not in the container
+        if ( i == 0 || value > (uint32_t) p_runs[i - 1].start + p_runs[i - 1].length ) return 0;
+
+        // Initialized data
+        i--;
+        start = p_runs[i].start,
+        end   = start + p_runs[i].length;
+
+        // Remove a run of one
+        if ( start == end )
+        {
+            memmove(&p_runs[i], &p_runs[i + 1], ( p_container->quantity - i - 1 ) * sizeof(roaring_run));
+            p_container->quantity--;
+        }
+
+        // Shrink the run from the start
+        else if ( value == start ) p_runs[i].start++, p_runs[i].length--;
+
+        // Shrink the run from the end
+        else if ( value == end ) p_runs[i].length--;
+
+        // Split the run
+        else
+        {
+
+            // Make room for the run
+            if ( roaring_container_reserve(p_container, p_container->quantity + 1, sizeof(roaring_run)) == 0 ) goto failed_to_reserve;
+            p_runs = p_container->p_runs;
+            memmove(&p_runs[i + 2], &p_runs[i + 1], ( p_container->quantity - i - 1 ) * sizeof(roaring_run));
+
+            // Store both halves
+            p_runs[i]     = (roaring_run) { .start = (uint16_t) start,       .length = (uint16_t) ( value - start - 1 ) };
+            p_runs[i + 1] = (roaring_run) { .start = (uint16_t) ( value + 1 ), .length = (uint16_t) ( end - value - 1 ) };
+            p_container->quantity++;
+
+            // Decrement the cardinality
+            p_container->cardinality--;
+
+            // Too many runs are larger than a bitmap
+            if ( p_container->quantity > ROARING_RUN_MAX ) (void)roaring_container_pack(p_container);
+
+            // Success
+            return 1;
+        }
+
+        // Decrement the cardinality
+        p_container->cardinality--;
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Roaring errors
+        {
+            failed_to_reserve:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to grow container in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Get the greatest integer in a non empty container
+ *
+ * @param p_container the container
+ *
+ * @return the low 16 bits of the greatest integer
+ */
+static uint16_t roaring_container_last ( const roaring_container *const p_container )
+{
+
+    // Array
+    if ( p_container->type == ROARING_ARRAY ) return p_container->p_array[p_container->quantity - 1];
+
+    // Run
+    if ( p_container->type == ROARING_RUN ) return (uint16_t) ( p_container->p_runs[p_container->quantity - 1].start + p_container->p_runs[p_container->quantity - 1].length );
+
+    // Bitmap
+    for (size_t i = ROARING_WORDS; i-- > 0;)
+        if ( p_container->p_bitmap[i] ) return (uint16_t) ( i * 64 + 63 - (size_t) __builtin_clzll(p_container->p_bitmap[i]) );
+
+    // Unreachable
+    return 0;
+}
+
+/** !
+ * Copy a container
+ *
+ * @param p_container return
+ * @param p_source    the container to copy
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_container_copy ( roaring_container *const p_container, const roaring_container *const p_source )
+{
+
+    // Initialized data
+    size_t size = ( p_source->type == ROARING_ARRAY  ) ? p_source->quantity * sizeof(uint16_t)    :
+                  ( p_source->type == ROARING_RUN    ) ? p_source->quantity * sizeof(roaring_run) :
+                                                         ROARING_WORDS * sizeof(uint64_t);
+
+    // Copy the container
+    *p_container        = *p_source;
+    p_container->max    = p_source->quantity;
+    p_container->p_data = (void *) 0;
+
+    // Empty
+    if ( size == 0 ) return 1;
+
+    // Allocate the copy
+    p_container->p_data = SET_REALLOC(0, size);
+
+    // Error check
+    if ( p_container->p_data == (void *) 0 ) goto no_mem;
+
+    // Copy the integers
+    memcpy(p_container->p_data, p_source->p_data, size);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Combine two containers with the same key
+ *
+ * @param p_container return
+ * @param p_a         container A
+ * @param p_b         container B
+ * @param op          one of ROARING_OR, ROARING_AND, ROARING_ANDNOT, ROARING_XOR
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_container_combine ( roaring_container *const p_container, const roaring_container *const p_a, const roaring_container *const p_b, int op )
+{
+
+    // Initialized data
+    uint64_t words_a[ROARING_WORDS],
+             words_b[ROARING_WORDS];
+
+    // Two arrays are merged
+    if ( p_a->type == ROARING_ARRAY && p_b->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        uint16_t merged[2 * ROARING_ARRAY_MAX];
+        size_t   i = 0,
+                 j = 0,
+                 k = 0;
+
+        // Merge
+        while ( i < p_a->quantity && j < p_b->quantity )
+        {
+
+            // Initialized data
+            uint16_t a = p_a->p_array[i],
+                     b = p_b->p_array[j];
+
+            // Only in A
+            if      ( a < b ) { if ( op != ROARING_AND ) merged[k++] = a; i++; }
+
+            // Only in B
+            else if ( b < a ) { if ( op == ROARING_OR || op == ROARING_XOR ) merged[k++] = b; j++; }
+
+            // In both
+            else              { if ( op == ROARING_OR || op == ROARING_AND ) merged[k++] = a; i++, j++; }
+        }
+
+        // Copy the rest of A
+        if ( op != ROARING_AND )
+            while ( i < p_a->quantity ) merged[k++] = p_a->p_array[i++];
+
+        // Copy the rest of B
+        if ( op == ROARING_OR || op == ROARING_XOR )
+            while ( j < p_b->quantity ) merged[k++] = p_b->p_array[j++];
+
+        // Small results stay arrays
+        if ( k <= ROARING_ARRAY_MAX )
+        {
+
+            // Store the key and the cardinality
+            *p_container = (roaring_container) { .key = p_a->key, .type = ROARING_ARRAY, .cardinality = (uint32_t) k };
+
+            // Empty
+            if ( k == 0 ) return 1;
+
+            // Allocate the array
+            p_container->p_array = SET_REALLOC(0, k * sizeof(uint16_t));
+
+            // Error check
+            if ( p_container->p_array == (void *) 0 ) goto no_mem;
+
+            // Copy the integers
+            memcpy(p_container->p_array, merged, k * sizeof(uint16_t));
+            p_container->quantity = (uint32_t) k,
+            p_container->max      = (uint32_t) k;
+
+            // Success
+            return 1;
+        }
+
+        // Large results become bitmaps
+        memset(words_a, 0, sizeof(words_a));
+        for (size_t l = 0; l < k; l++) words_a[merged[l] >> 6] |= 1ULL << ( merged[l] & 63 );
+
+        // Done
+        return roaring_container_from_words(p_container, p_a->key, words_a, (uint32_t) k);
+    }
+
+    // Intersections and differences with an array only test the integers of the array
+    if ( ( p_a->type == ROARING_ARRAY && op != ROARING_OR && op != ROARING_XOR ) || ( p_b->type == ROARING_ARRAY && op == ROARING_AND ) )
+    {
+
+        // Initialized data
+        const roaring_container *p_array = ( p_a->type == ROARING_ARRAY ) ? p_a : p_b,
+                                *p_other = ( p_a->type == ROARING_ARRAY ) ? p_b : p_a;
+        bool                     keep    = ( op == ROARING_AND );
+        size_t                   k       = 0;
+
+        // Store the key
+        *p_container = (roaring_container) { .key = p_a->key, .type = ROARING_ARRAY };
+
+        // Empty
+        if ( p_array->quantity == 0 ) return 1;
+
+        // Allocate the array
+        p_container->p_array = SET_REALLOC(0, p_array->quantity * sizeof(uint16_t));
+
+        // Error check
+        if ( p_container->p_array == (void *) 0 ) goto no_mem;
+
+        // Keep the integers that are ( or are not ) in the other container
+        for (size_t i = 0; i < p_array->quantity; i++)
+            if ( roaring_container_contains(p_other, p_array->p_array[i]) == keep )
+                p_container->p_array[k++] = p_array->p_array[i];
+
+        // Store the quantity
+        p_container->cardinality = (uint32_t) k,
+        p_container->quantity    = (uint32_t) k,
+        p_container->max         = (uint32_t) p_array->quantity;
+
+        // Success
+        return 1;
+    }
+
+    // Everything else is combined one word at a time
+    {
+
+        // Initialized data
+        const uint64_t *p_words_a   = words_a,
+                       *p_words_b   = words_b;
+        uint32_t        cardinality = 0;
+
+        // Expand the containers that are not bitmaps
+        if ( p_a->type == ROARING_BITMAP ) p_words_a = p_a->p_bitmap;
+        else memset(words_a, 0, sizeof(words_a)), roaring_container_words(p_a, words_a);
+        if ( p_b->type == ROARING_BITMAP ) p_words_b = p_b->p_bitmap;
+        else memset(words_b, 0, sizeof(words_b)), roaring_container_words(p_b, words_b);
+
+        // Combine
+        switch ( op )
+        {
+            case ROARING_OR:
+                for (size_t i = 0; i < ROARING_WORDS; i++) words_a[i] = p_words_a[i] | p_words_b[i];
+                break;
+
+            case ROARING_AND:
+                for (size_t i = 0; i < ROARING_WORDS; i++) words_a[i] = p_words_a[i] & p_words_b[i];
+                break;
+
+            case ROARING_ANDNOT:
+                for (size_t i = 0; i < ROARING_WORDS; i++) words_a[i] = p_words_a[i] & ~p_words_b[i];
+                break;
+
+            default:
+                for (size_t i = 0; i < ROARING_WORDS; i++) words_a[i] = p_words_a[i] ^ p_words_b[i];
+                break;
+        }
+
+        // Count
+        for (size_t i = 0; i < ROARING_WORDS; i++) cardinality += (uint32_t) __builtin_popcountll(words_a[i]);
+
+        // Done
+        return roaring_container_from_words(p_container, p_a->key, words_a, cardinality);
+    }
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Test if two containers with the same key have an integer in common
+ *
+ * @param p_a container A
+ * @param p_b container B
+ *
+ * @return true IF the containers intersect ELSE false
+ */
+static bool roaring_container_intersects ( const roaring_container *const p_a, const roaring_container *const p_b )
+{
+
+    // Two arrays are merged
+    if ( p_a->type == ROARING_ARRAY && p_b->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        size_t i = 0,
+               j = 0;
+
+        // Merge, stopping at the first common integer
+        while ( i < p_a->quantity && j < p_b->quantity )
+        {
+            if      ( p_a->p_array[i] < p_b->p_array[j] ) i++;
+            else if ( p_b->p_array[j] < p_a->p_array[i] ) j++;
+            else                                          return true;
+        }
+
+        // No common integers
+        return false;
+    }
+
+    // Look up each integer of an array in the other container
+    if ( p_a->type == ROARING_ARRAY || p_b->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        const roaring_container *p_array = ( p_a->type == ROARING_ARRAY ) ? p_a : p_b,
+                                *p_other = ( p_a->type == ROARING_ARRAY ) ? p_b : p_a;
+
+        // Iterate over each integer of the array
+        for (size_t i = 0; i < p_array->quantity; i++)
+            if ( roaring_container_contains(p_other, p_array->p_array[i]) ) return true;
+
+        // No common integers
+        return false;
+    }
+
+    // Compare one word at a time
+    {
+
+        // Initialized data
+        uint64_t        words_a[ROARING_WORDS],
+                        words_b[ROARING_WORDS];
+        const uint64_t *p_words_a = words_a,
+                       *p_words_b = words_b;
+
+        // Expand the containers that are not bitmaps
+        if ( p_a->type == ROARING_BITMAP ) p_words_a = p_a->p_bitmap;
+        else memset(words_a, 0, sizeof(words_a)), roaring_container_words(p_a, words_a);
+        if ( p_b->type == ROARING_BITMAP ) p_words_b = p_b->p_bitmap;
+        else memset(words_b, 0, sizeof(words_b)), roaring_container_words(p_b, words_b);
+
+        // Compare
+        for (size_t i = 0; i < ROARING_WORDS; i++)
+            if ( p_words_a[i] & p_words_b[i] ) return true;
+
+        // No common integers
+        return false;
+    }
+}
+
+/** !
+ * Count the integers that two containers with the same key have in common
+ *
+ * @param p_a container A
+ * @param p_b container B
+ *
+ * @return the quantity of common integers
+ */
+static uint32_t roaring_container_intersection_count ( const roaring_container *const p_a, const roaring_container *const p_b )
+{
+
+    // Initialized data
+    uint32_t cardinality = 0;
+
+    // Two arrays are merged
+    if ( p_a->type == ROARING_ARRAY && p_b->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        size_t i = 0,
+               j = 0;
+
+        // Merge
+        while ( i < p_a->quantity && j < p_b->quantity )
+        {
+            if      ( p_a->p_array[i] < p_b->p_array[j] ) i++;
+            else if ( p_b->p_array[j] < p_a->p_array[i] ) j++;
+            else                                          cardinality++, i++, j++;
+        }
+
+        // Done
+        return cardinality;
+    }
+
+    // Look up each integer of an array in the other container
+    if ( p_a->type == ROARING_ARRAY || p_b->type == ROARING_ARRAY )
+    {
+
+        // Initialized data
+        const roaring_container *p_array = ( p_a->type == ROARING_ARRAY ) ? p_a : p_b,
+                                *p_other = ( p_a->type == ROARING_ARRAY ) ? p_b : p_a;
+
+        // Iterate over each integer of the array
+        for (size_t i = 0; i < p_array->quantity; i++)
+            cardinality += roaring_container_contains(p_other, p_array->p_array[i]);
+
+        // Done
+        return cardinality;
+    }
+
+    // Count one word at a time
+    {
+
+        // Initialized data
+        uint64_t        words_a[ROARING_WORDS],
+                        words_b[ROARING_WORDS];
+        const uint64_t *p_words_a = words_a,
+                       *p_words_b = words_b;
+
+        // Expand the containers that are not bitmaps
+        if ( p_a->type == ROARING_BITMAP ) p_words_a = p_a->p_bitmap;
+        else memset(words_a, 0, sizeof(words_a)), roaring_container_words(p_a, words_a);
+        if ( p_b->type == ROARING_BITMAP ) p_words_b = p_b->p_bitmap;
+        else memset(words_b, 0, sizeof(words_b)), roaring_container_words(p_b, words_b);
+
+        // Count
+        for (size_t i = 0; i < ROARING_WORDS; i++)
+            cardinality += (uint32_t) __builtin_popcountll(p_words_a[i] & p_words_b[i]);
+
+        // Done
+        return cardinality;
+    }
+}
+
+/** !
+ * Search a roaring bitmap for the container of a key
+ *
+ * @param p_roaring the roaring bitmap
+ * @param key       the high 16 bits of an integer
+ * @param p_found   return true IF the container exists ELSE false
+ *
+ * @return the index of the container, or the index it would be inserted at
+ */
+static size_t roaring_find ( const roaring *const p_roaring, uint16_t key, bool *const p_found )
+{
+
+    // Initialized data
+    size_t lo = 0,
+           hi = p_roaring->count;
+
+    // Fast path for ascending insertion
+    if ( hi && p_roaring->p_containers[hi - 1].key <= key ) lo = hi - 1;
+
+    // Binary search
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        // Narrow the range
+        if ( p_roaring->p_containers[mid].key < key ) lo = mid + 1;
+        else                                          hi = mid;
+    }
+
+    // Return the result to the caller
+    *p_found = ( lo < p_roaring->count && p_roaring->p_containers[lo].key == key );
+
+    // Done
+    return lo;
+}
+
+/** !
+ * Make room for more containers in a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ * @param quantity  the quantity of containers
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_reserve ( roaring *const p_roaring, size_t quantity )
+{
+
+    // Initialized data
+    size_t             max          = ( p_roaring->max ) ? p_roaring->max * 2 : 4;
+    roaring_container *p_containers = (void *) 0;
+
+    // Fast exit
+    if ( quantity <= p_roaring->max ) return 1;
+
+    // Grow geometrically
+    if ( max < quantity ) max = quantity;
+
+    // Grow the containers
+    p_containers = SET_REALLOC(p_roaring->p_containers, max * sizeof(roaring_container));
+
+    // Error check
+    if ( p_containers == (void *) 0 ) goto no_mem;
+
+    // Store the containers
+    p_roaring->p_containers = p_containers,
+    p_roaring->max          = max;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Remove a container from a roaring bitmap
+ *
+ * @param p_roaring the roaring bitmap
+ * @param i         the index of the container
+ *
+ * @return void
+ */
+static void roaring_erase ( roaring *const p_roaring, size_t i )
+{
+
+    // Free the container
+    SET_FREE(p_roaring->p_containers[i].p_data);
+
+    // Close the gap
+    memmove(&p_roaring->p_containers[i], &p_roaring->p_containers[i + 1], ( p_roaring->count - i - 1 ) * sizeof(roaring_container));
+    p_roaring->count--;
+
+    // Done
+    return;
+}
+
+/** !
+ * Combine two roaring bitmaps, one container at a time
+ *
+ * @param pp_roaring return
+ * @param p_a        roaring bitmap A
+ * @param p_b        roaring bitmap B
+ * @param op         one of ROARING_OR, ROARING_AND, ROARING_ANDNOT, ROARING_XOR
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_combine ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b, int op )
+{
+
+    // Argument check
+    if ( pp_roaring == (void *) 0 ) goto no_roaring;
+    if ( p_a        == (void *) 0 ) goto no_a;
+    if ( p_b        == (void *) 0 ) goto no_b;
+
+    // Initialized data
+    roaring *p_roaring = (void *) 0;
+    size_t   i         = 0,
+             j         = 0;
+
+    // Construct the result
+    if ( roaring_construct(&p_roaring) == 0 ) goto failed_to_construct_roaring;
+
+    // Make room for every container
+    if ( roaring_reserve(p_roaring, p_a->count + p_b->count) == 0 ) goto failed_to_combine;
+
+    // Merge the containers by key
+    while ( i < p_a->count || j < p_b->count )
+    {
+
+        // Initialized data
+        roaring_container *p_container = &p_roaring->p_containers[p_roaring->count];
+
+        // Only in A
+        if ( j == p_b->count || ( i < p_a->count && p_a->p_containers[i].key < p_b->p_containers[j].key ) )
+        {
+
+            // Intersections skip the container
+            if ( op == ROARING_AND ) { i++; continue; }
+
+            // Copy the container
+            if ( roaring_container_copy(p_container, &p_a->p_containers[i++]) == 0 ) goto failed_to_combine;
+        }
+
+        // Only in B
+        else if ( i == p_a->count || p_b->p_containers[j].key < p_a->p_containers[i].key )
+        {
+
+            // Intersections and differences skip the container
+            if ( op == ROARING_AND || op == ROARING_ANDNOT ) { j++; continue; }
+
+            // Copy the container
+            if ( roaring_container_copy(p_container, &p_b->p_containers[j++]) == 0 ) goto failed_to_combine;
+        }
+
+        // In both
+        else if ( roaring_container_combine(p_container, &p_a->p_containers[i++], &p_b->p_containers[j++], op) == 0 ) goto failed_to_combine;
+
+        // Drop empty containers
+        if ( p_container->cardinality == 0 ) { SET_FREE(p_container->p_data); continue; }
+
+        // Keep the container
+        p_roaring->count++,
+        p_roaring->cardinality += p_container->cardinality;
+    }
+
+    // Return a pointer to the caller
+    *pp_roaring = p_roaring;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_roaring:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"pp_roaring\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Roaring errors
+        {
+            failed_to_construct_roaring:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Call to \"roaring_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_combine:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to combine containers in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                roaring_destroy(&p_roaring);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Combine roaring bitmap B into roaring bitmap A, one container at a 
+ * time. Containers of A are reused, and A grows only to make room for
+ * the containers of B it does not have
+ *
+ * @param p_a roaring bitmap A
+ * @param p_b roaring bitmap B
+ * @param op  one of ROARING_OR, ROARING_AND, ROARING_ANDNOT
+ *
+ * @return 1 on success, 0 on error
+ */
+static int roaring_combine_update ( roaring *const p_a, const roaring *const p_b, int op )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+
+    // Initialized data
+    size_t shift = ( op == ROARING_OR ) ? p_b->count : 0,
+           i     = 0,
+           j     = 0,
+           k     = 0,
+           end   = 0;
+
+    // A bitmap combined with itself is unchanged, or empty
+    if ( p_a == p_b )
+    {
+
+        // Union and intersection
+        if ( op != ROARING_ANDNOT ) return 1;
+
+        // Difference
+        for (size_t n = 0; n < p_a->count; n++) SET_FREE(p_a->p_containers[n].p_data);
+        p_a->count = 0, p_a->cardinality = 0;
+
+        // Success
+        return 1;
+    }
+
+    // Make room for every container of B
+    if ( roaring_reserve(p_a, p_a->count + shift) == 0 ) goto failed_to_reserve;
+
+    // Move the containers of A past the containers of B. The merge writes 
+    // from the front, and never passes the next container of A it reads
+    memmove(&p_a->p_containers[shift], &p_a->p_containers[0], p_a->count * sizeof(roaring_container));
+    i   = shift,
+    end = shift + p_a->count;
+
+    // Merge the containers by key
+    while ( i < end || j < p_b->count )
+    {
+
+        // Initialized data
+        roaring_container container = { 0 };
+
+        // Only in A
+        if ( j == p_b->count || ( i < end && p_a->p_containers[i].key < p_b->p_containers[j].key ) )
+        {
+
+            // Intersections drop the container
+            if ( op == ROARING_AND ) { SET_FREE(p_a->p_containers[i++].p_data); continue; }
+
+            // Keep the container
+            p_a->p_containers[k++] = p_a->p_containers[i++];
+
+            // Next
+            continue;
+        }
+
+        // Only in B
+        if ( i == end || p_b->p_containers[j].key < p_a->p_containers[i].key )
+        {
+
+            // Intersections and differences skip the container
+            if ( op != ROARING_OR ) { j++; continue; }
+
+            // Copy the container
+            if ( roaring_container_copy(&container, &p_b->p_containers[j]) == 0 ) goto failed_to_combine;
+            j++;
+        }
+
+        // In both
+        else
+        {
+
+            // Combine the containers
+            if ( roaring_container_combine(&container, &p_a->p_containers[i], &p_b->p_containers[j], op) == 0 ) goto failed_to_combine;
+
+            // Free the old container
+            SET_FREE(p_a->p_containers[i].p_data);
+            i++, j++;
+        }
+
+        // Drop empty containers
+        if ( container.cardinality == 0 ) { SET_FREE(container.p_data); continue; }
+
+        // Keep the container
+        p_a->p_containers[k++] = container;
+    }
+
+    // Store the quantity of containers
+    p_a->count = k;
+
+    // Count the integers
+    p_a->cardinality = 0;
+    for (size_t n = 0; n < p_a->count; n++) p_a->cardinality += p_a->p_containers[n].cardinality;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Roaring errors
+        {
+            failed_to_reserve:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to make room for containers in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_combine:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to combine containers in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Keep the containers of A that were not merged
+                memmove(&p_a->p_containers[k], &p_a->p_containers[i], ( end - i ) * sizeof(roaring_container));
+                p_a->count = k + ( end - i );
+
+                // Count the integers
+                p_a->cardinality = 0;
+                for (size_t n = 0; n < p_a->count; n++) p_a->cardinality += p_a->p_containers[n].cardinality;
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int roaring_construct ( roaring **const pp_roaring )
+{
+
+    // Argument check
+    if ( pp_roaring == (void *) 0 ) goto no_roaring;
+
+    // Initialized data
+    roaring *p_roaring = SET_REALLOC(0, sizeof(roaring));
+
+    // Error check
+    if ( p_roaring == (void *) 0 ) goto no_mem;
+
+    // Initialize the roaring bitmap
+    *p_roaring = (roaring) { 0 };
+
+    // Return a pointer to the caller
+    *pp_roaring = p_roaring;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_roaring:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"pp_roaring\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int roaring_union ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine(pp_roaring, p_a, p_b, ROARING_OR);
+}
+
+int roaring_difference ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine(pp_roaring, p_a, p_b, ROARING_ANDNOT);
+}
+
+int roaring_intersection ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine(pp_roaring, p_a, p_b, ROARING_AND);
+}
+
+int roaring_symmetric_difference ( roaring **const pp_roaring, const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine(pp_roaring, p_a, p_b, ROARING_XOR);
+}
+
+int roaring_union_update ( roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine_update(p_a, p_b, ROARING_OR);
+}
+
+int roaring_difference_update ( roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine_update(p_a, p_b, ROARING_ANDNOT);
+}
+
+int roaring_intersection_update ( roaring *const p_a, const roaring *const p_b )
+{
+
+    // Done
+    return roaring_combine_update(p_a, p_b, ROARING_AND);
+}
+
+bool roaring_contains ( const roaring *const p_roaring, uint32_t value )
+{
+
+    // Argument check
+    if ( p_roaring == (void *) 0 ) return false;
+
+    // Initialized data
+    bool   found = false;
+    size_t i     = roaring_find(p_roaring, (uint16_t) ( value >> 16 ), &found);
+
+    // Done
+    return found && roaring_container_contains(&p_roaring->p_containers[i], (uint16_t) value);
+}
+
+bool roaring_isdisjoint ( const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return true;
+    if ( p_b == (void *) 0 ) return true;
+
+    // Initialized data
+    size_t i = 0,
+           j = 0;
+
+    // Merge the containers by key, stopping at the first common integer
+    while ( i < p_a->count && j < p_b->count )
+    {
+
+        // Initialized data
+        uint16_t a = p_a->p_containers[i].key,
+                 b = p_b->p_containers[j].key;
+
+        // Advance the lesser key
+        if      ( a < b ) i++;
+        else if ( b < a ) j++;
+
+        // Common integer
+        else if ( roaring_container_intersects(&p_a->p_containers[i++], &p_b->p_containers[j++]) ) return false;
+    }
+
+    // No common integers
+    return true;
+}
+
+bool roaring_issubset ( const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return true;
+    if ( p_b == (void *) 0 ) return p_a->cardinality == 0;
+
+    // A larger bitmap is never a subset
+    if ( p_a->cardinality > p_b->cardinality ) return false;
+
+    // Iterate over each container of A, stopping at the first one that is not covered
+    for (size_t i = 0; i < p_a->count; i++)
+    {
+
+        // Initialized data
+        const roaring_container *p_container = &p_a->p_containers[i];
+        bool                     found       = false;
+        size_t                   j           = roaring_find(p_b, p_container->key, &found);
+
+        // B has no container with this key
+        if ( found == false ) return false;
+
+        // A container with more integers is never a subset
+        if ( p_container->cardinality > p_b->p_containers[j].cardinality ) return false;
+
+        // Every integer of the container must be in both
+        if ( roaring_container_intersection_count(p_container, &p_b->p_containers[j]) != p_container->cardinality ) return false;
+    }
+
+    // Every integer of A is in B
+    return true;
+}
+
+size_t roaring_intersection_count ( const roaring *const p_a, const roaring *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return 0;
+    if ( p_b == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t i           = 0,
+           j           = 0,
+           cardinality = 0;
+
+    // Merge the containers by key
+    while ( i < p_a->count && j < p_b->count )
+    {
+
+        // Initialized data
+        uint16_t a = p_a->p_containers[i].key,
+                 b = p_b->p_containers[j].key;
+
+        // Advance the lesser key
+        if      ( a < b ) i++;
+        else if ( b < a ) j++;
+
+        // Count the common integers
+        else cardinality += roaring_container_intersection_count(&p_a->p_containers[i++], &p_b->p_containers[j++]);
+    }
+
+    // Done
+    return cardinality;
+}
+
+size_t roaring_count ( const roaring *const p_roaring )
+{
+
+    // Done
+    return ( p_roaring ) ? p_roaring->cardinality : 0;
+}
+
+size_t roaring_size ( const roaring *const p_roaring )
+{
+
+    // Argument check
+    if ( p_roaring == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t size = sizeof(roaring) + p_roaring->max * sizeof(roaring_container);
+
+    // Add the size of each container
+    for (size_t i = 0; i < p_roaring->count; i++)
+    {
+
+        // Initialized data
+        const roaring_container *p_container = &p_roaring->p_containers[i];
+
+        // Accumulate
+        size += ( p_container->type == ROARING_ARRAY  ) ? p_container->max * sizeof(uint16_t)    :
+                ( p_container->type == ROARING_RUN    ) ? p_container->max * sizeof(roaring_run) :
+                                                          ROARING_WORDS * sizeof(uint64_t);
+    }
+
+    // Done
+    return size;
+}
+
+size_t roaring_contents ( const roaring *const p_roaring, void **const pp_contents )
+{
+
+    // Argument check
+    if ( p_roaring   == (void *) 0 ) return 0;
+    if ( pp_contents == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t k = 0;
+
+    // Iterate over each container
+    for (size_t i = 0; i < p_roaring->count; i++)
+    {
+
+        // Initialized data
+        const roaring_container *p_container = &p_roaring->p_containers[i];
+        uintptr_t                high        = (uintptr_t) p_container->key << 16;
+
+        // Array
+        if ( p_container->type == ROARING_ARRAY )
+            for (size_t j = 0; j < p_container->quantity; j++)
+                pp_contents[k++] = (void *) ( high | p_container->p_array[j] );
+
+        // Bitmap
+        else if ( p_container->type == ROARING_BITMAP )
+            for (size_t j = 0; j < ROARING_WORDS; j++)
+                for (uint64_t w = p_container->p_bitmap[j]; w; w &= w - 1)
+                    pp_contents[k++] = (void *) ( high | ( j * 64 + (size_t) __builtin_ctzll(w) ) );
+
+        // Run
+        else
+            for (size_t j = 0; j < p_container->quantity; j++)
+                for (uint32_t v = p_container->p_runs[j].start; v <= (uint32_t) p_container->p_runs[j].start + p_container->p_runs[j].length; v++)
+                    pp_contents[k++] = (void *) ( high | v );
+    }
+
+    // Done
+    return k;
+}
+
+int roaring_add ( roaring *const p_roaring, uint32_t value )
+{
+
+    // Argument check
+    if ( p_roaring == (void *) 0 ) goto no_roaring;
+
+    // Initialized data
+    bool               found       = false;
+    size_t             i           = roaring_find(p_roaring, (uint16_t) ( value >> 16 ), &found);
+    roaring_container *p_container = (void *) 0;
+    uint32_t           cardinality = 0;
+
+    // Construct a container for the key
+    if ( found == false )
+    {
+
+        // Make room for the container
+        if ( roaring_reserve(p_roaring, p_roaring->count + 1) == 0 ) goto failed_to_reserve;
+        memmove(&p_roaring->p_containers[i + 1], &p_roaring->p_containers[i], ( p_roaring->count - i ) * sizeof(roaring_container));
+        p_roaring->count++;
+
+        // Store an empty array
+        p_roaring->p_containers[i] = (roaring_container) { .key = (uint16_t) ( value >> 16 ), .type = ROARING_ARRAY };
+    }
+
+    // Initialized data
+    p_container = &p_roaring->p_containers[i];
+    cardinality = p_container->cardinality;
+
+    // Add the integer to the container
+    if ( roaring_container_add(p_container, (uint16_t) value) == 0 ) goto failed_to_add;
+
+    // Account for the integer
+    p_roaring->cardinality += p_container->cardinality - cardinality;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_roaring:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"p_roaring\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Roaring errors
+        {
+            failed_to_reserve:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to grow roaring bitmap in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_add:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Failed to add integer in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Drop the container, if it was just constructed
+                if ( p_container->cardinality == 0 ) roaring_erase(p_roaring, i);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int roaring_remove ( roaring *const p_roaring, uint32_t value )
+{
+
+    // Argument check
+    if ( p_roaring == (void *) 0 ) return 0;
+
+    // Initialized data
+    bool   found = false;
+    size_t i     = roaring_find(p_roaring, (uint16_t) ( value >> 16 ), &found);
+
+    // The integer is not in the roaring bitmap
+    if ( found == false ) return 0;
+
+    // Remove the integer from the container
+    if ( roaring_container_remove(&p_roaring->p_containers[i], (uint16_t) value) == 0 ) return 0;
+
+    // Account for the integer
+    p_roaring->cardinality--;
+
+    // Drop empty containers
+    if ( p_roaring->p_containers[i].cardinality == 0 ) roaring_erase(p_roaring, i);
+
+    // Success
+    return 1;
+}
+
+int roaring_pop ( roaring *const p_roaring, uint32_t *const p_value )
+{
+
+    // Argument check
+    if ( p_roaring == (void *) 0 ) return 0;
+    if ( p_value   == (void *) 0 ) return 0;
+
+    // State check
+    if ( p_roaring->count == 0 ) return 0;
+
+    // Initialized data
+    roaring_container *p_container = &p_roaring->p_containers[p_roaring->count - 1];
+    uint32_t           value       = ( (uint32_t) p_container->key << 16 ) | roaring_container_last(p_container);
+
+    // Remove the integer
+    if ( roaring_remove(p_roaring, value) == 0 ) return 0;
+
+    // Return the integer to the caller
+    *p_value = value;
+
+    // Success
+    return 1;
+}
+
+int roaring_foreach_i ( const roaring *const p_roaring, void (*const function)(void *const value, size_t index) )
+{
+
+    // Argument check
+    if ( p_roaring == (void *) 0 ) goto no_roaring;
+    if ( function  == (void *) 0 ) goto no_function;
+
+    // Initialized data
+    size_t k = 0;
+
+    // Iterate over each container
+    for (size_t i = 0; i < p_roaring->count; i++)
+    {
+
+        // Initialized data
+        const roaring_container *p_container = &p_roaring->p_containers[i];
+        uintptr_t                high        = (uintptr_t) p_container->key << 16;
+
+        // Array
+        if ( p_container->type == ROARING_ARRAY )
+            for (size_t j = 0; j < p_container->quantity; j++)
+                function((void *) ( high | p_container->p_array[j] ), k++);
+
+        // Bitmap
+        else if ( p_container->type == ROARING_BITMAP )
+            for (size_t j = 0; j < ROARING_WORDS; j++)
+                for (uint64_t w = p_container->p_bitmap[j]; w; w &= w - 1)
+                    function((void *) ( high | ( j * 64 + (size_t) __builtin_ctzll(w) ) ), k++);
+
+        // Run
+        else
+            for (size_t j = 0; j < p_container->quantity; j++)
+                for (uint32_t v = p_container->p_runs[j].start; v <= (uint32_t) p_container->p_runs[j].start + p_container->p_runs[j].length; v++)
+                    function((void *) ( high | v ), k++);
+    }
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_roaring:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"p_roaring\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int roaring_destroy ( roaring **const pp_roaring )
+{
+
+    // Argument check
+    if ( pp_roaring == (void *) 0 ) goto no_roaring;
+
+    // Initialized data
+    roaring *p_roaring = *pp_roaring;
+
+    // No more roaring bitmap for caller
+    *pp_roaring = (void *) 0;
+
+    // Free each container
+    for (size_t i = 0; i < p_roaring->count; i++) SET_FREE(p_roaring->p_containers[i].p_data);
+
+    // Free the containers
+    SET_FREE(p_roaring->p_containers);
+
+    // Free the roaring bitmap
+    SET_FREE(p_roaring);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_roaring:
+                #ifndef NDEBUG
+                    printf("[set] [roaring] Null pointer provided for parameter \"pp_roaring\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
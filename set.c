@@ -8,63 +8,5814 @@
 
 // Headers
 #include <set/set.h>
+#include <set/kernel.h>
+#include <set/roaring.h>
+#include <set/frozen.h>
+#include <set/hll.h>
+#include <set/minhash.h>
+#include <set/parallel.h>
+
+// Preprocessor definitions
+#define SET_INDEX_EMPTY     0
+#define SET_INDEX_TOMBSTONE SIZE_MAX
+#define SET_INDEX_NOT_FOUND SIZE_MAX
+
+// Which elements a sorted merge keeps
+#define SET_MERGE_A  0x1
+#define SET_MERGE_AB 0x2
+#define SET_MERGE_B  0x4
+
+// The quantity of old index slots to migrate on each add / remove while rehashing
+#ifndef SET_REHASH_STEP
+#define SET_REHASH_STEP 32
+#endif
+
+// Sorted operands whose sizes differ by at least this factor are 
+// intersected by galloping through the larger operand
+#ifndef SET_GALLOP_RATIO
+#define SET_GALLOP_RATIO 32
+#endif
+
+// Sets of at most this many elements store them inside the set, 
+// without a separate allocation
+#ifndef SET_INLINE_MAX
+#define SET_INLINE_MAX 8
+#endif
+
+// Bits of Bloom filter per element, at capacity. About a 1% false positive rate
+#ifndef SET_BLOOM_BITS
+#define SET_BLOOM_BITS 12
+#endif
+
+// Batched adds and lookups hash this many keys up front, and prefetch 
+// the index slots of keys this far ahead of the key being compared
+#ifndef SET_BATCH
+#define SET_BATCH 256
+#endif
+
+#ifndef SET_PREFETCH_DISTANCE
+#define SET_PREFETCH_DISTANCE 8
+#endif
+
+// Parallel set operations give each worker thread at least this many elements
+#ifndef SET_PARALLEL_GRAIN
+#define SET_PARALLEL_GRAIN 16384
+#endif
+
+// Forward declarations
+struct set_index_s;
+struct set_slice_s;
+struct set_build_s;
+
+// Type definitions
+typedef struct set_index_s set_index;
+typedef struct set_slice_s set_slice;
+typedef struct set_build_s set_build;
 
 // Data 
 static bool initialized = false;
 
+// Each Bloom filter block is eight 32 bit words. An element sets one bit 
+// in each word, at the top 5 bits of its key times the word's salt
+static const uint32_t set_bloom_salts[8] = 
+{
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
 // Structure definitions
+// Open addressing index. Each slot holds ( element index + 1 ), 
+// SET_INDEX_EMPTY, or SET_INDEX_TOMBSTONE
+struct set_index_s
+{
+    size_t *p_slots;
+    size_t  max;
+    size_t  used;
+};
+
+// One worker's share of a parallel set operation. The worker combines
+// A [ a_begin, a_end ) with B [ b_begin, b_end ), and writes the result 
+// to its own region of the result's elements array, starting at offset
+struct set_slice_s
+{
+    const set    *p_a,
+                 *p_b;
+    set          *p_result;
+    set_equal_fn *pfn_is_equal;
+    int           keep;
+    size_t        a_begin,
+                  a_end,
+                  b_begin,
+                  b_end,
+                  offset,
+                  count;
+};
+
+// One worker's share of a parallel bulk build. The worker owns elements 
+// [ begin, end ) of the input, and slots [ slot_begin, slot_end ) of the index
+struct set_build_s
+{
+    set                 *p_set;
+    const void *const   *pp_elements;
+    void               **p_scratch;
+    unsigned long long  *p_hashes;
+    size_t              *p_positions;
+    bool                *p_duplicates;
+    size_t               begin,
+                         end,
+                         slot_begin,
+                         slot_end,
+                         offset,
+                         count;
+};
+
 struct set_s
 {
     void         **elements;
     size_t         max;
     size_t         count;
     set_equal_fn  *pfn_is_equal;
-    mutex          _lock;
+    set_hash_fn   *pfn_hash;
+    set_compare_fn *pfn_compare;
+
+    // Only used by hashed sets. While the index is growing, elements 
+    // are incrementally migrated from the old index to the new index
+    set_index      index,
+                   old_index;
+    size_t         rehash_cursor;
+
+    // Only used by roaring sets. Elements are stored in the roaring 
+    // bitmap, and count mirrors its cardinality
+    roaring       *p_roaring;
+
+    // Only used by bitset sets. Bit i is set IF ( void * ) i is in the set
+    uint64_t      *p_bits;
+    size_t         universe;
+
+    // Only used by frozen sets. Elements are stored in the frozen 
+    // sequence, and the set is immutable until it is thawed
+    frozen        *p_frozen;
+
+    // Only used by sets with a Bloom filter. Removed elements stay in 
+    // the filter until it is rebuilt
+    uint32_t      *p_bloom;
+    size_t         bloom_blocks,
+                   bloom_capacity,
+                   bloom_removed;
+
+    // Only used by sets with a cardinality sketch, or a MinHash signature
+    hll           *p_sketch;
+    minhash       *p_minhash;
+
+    set_rwlock     _lock;
+
+    // Small sets point elements here, until they grow past SET_INLINE_MAX
+    void          *inline_elements[SET_INLINE_MAX];
 };
 
-int equals_function ( const void *const a, const void *const b )
-{
-    
-    // Return
-    return !( a == b );
+int equals_function ( const void *const a, const void *const b )
+{
+    
+    // Return
+    return !( a == b );
+}
+
+unsigned long long hash_function ( const void *const k )
+{
+
+    // Return
+    return (unsigned long long) k;
+}
+
+int compare_function ( const void *const a, const void *const b )
+{
+
+    // Return
+    return ( a > b ) - ( a < b );
+}
+
+/** !
+ * Compute the hash of an element
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * 
+ * @return the hash of the element
+ */
+static unsigned long long set_hash ( const set *const p_set, const void *const p_element )
+{
+
+    // Success
+    return set_hash_mix(p_set->pfn_hash(p_element));
+}
+
+/** !
+ * Compute the quantity of index slots for a set of a given size. The 
+ * result is a power of two, and at least twice the size of the set
+ * 
+ * @param size the maximum quantity of elements in the set
+ * 
+ * @return the quantity of index slots
+ */
+static size_t set_index_size ( size_t size )
+{
+
+    // Initialized data
+    size_t result = 8;
+
+    // Double until the load factor is at most one half
+    while ( result < size * 2 ) result <<= 1;
+
+    // Success
+    return result;
+}
+
+/** !
+ * Allocate an empty index
+ * 
+ * @param p_index return
+ * @param max     the quantity of index slots. Must be a power of two
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_index_construct ( set_index *const p_index, size_t max )
+{
+
+    // Allocate zeroed slots. Fresh pages are zeroed lazily by the 
+    // operating system, so this does not touch the whole table
+    p_index->p_slots = SET_CALLOC(max, sizeof(size_t));
+
+    // Error checking
+    if ( p_index->p_slots == (void *) 0 ) goto no_mem;
+
+    // Store the size
+    p_index->max  = max,
+    p_index->used = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Search one index of a hashed set for an element
+ * 
+ * @param p_set     the set
+ * @param p_index   the index
+ * @param p_element the element
+ * @param hash      the mixed hash of the element
+ * @param p_slot    return the slot of the element IF found ELSE the slot to insert the element at
+ * 
+ * @return the index of the element in the elements array IF found ELSE SET_INDEX_NOT_FOUND
+ */
+static size_t set_index_find ( const set *const p_set, const set_index *const p_index, const void *const p_element, unsigned long long hash, size_t *const p_slot )
+{
+
+    // Initialized data
+    size_t mask      = p_index->max - 1,
+           i         = (size_t) hash & mask,
+           tombstone = SET_INDEX_NOT_FOUND;
+
+    // Linear probe
+    for (;;)
+    {
+
+        // Initialized data
+        size_t slot = p_index->p_slots[i];
+
+        // End of the probe sequence
+        if ( slot == SET_INDEX_EMPTY ) break;
+
+        // Remember the first tombstone, so inserts can reuse it
+        if ( slot == SET_INDEX_TOMBSTONE )
+        {
+            if ( tombstone == SET_INDEX_NOT_FOUND ) tombstone = i;
+        }
+
+        // If the element is a match ...
+        else if ( p_set->pfn_is_equal(p_set->elements[slot - 1], p_element) == 0 )
+        {
+
+            // ... return the slot ...
+            if ( p_slot ) *p_slot = i;
+
+            // ... and the index of the element
+            return slot - 1;
+        }
+
+        // Next slot
+        i = ( i + 1 ) & mask;
+    }
+
+    // Return the insertion slot to the caller
+    if ( p_slot ) *p_slot = ( tombstone == SET_INDEX_NOT_FOUND ) ? i : tombstone;
+
+    // Not found
+    return SET_INDEX_NOT_FOUND;
+}
+
+/** !
+ * Find the index slot that refers to a specific position in the elements array
+ * 
+ * @param p_index the index
+ * @param hash    the mixed hash of the element
+ * @param i       the position of the element in the elements array
+ * 
+ * @return the slot IF found ELSE SET_INDEX_NOT_FOUND
+ */
+static size_t set_index_slot_of ( const set_index *const p_index, unsigned long long hash, size_t i )
+{
+
+    // Initialized data
+    size_t mask = p_index->max - 1,
+           j    = (size_t) hash & mask;
+
+    // Linear probe
+    for (;;)
+    {
+
+        // Initialized data
+        size_t slot = p_index->p_slots[j];
+
+        // Found
+        if ( slot == i + 1 ) return j;
+
+        // Not found
+        if ( slot == SET_INDEX_EMPTY ) return SET_INDEX_NOT_FOUND;
+
+        // Next slot
+        j = ( j + 1 ) & mask;
+    }
+}
+
+/** !
+ * Store an element position in an index, without testing for duplicates
+ * 
+ * @param p_index the index
+ * @param hash    the mixed hash of the element
+ * @param i       the position of the element in the elements array
+ * 
+ * @return void
+ */
+static void set_index_insert ( set_index *const p_index, unsigned long long hash, size_t i )
+{
+
+    // Initialized data
+    size_t mask = p_index->max - 1,
+           j    = (size_t) hash & mask;
+
+    // Find an empty or recycled slot
+    while ( p_index->p_slots[j] != SET_INDEX_EMPTY && p_index->p_slots[j] != SET_INDEX_TOMBSTONE ) j = ( j + 1 ) & mask;
+
+    // Account for the slot, unless it is a recycled tombstone
+    if ( p_index->p_slots[j] == SET_INDEX_EMPTY ) p_index->used++;
+
+    // Store the element position
+    p_index->p_slots[j] = i + 1;
+
+    // Done
+    return;
+}
+
+/** !
+ * Migrate slots from the old index of a growing set into the new index
+ * 
+ * @param p_set    the set
+ * @param quantity the maximum quantity of old slots to migrate
+ * 
+ * @return void
+ */
+static void set_index_migrate ( set *const p_set, size_t quantity )
+{
+
+    // State check
+    if ( p_set->old_index.p_slots == (void *) 0 ) return;
+
+    // Initialized data
+    set_index *p_old = &p_set->old_index;
+    size_t     end   = ( p_old->max - p_set->rehash_cursor > quantity ) ? p_set->rehash_cursor + quantity : p_old->max;
+
+    // Iterate over the next slots in the old index
+    for (size_t i = p_set->rehash_cursor; i < end; i++)
+    {
+
+        // Initialized data
+        size_t slot = p_old->p_slots[i];
+
+        // Skip empty slots and tombstones
+        if ( slot == SET_INDEX_EMPTY || slot == SET_INDEX_TOMBSTONE ) continue;
+
+        // Move the element into the new index
+        set_index_insert(&p_set->index, set_hash(p_set, p_set->elements[slot - 1]), slot - 1);
+
+        // Tombstone the old slot, so probe sequences through it stay intact
+        p_old->p_slots[i] = SET_INDEX_TOMBSTONE;
+    }
+
+    // Store the cursor
+    p_set->rehash_cursor = end;
+
+    // If every slot has been migrated ...
+    if ( end == p_old->max )
+    {
+
+        // ... release the old index
+        SET_FREE(p_old->p_slots);
+
+        // Clear the old index
+        memset(p_old, 0, sizeof(set_index));
+    }
+
+    // Done
+    return;
+}
+
+/** !
+ * Start rehashing a hashed set into a new, larger index. The elements
+ * are migrated a few slots at a time by later calls to add and remove,
+ * so no single call pays for the whole rehash
+ * 
+ * @param p_set the set
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_index_grow ( set *const p_set )
+{
+
+    // Initialized data
+    set_index index = { 0 };
+    size_t    max   = set_index_size(2 * ( p_set->count + 1 ));
+
+    // Never shrink. Tombstone heavy indices are rehashed at the same size
+    if ( max < p_set->index.max ) max = p_set->index.max;
+
+    // If a previous rehash is still in flight, finish it
+    set_index_migrate(p_set, SIZE_MAX);
+
+    // Allocate the new index
+    if ( set_index_construct(&index, max) == 0 ) goto failed_to_allocate_index;
+
+    // The current index becomes the old index
+    p_set->old_index     = p_set->index,
+    p_set->index         = index,
+    p_set->rehash_cursor = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_allocate_index:
+                #ifndef NDEBUG
+                    printf("[set] Failed to allocate index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Search the index of a hashed set for an element. While the set is 
+ * rehashing, both the new index and the old index are searched
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * @param hash      the mixed hash of the element
+ * @param pp_index  return the index containing the element IF found ELSE the index to insert into
+ * @param p_slot    return the slot of the element IF found ELSE the slot to insert the element at
+ * 
+ * @return the index of the element in the elements array IF found ELSE SET_INDEX_NOT_FOUND
+ */
+static size_t set_hashed_find ( const set *const p_set, const void *const p_element, unsigned long long hash, set_index **const pp_index, size_t *const p_slot )
+{
+
+    // Initialized data
+    size_t old_slot = 0,
+           result   = set_index_find(p_set, &p_set->index, p_element, hash, p_slot);
+
+    // Return the new index to the caller
+    if ( pp_index ) *pp_index = (set_index *) &p_set->index;
+
+    // Found in the new index
+    if ( result != SET_INDEX_NOT_FOUND ) return result;
+
+    // Not rehashing
+    if ( p_set->old_index.p_slots == (void *) 0 ) return result;
+
+    // Search the old index
+    result = set_index_find(p_set, &p_set->old_index, p_element, hash, &old_slot);
+
+    // If the element is in the old index, return the old index and slot to the caller
+    if ( result != SET_INDEX_NOT_FOUND )
+    {
+        if ( pp_index ) *pp_index = (set_index *) &p_set->old_index;
+        if ( p_slot   ) *p_slot   = old_slot;
+    }
+
+    // Done
+    return result;
+}
+
+/** !
+ * Find the slot that refers to a specific position in the elements array
+ * 
+ * @param p_set    the set
+ * @param i        the position of the element in the elements array
+ * @param pp_index return the index containing the slot
+ * 
+ * @return the slot
+ */
+static size_t set_hashed_slot_of ( const set *const p_set, size_t i, set_index **const pp_index )
+{
+
+    // Initialized data
+    unsigned long long hash   = set_hash(p_set, p_set->elements[i]);
+    size_t             result = set_index_slot_of(&p_set->index, hash, i);
+
+    // Found in the new index
+    if ( result != SET_INDEX_NOT_FOUND )
+    {
+        *pp_index = (set_index *) &p_set->index;
+
+        return result;
+    }
+
+    // The element must be in the old index
+    *pp_index = (set_index *) &p_set->old_index;
+
+    // Done
+    return set_index_slot_of(&p_set->old_index, hash, i);
+}
+
+/** !
+ * Make room for at least some quantity of elements in a set
+ * 
+ * @param p_set the set
+ * @param max   the quantity of elements
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_reserve ( set *const p_set, size_t max )
+{
+
+    // Initialized data
+    bool     is_inline  = p_set->elements == p_set->inline_elements;
+    void   **p_elements = (void *) 0;
+
+    // Fast exit
+    if ( max <= p_set->max ) return 1;
+
+    // Grow the elements array
+    p_elements = SET_REALLOC(( is_inline ) ? (void *) 0 : p_set->elements, max * sizeof(void *));
+
+    // Error checking
+    if ( p_elements == (void *) 0 ) goto no_mem;
+
+    // Spill the inline elements to the heap
+    if ( is_inline ) memcpy(p_elements, p_set->inline_elements, p_set->count * sizeof(void *));
+
+    // Store the elements
+    p_set->elements = p_elements,
+    p_set->max      = max;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Grow the elements array of a set geometrically
+ * 
+ * @param p_set the set
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_grow ( set *const p_set )
+{
+
+    // Done
+    return set_reserve(p_set, ( p_set->max < 4 ) ? 8 : p_set->max * 2);
+}
+
+/** !
+ * Compare two elements of an array by address, for qsort
+ * 
+ * @param a pointer to element A
+ * @param b pointer to element B
+ * 
+ * @return negative IF A < B ELSE positive IF A > B ELSE 0
+ */
+static int set_qsort_compare ( const void *a, const void *b )
+{
+
+    // Done
+    return compare_function(*(void *const *) a, *(void *const *) b);
+}
+
+/** !
+ * Binary search a sorted set for an element
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * @param p_found   return true IF the element is in the set ELSE false
+ * 
+ * @return the position of the first element that is not less than p_element
+ */
+static size_t set_sorted_search ( const set *const p_set, const void *const p_element, bool *const p_found )
+{
+
+    // Initialized data
+    size_t lo = 0,
+           hi = p_set->count;
+
+    // Binary search
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        // Narrow the search
+        if ( p_set->pfn_compare(p_set->elements[mid], p_element) < 0 ) lo = mid + 1;
+        else                                                          hi = mid;
+    }
+
+    // Return the result to the caller
+    *p_found = ( lo < p_set->count && p_set->pfn_compare(p_set->elements[lo], p_element) == 0 );
+
+    // Success
+    return lo;
+}
+
+/** !
+ * Exponential search a sorted set for an element, starting from a known 
+ * lower bound. Costs O(log d), where d is the distance to the result
+ * 
+ * @param p_set     the set
+ * @param lo        position of an element that is not greater than p_element
+ * @param p_element the element
+ * @param p_found   return true IF the element is in the set ELSE false
+ * 
+ * @return the position of the first element that is not less than p_element
+ */
+static size_t set_sorted_gallop ( const set *const p_set, size_t lo, const void *const p_element, bool *const p_found )
+{
+
+    // Initialized data
+    size_t step = 1,
+           hi   = lo;
+
+    // Gallop until an element that is not less than p_element is passed
+    while ( hi < p_set->count && p_set->pfn_compare(p_set->elements[hi], p_element) < 0 )
+    {
+        lo    = hi + 1;
+        hi   += step;
+        step <<= 1;
+    }
+
+    // Clamp the upper bound
+    if ( hi > p_set->count ) hi = p_set->count;
+
+    // Binary search the bracketed range
+    while ( lo < hi )
+    {
+
+        // Initialized data
+        size_t mid = lo + ( hi - lo ) / 2;
+
+        // Narrow the search
+        if ( p_set->pfn_compare(p_set->elements[mid], p_element) < 0 ) lo = mid + 1;
+        else                                                          hi = mid;
+    }
+
+    // Return the result to the caller
+    *p_found = ( lo < p_set->count && p_set->pfn_compare(p_set->elements[lo], p_element) == 0 );
+
+    // Success
+    return lo;
+}
+
+/** !
+ * Find the position of an element in a set
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * 
+ * @return the index of the element in the elements array IF found ELSE SET_INDEX_NOT_FOUND
+ */
+static size_t set_find ( const set *const p_set, const void *const p_element )
+{
+
+    // Hashed sets
+    if ( p_set->pfn_hash ) return set_hashed_find(p_set, p_element, set_hash(p_set, p_element), (void *) 0, (void *) 0);
+
+    // Sorted sets
+    if ( p_set->pfn_compare )
+    {
+
+        // Initialized data
+        bool   found = false;
+        size_t i     = set_sorted_search(p_set, p_element, &found);
+
+        // Done
+        return ( found ) ? i : SET_INDEX_NOT_FOUND;
+    }
+
+    // Iterate over each element
+    for (size_t i = 0; i < p_set->count; i++)
+
+        // If the element is a match, return the index
+        if ( p_set->pfn_is_equal(p_set->elements[i], p_element) == 0 ) return i;
+
+    // Not found
+    return SET_INDEX_NOT_FOUND;
+}
+
+/** !
+ * Lock, or unlock, the operands of a set operation for reading. Operands 
+ * are locked in order of address, so two threads never wait on each 
+ * other. A set that appears more than once is locked once, because a
+ * second read lock can wait behind a writer forever. Null operands are 
+ * skipped
+ * 
+ * @param pp_sets the sets
+ * @param count   the quantity of sets
+ * @param lock    true to lock the sets, false to unlock them
+ * 
+ * @return void
+ */
+static void set_read_lock_sets ( const set *const *const pp_sets, size_t count, bool lock )
+{
+
+    // Argument check
+    if ( pp_sets == (void *) 0 ) return;
+
+    // Initialized data
+    uintptr_t last = 0;
+
+    // Visit each distinct set, in ascending order of address
+    for (;;)
+    {
+
+        // Initialized data
+        uintptr_t next = UINTPTR_MAX;
+
+        // Find the next set
+        for (size_t i = 0; i < count; i++)
+            if ( (uintptr_t) pp_sets[i] > last && (uintptr_t) pp_sets[i] < next ) next = (uintptr_t) pp_sets[i];
+
+        // Every set was visited
+        if ( next == UINTPTR_MAX ) return;
+
+        // Lock, or unlock, the set
+        if ( lock ) set_rwlock_read_lock((set_rwlock *) &( (const set *) next )->_lock);
+        else        set_rwlock_read_unlock((set_rwlock *) &( (const set *) next )->_lock);
+
+        // Next
+        last = next;
+    }
+}
+
+/** !
+ * Lock, or unlock, two sets for reading
+ * 
+ * @param p_a  set A
+ * @param p_b  set B
+ * @param lock true to lock the sets, false to unlock them
+ * 
+ * @return void
+ */
+static void set_read_lock_pair ( const set *const p_a, const set *const p_b, bool lock )
+{
+
+    // Initialized data
+    const set *sets[2] = { p_a, p_b };
+
+    // Done
+    set_read_lock_sets(sets, 2, lock);
+}
+
+/** !
+ * Lock, or unlock, set A for writing, and set B for reading, in order of 
+ * address. Set B is not locked again IF it is set A
+ * 
+ * @param p_a  set A
+ * @param p_b  set B
+ * @param lock true to lock the sets, false to unlock them
+ * 
+ * @return void
+ */
+static void set_lock_update ( set *const p_a, const set *const p_b, bool lock )
+{
+
+    // Initialized data
+    bool read_b = p_b && p_b != p_a;
+
+    // Unlock
+    if ( lock == false )
+    {
+        if ( p_a    ) set_rwlock_write_unlock(&p_a->_lock);
+        if ( read_b ) set_rwlock_read_unlock((set_rwlock *) &p_b->_lock);
+        return;
+    }
+
+    // Lock the set with the lower address first
+    if ( read_b && (uintptr_t) p_b < (uintptr_t) p_a ) set_rwlock_read_lock((set_rwlock *) &p_b->_lock);
+    if ( p_a ) set_rwlock_write_lock(&p_a->_lock);
+    if ( read_b && (uintptr_t) p_b > (uintptr_t) p_a ) set_rwlock_read_lock((set_rwlock *) &p_b->_lock);
+
+    // Done
+    return;
+}
+
+// The operations on many sets fill their result with the update family
+static int set_update_unlocked ( set *const p_a, const set *const p_b );
+static int set_intersection_update_unlocked ( set *const p_a, const set *const p_b );
+
+/** !
+ * Test if an element is in a set
+ * 
+ * @param p_set        the set
+ * @param p_element    the element
+ * @param pfn_is_equal function for testing equality of elements in a linear set IF parameter is not null ELSE the set's own
+ * 
+ * @return true IF the element is in the set ELSE false
+ */
+static bool set_has ( const set *const p_set, const void *const p_element, set_equal_fn *pfn_is_equal )
+{
+
+    // Roaring sets test one bit
+    if ( p_set->p_roaring ) return (uintptr_t) p_element <= UINT32_MAX && roaring_contains(p_set->p_roaring, (uint32_t) (uintptr_t) p_element);
+
+    // So do bitset sets
+    if ( p_set->p_bits ) return (uintptr_t) p_element < p_set->universe && ( ( p_set->p_bits[(uintptr_t) p_element >> 6] >> ( (uintptr_t) p_element & 63 ) ) & 1 );
+
+    // Frozen sets seek through their skip table
+    if ( p_set->p_frozen ) return frozen_contains(p_set->p_frozen, p_element);
+
+    // Hashed and sorted sets use their own index
+    if ( p_set->pfn_hash || p_set->pfn_compare || pfn_is_equal == (void *) 0 ) return set_find(p_set, p_element) != SET_INDEX_NOT_FOUND;
+
+    // Iterate over each element
+    for (size_t i = 0; i < p_set->count; i++)
+
+        // If the element is a match, it is in the set
+        if ( pfn_is_equal(p_set->elements[i], p_element) == 0 ) return true;
+
+    // Not found
+    return false;
+}
+
+/** !
+ * Compute the hash of an element for Bloom filters and sketches. Hashed 
+ * sets use their own hash function, and other sets hash the address
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * 
+ * @return the hash of the element
+ */
+static unsigned long long set_element_hash ( const set *const p_set, const void *const p_element )
+{
+
+    // Done
+    return ( p_set->pfn_hash ) ? set_hash(p_set, p_element) : set_hash_mix((unsigned long long) (uintptr_t) p_element);
+}
+
+/** !
+ * Add a hash to a Bloom filter
+ * 
+ * @param p_bloom the Bloom filter
+ * @param blocks  the quantity of blocks in the Bloom filter
+ * @param hash    the hash
+ * 
+ * @return void
+ */
+static void set_bloom_insert ( uint32_t *const p_bloom, size_t blocks, unsigned long long hash )
+{
+
+    // Initialized data
+    uint32_t *p_block = &p_bloom[( ( hash >> 32 ) * blocks >> 32 ) * 8];
+    uint32_t  key     = (uint32_t) hash;
+
+    // Set one bit in each word of the block
+    for (size_t i = 0; i < 8; i++) p_block[i] |= 1U << ( ( key * set_bloom_salts[i] ) >> 27 );
+
+    // Done
+    return;
+}
+
+/** !
+ * Test if a Bloom filter might contain a hash
+ * 
+ * @param p_bloom the Bloom filter
+ * @param blocks  the quantity of blocks in the Bloom filter
+ * @param hash    the hash
+ * 
+ * @return false IF the hash was never added ELSE true
+ */
+static bool set_bloom_test ( const uint32_t *const p_bloom, size_t blocks, unsigned long long hash )
+{
+
+    // Initialized data
+    const uint32_t *p_block = &p_bloom[( ( hash >> 32 ) * blocks >> 32 ) * 8];
+    uint32_t        key     = (uint32_t) hash,
+                    missing = 0;
+
+    // Test one bit in each word of the block
+    for (size_t i = 0; i < 8; i++) missing |= ~p_block[i] & ( 1U << ( ( key * set_bloom_salts[i] ) >> 27 ) );
+
+    // Done
+    return missing == 0;
+}
+
+/** !
+ * Rebuild the Bloom filter of a set from its elements
+ * 
+ * @param p_set    the set
+ * @param capacity the quantity of elements the Bloom filter is sized for
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_bloom_build ( set *const p_set, size_t capacity )
+{
+
+    // Initialized data
+    size_t    blocks  = ( capacity * SET_BLOOM_BITS + 255 ) / 256;
+    uint32_t *p_bloom = SET_CALLOC(blocks * 8, sizeof(uint32_t));
+
+    // Error check
+    if ( p_bloom == (void *) 0 ) goto no_mem;
+
+    // Add each element
+    for (size_t i = 0; i < p_set->count; i++) set_bloom_insert(p_bloom, blocks, set_element_hash(p_set, p_set->elements[i]));
+
+    // Free the old Bloom filter
+    SET_FREE(p_set->p_bloom);
+
+    // Store the Bloom filter
+    p_set->p_bloom        = p_bloom,
+    p_set->bloom_blocks   = blocks,
+    p_set->bloom_capacity = blocks * 256 / SET_BLOOM_BITS,
+    p_set->bloom_removed  = 0;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Add an element to the Bloom filter of a set. The filter is rebuilt 
+ * twice as large once the set outgrows it, and at the same size once
+ * half of its elements have been removed. If the rebuild fails, the old
+ * filter is kept; it is still correct, just less selective
+ * 
+ * @param p_set     the set
+ * @param p_element the element. Must already be in the elements array
+ * 
+ * @return void
+ */
+static void set_bloom_add ( set *const p_set, const void *const p_element )
+{
+
+    // Rebuild the Bloom filter
+    if ( p_set->count > p_set->bloom_capacity || p_set->bloom_removed > p_set->count / 2 + 64 )
+        (void)set_bloom_build(p_set, ( p_set->count > p_set->bloom_capacity ) ? p_set->count * 2 : p_set->bloom_capacity);
+
+    // Add the element
+    set_bloom_insert(p_set->p_bloom, p_set->bloom_blocks, set_element_hash(p_set, p_element));
+
+    // Done
+    return;
+}
+
+/** !
+ * Add an element to the Bloom filter, the sketch, and the signature of a set
+ * 
+ * @param p_set     the set
+ * @param p_element the element. Must already be in the set
+ * 
+ * @return void
+ */
+static void set_filters_add ( set *const p_set, const void *const p_element )
+{
+
+    // Keep the Bloom filter, the sketch, and the signature in sync
+    if ( p_set->p_bloom   ) set_bloom_add(p_set, p_element);
+    if ( p_set->p_sketch  ) hll_add(p_set->p_sketch, set_element_hash(p_set, p_element));
+    if ( p_set->p_minhash ) minhash_add(p_set->p_minhash, set_element_hash(p_set, p_element));
+
+    // Done
+    return;
+}
+
+/** !
+ * Test if two sets are sorted by the same comparator, and can be merged
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return true IF the sets can be merged ELSE false
+ */
+static bool set_is_mergeable ( const set *const p_a, const set *const p_b )
+{
+
+    // Done
+    return p_a->pfn_compare && p_a->pfn_compare == p_b->pfn_compare;
+}
+
+/** !
+ * Test if a set compares its elements by address
+ * 
+ * @param p_set the set
+ * 
+ * @return true IF the set tests equality with '==', or sorts by address ELSE false
+ */
+static bool set_is_by_address ( const set *const p_set )
+{
+
+    // Done
+    return p_set->pfn_is_equal == &equals_function || p_set->pfn_compare == &compare_function;
+}
+
+/** !
+ * Test if the sizes of two sets are skewed enough to gallop
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return true IF one set is at least SET_GALLOP_RATIO times larger than the other ELSE false
+ */
+static bool set_is_skewed ( const set *const p_a, const set *const p_b )
+{
+
+    // Done
+    return ( p_a->count / SET_GALLOP_RATIO > p_b->count ) || ( p_b->count / SET_GALLOP_RATIO > p_a->count );
+}
+
+/** !
+ * Intersect two sorted sets by galloping through the larger set once for 
+ * each element of the smaller set. Costs O(m log n), where m is the size
+ * of the smaller set and n is the size of the larger set. The result 
+ * must be empty, and have room for every element of the smaller set
+ * 
+ * @param p_result the result. May be null, to only test for a common element
+ * @param p_a      sorted set A
+ * @param p_b      sorted set B
+ * 
+ * @return the quantity of common elements, or 1 IF p_result is null and there is a common element
+ */
+static size_t set_sorted_gallop_intersection ( set *const p_result, const set *const p_a, const set *const p_b )
+{
+
+    // Initialized data
+    const set *p_small = ( p_a->count < p_b->count ) ? p_a : p_b,
+              *p_large = ( p_a->count < p_b->count ) ? p_b : p_a;
+    size_t     j       = 0,
+               k       = 0;
+
+    // Iterate over each element of the smaller set
+    for (size_t i = 0; i < p_small->count && j < p_large->count; i++)
+    {
+
+        // Initialized data
+        bool found = false;
+
+        // Gallop forward through the larger set
+        j = set_sorted_gallop(p_large, j, p_small->elements[i], &found);
+
+        // Skip elements that are not in both sets
+        if ( found == false ) continue;
+
+        // Early exit
+        if ( p_result == (void *) 0 ) return 1;
+
+        // Keep the element from set A
+        p_result->elements[k++] = ( p_large == p_a ) ? p_large->elements[j] : p_small->elements[i];
+    }
+
+    // Store the quantity of elements
+    if ( p_result ) p_result->count = k;
+
+    // Done
+    return k;
+}
+
+/** !
+ * Merge two sets of integer keys, sorted by the default comparator, with
+ * the vector kernels. The result must be empty, and have room for every
+ * element of both sets
+ * 
+ * @param p_result the result
+ * @param p_a      sorted set A
+ * @param p_b      sorted set B
+ * @param keep     which elements to keep. Any of SET_MERGE_A, SET_MERGE_AB, and SET_MERGE_B
+ * 
+ * @return true IF a kernel merged the sets ELSE false
+ */
+static bool set_sorted_kernel ( set *const p_result, const set *const p_a, const set *const p_b, int keep )
+{
+
+    // Pointers are 64 bit keys
+    if ( sizeof(void *) == sizeof(uint64_t) )
+    {
+
+        // Initialized data
+        const uint64_t *p_a_keys      = (const uint64_t *) p_a->elements,
+                       *p_b_keys      = (const uint64_t *) p_b->elements;
+        uint64_t       *p_result_keys = (uint64_t *) p_result->elements;
+
+        // Merge
+        switch ( keep )
+        {
+            case SET_MERGE_A | SET_MERGE_AB | SET_MERGE_B:
+                p_result->count = set_kernel_union_u64(p_a_keys, p_a->count, p_b_keys, p_b->count, p_result_keys);
+                return true;
+
+            case SET_MERGE_AB:
+                p_result->count = set_kernel_intersection_u64(p_a_keys, p_a->count, p_b_keys, p_b->count, p_result_keys);
+                return true;
+
+            case SET_MERGE_A:
+                p_result->count = set_kernel_difference_u64(p_a_keys, p_a->count, p_b_keys, p_b->count, p_result_keys);
+                return true;
+        }
+    }
+
+    // Pointers are 32 bit keys
+    else if ( sizeof(void *) == sizeof(uint32_t) )
+    {
+
+        // Initialized data
+        const uint32_t *p_a_keys      = (const uint32_t *) p_a->elements,
+                       *p_b_keys      = (const uint32_t *) p_b->elements;
+        uint32_t       *p_result_keys = (uint32_t *) p_result->elements;
+
+        // Merge
+        switch ( keep )
+        {
+            case SET_MERGE_A | SET_MERGE_AB | SET_MERGE_B:
+                p_result->count = set_kernel_union_u32(p_a_keys, p_a->count, p_b_keys, p_b->count, p_result_keys);
+                return true;
+
+            case SET_MERGE_AB:
+                p_result->count = set_kernel_intersection_u32(p_a_keys, p_a->count, p_b_keys, p_b->count, p_result_keys);
+                return true;
+
+            case SET_MERGE_A:
+                p_result->count = set_kernel_difference_u32(p_a_keys, p_a->count, p_b_keys, p_b->count, p_result_keys);
+                return true;
+        }
+    }
+
+    // Done
+    return false;
+}
+
+/** !
+ * Merge two sorted sets into a sorted result in one linear pass. The 
+ * result must be empty, and have room for every kept element
+ * 
+ * @param p_result the result
+ * @param p_a      sorted set A
+ * @param p_b      sorted set B
+ * @param keep     which elements to keep. Any of SET_MERGE_A, SET_MERGE_AB, and SET_MERGE_B
+ * 
+ * @return void
+ */
+static void set_sorted_merge ( set *const p_result, const set *const p_a, const set *const p_b, int keep )
+{
+
+    // Initialized data
+    set_compare_fn  *pfn_compare = p_a->pfn_compare;
+    void           **p_out       = p_result->elements;
+    size_t           i           = 0,
+                     j           = 0,
+                     k           = 0;
+
+    // The default comparator orders elements as unsigned integers, which the kernels merge in vectors
+    if ( pfn_compare == &compare_function && set_sorted_kernel(p_result, p_a, p_b, keep) ) return;
+
+    // Merge
+    while ( i < p_a->count && j < p_b->count )
+    {
+
+        // Initialized data
+        int c = pfn_compare(p_a->elements[i], p_b->elements[j]);
+
+        // Only in A
+        if      ( c < 0 ) { if ( keep & SET_MERGE_A  ) p_out[k++] = p_a->elements[i]; i++; }
+
+        // Only in B
+        else if ( c > 0 ) { if ( keep & SET_MERGE_B  ) p_out[k++] = p_b->elements[j]; j++; }
+
+        // In both
+        else              { if ( keep & SET_MERGE_AB ) p_out[k++] = p_a->elements[i]; i++, j++; }
+    }
+
+    // Copy the rest of set A
+    if ( keep & SET_MERGE_A )
+        for (; i < p_a->count; i++) p_out[k++] = p_a->elements[i];
+
+    // Copy the rest of set B
+    if ( keep & SET_MERGE_B )
+        for (; j < p_b->count; j++) p_out[k++] = p_b->elements[j];
+
+    // Store the quantity of elements
+    p_result->count = k;
+
+    // Done
+    return;
+}
+
+/** !
+ * Construct an empty set that indexes elements the same way as set A and set B
+ * 
+ * @param pp_set       return
+ * @param size         number of set elements
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_construct_like ( set **const pp_set, size_t size, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // If both sets are hashed the same way, so is the result
+    if ( p_a->pfn_hash && p_a->pfn_hash == p_b->pfn_hash && p_a->pfn_is_equal == p_b->pfn_is_equal )
+        return set_construct_hashed(pp_set, size, p_a->pfn_is_equal, p_a->pfn_hash);
+
+    // If both sets are sorted the same way, so is the result
+    if ( set_is_mergeable(p_a, p_b) )
+        return set_construct_sorted(pp_set, size, p_a->pfn_compare);
+
+    // If either set is hashed, and every element is compared by address, the result is hashed like it.
+    // Otherwise, each element would be added to a linear set in linear time
+    if ( ( pfn_is_equal == (void *) 0 || pfn_is_equal == &equals_function ) && set_is_by_address(p_a) && set_is_by_address(p_b) )
+    {
+        if ( p_a->pfn_hash ) return set_construct_hashed(pp_set, size, p_a->pfn_is_equal, p_a->pfn_hash);
+        if ( p_b->pfn_hash ) return set_construct_hashed(pp_set, size, p_b->pfn_is_equal, p_b->pfn_hash);
+    }
+
+    // Default
+    return set_construct(pp_set, size, pfn_is_equal);
+}
+
+/** !
+ * Test if a set stores its elements outside of the elements array
+ * 
+ * @param p_set the set
+ * 
+ * @return true IF the set is a roaring set, a bitset set, or a frozen set ELSE false
+ */
+static bool set_is_compact ( const set *const p_set )
+{
+
+    // Done
+    return p_set->p_roaring || p_set->p_bits || p_set->p_frozen;
+}
+
+/** !
+ * Write the elements of a bitset set, in ascending order
+ * 
+ * @param p_set       the bitset set
+ * @param pp_contents return. Must have room for every element
+ * 
+ * @return the quantity of elements written
+ */
+static size_t set_bitset_contents ( const set *const p_set, void **const pp_contents )
+{
+
+    // Initialized data
+    size_t k = 0;
+
+    // Store the index of each set bit
+    for (size_t i = 0; i < ( p_set->universe + 63 ) / 64; i++)
+        for (uint64_t w = p_set->p_bits[i]; w; w &= w - 1)
+            pp_contents[k++] = (void *) ( i * 64 + (size_t) __builtin_ctzll(w) );
+
+    // Done
+    return k;
+}
+
+/** !
+ * Combine two bitset sets one word at a time
+ * 
+ * @param pp_set return
+ * @param p_a    bitset set A
+ * @param p_b    bitset set B
+ * @param keep   which elements to keep. Any of SET_MERGE_A, SET_MERGE_AB, and SET_MERGE_B
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_bitset_combine ( set **const pp_set, const set *const p_a, const set *const p_b, int keep )
+{
+
+    // Initialized data
+    set            *p_set    = (void *) 0;
+    size_t          universe = ( keep == SET_MERGE_AB ) ? ( ( p_a->universe < p_b->universe ) ? p_a->universe : p_b->universe ) :
+                               ( keep == SET_MERGE_A  ) ? p_a->universe                                                             :
+                                                          ( ( p_a->universe > p_b->universe ) ? p_a->universe : p_b->universe ),
+                    a_words  = ( p_a->universe + 63 ) / 64,
+                    b_words  = ( p_b->universe + 63 ) / 64,
+                    words    = ( universe + 63 ) / 64,
+                    common   = ( a_words < b_words ) ? a_words : b_words,
+                    count    = 0;
+    const uint64_t *p_a_bits = p_a->p_bits,
+                   *p_b_bits = p_b->p_bits;
+    uint64_t       *p_bits   = (void *) 0;
+
+    // Construct a set
+    if ( set_construct_bitset(&p_set, universe) == 0 ) goto failed_to_construct_set;
+
+    // Initialized data
+    p_bits = p_set->p_bits;
+
+    // Combine the words that both sets have
+    switch ( keep )
+    {
+        case SET_MERGE_A | SET_MERGE_AB | SET_MERGE_B:
+            for (size_t i = 0; i < common; i++) p_bits[i] = p_a_bits[i] | p_b_bits[i];
+            break;
+
+        case SET_MERGE_AB:
+            for (size_t i = 0; i < common; i++) p_bits[i] = p_a_bits[i] & p_b_bits[i];
+            break;
+
+        case SET_MERGE_A:
+            for (size_t i = 0; i < common; i++) p_bits[i] = p_a_bits[i] & ~p_b_bits[i];
+            break;
+
+        default:
+            for (size_t i = 0; i < common; i++) p_bits[i] = p_a_bits[i] ^ p_b_bits[i];
+            break;
+    }
+
+    // Copy the words that only the larger set has
+    if ( common < words )
+        memcpy(&p_bits[common], ( a_words > common ) ? &p_a_bits[common] : &p_b_bits[common], ( words - common ) * sizeof(uint64_t));
+
+    // Count the elements
+    for (size_t i = 0; i < words; i++) count += (size_t) __builtin_popcountll(p_bits[i]);
+
+    // Store the quantity of elements
+    p_set->count = count;
+
+    // Return a pointer to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct_bitset\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Construct a sorted copy of a roaring set, a bitset set, or a frozen set
+ * 
+ * @param pp_set return
+ * @param p_set  the roaring set, bitset set, or frozen set
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_sorted_copy ( set **const pp_set, const set *const p_set )
+{
+
+    // Construct a sorted set with room for every element
+    if ( set_construct_sorted(pp_set, p_set->count, (void *) 0) == 0 ) return 0;
+
+    // Roaring bitmaps, bitsets, and frozen sequences are already in ascending order
+    (*pp_set)->count = ( p_set->p_roaring ) ? roaring_contents(p_set->p_roaring, (*pp_set)->elements) 
+                     : ( p_set->p_frozen  ) ? frozen_contents(p_set->p_frozen, (*pp_set)->elements)
+                                            : set_bitset_contents(p_set, (*pp_set)->elements);
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Get the elements of any kind of set as an array. Compact sets are 
+ * copied into a sorted set, which the caller destroys
+ * 
+ * @param p_set   the set
+ * @param pp_copy return the copy IF the set is compact ELSE unchanged
+ * 
+ * @return the elements IF successful ELSE null
+ */
+static void **set_elements_of ( const set *const p_set, set **const pp_copy )
+{
+
+    // Sets that are not compact already have an array
+    if ( set_is_compact(p_set) == false ) return p_set->elements;
+
+    // Copy compact sets
+    if ( set_sorted_copy(pp_copy, p_set) == 0 ) return (void *) 0;
+
+    // Done
+    return (*pp_copy)->elements;
+}
+
+/** !
+ * Rebuild the index of a hashed set from its elements array, with room
+ * for some quantity of elements. The current index is reused IF it is 
+ * large enough. A rehash in flight is abandoned, since every element is
+ * reinserted
+ * 
+ * @param p_set the hashed set
+ * @param size  the quantity of elements to make room for
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_index_rebuild ( set *const p_set, size_t size )
+{
+
+    // Initialized data
+    set_index index = { 0 };
+    size_t    max   = set_index_size(size);
+
+    // Allocate a larger index, before touching the current one
+    if ( max > p_set->index.max && set_index_construct(&index, max) == 0 ) goto failed_to_allocate_index;
+
+    // Abandon the old index
+    SET_FREE(p_set->old_index.p_slots);
+    memset(&p_set->old_index, 0, sizeof(set_index));
+    p_set->rehash_cursor = 0;
+
+    // Replace the current index with the larger one ...
+    if ( index.p_slots ) { SET_FREE(p_set->index.p_slots); p_set->index = index; }
+
+    // ... or empty it
+    else memset(p_set->index.p_slots, 0, p_set->index.max * sizeof(size_t)), p_set->index.used = 0;
+
+    // Store the position of each element
+    for (size_t i = 0; i < p_set->count; i++) set_index_insert(&p_set->index, set_hash(p_set, p_set->elements[i]), i);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_allocate_index:
+                #ifndef NDEBUG
+                    printf("[set] Failed to allocate index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Keep the elements of set A that are, or are not, in set B, in place. 
+ * Set A keeps its order, and its storage. Set A must not be compact
+ * 
+ * @param p_a    set A
+ * @param p_b    set B
+ * @param common true to keep the elements that are in set B, false to keep the elements that are not
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_retain ( set *const p_a, const set *const p_b, bool common )
+{
+
+    // Initialized data
+    bool   merge = set_is_mergeable(p_a, p_b) && p_b->p_frozen == (void *) 0;
+    size_t j     = 0,
+           k     = 0;
+
+    // Iterate over each element of set A
+    for (size_t i = 0; i < p_a->count; i++)
+    {
+
+        // Initialized data
+        bool found = false;
+
+        // Sorted sets gallop forward through set B
+        if ( merge ) j = set_sorted_gallop(p_b, j, p_a->elements[i], &found);
+
+        // Other sets look up each element
+        else found = set_has(p_b, p_a->elements[i], (void *) 0);
+
+        // Keep the element
+        if ( found == common ) p_a->elements[k++] = p_a->elements[i];
+    }
+
+    // Zero set the dropped elements
+    memset(&p_a->elements[k], 0, ( p_a->count - k ) * sizeof(void *));
+
+    // The dropped elements stay in the Bloom filter until it is rebuilt
+    p_a->bloom_removed += p_a->count - k;
+
+    // Store the quantity of elements
+    p_a->count = k;
+
+    // Hashed sets rebuild their index, in place
+    if ( p_a->pfn_hash ) return set_index_rebuild(p_a, p_a->count);
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Merge the elements of set B into sorted set A, in place, from the back.
+ * Set A grows once, to make room for every element of set B
+ * 
+ * @param p_a         sorted set A
+ * @param pp_elements the elements of set B, in the order of set A
+ * @param count       the quantity of elements of set B
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_sorted_merge_update ( set *const p_a, void *const *const pp_elements, size_t count )
+{
+
+    // Initialized data
+    size_t i = p_a->count,
+           j = count,
+           w = p_a->count + count;
+
+    // Make room for every element of set B
+    if ( set_reserve(p_a, p_a->count + count) == 0 ) return 0;
+
+    // Merge from the back. The write position never passes the next element of set A
+    while ( j > 0 )
+    {
+
+        // Initialized data
+        int c = ( i > 0 ) ? p_a->pfn_compare(p_a->elements[i - 1], pp_elements[j - 1]) : -1;
+
+        // Only in set A
+        if      ( c > 0 ) p_a->elements[--w] = p_a->elements[--i];
+
+        // In both
+        else if ( c == 0 ) p_a->elements[--w] = p_a->elements[--i], j--;
+
+        // Only in set B
+        else p_a->elements[--w] = pp_elements[--j];
+    }
+
+    // Close the gap left by common elements
+    memmove(&p_a->elements[i], &p_a->elements[w], ( p_a->count + count - w ) * sizeof(void *));
+
+    // Store the quantity of elements
+    p_a->count = i + ( p_a->count + count - w );
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Construct an empty set for the result of a set operation on many sets.
+ * The result is roaring, bitset, hashed, or sorted IF every operand is
+ * ELSE linear
+ * 
+ * @param pp_set       return
+ * @param size         the maximum quantity of elements in the result
+ * @param pp_sets      the operands
+ * @param count        the quantity of operands
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_construct_like_n ( set **const pp_set, size_t size, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    const set *p_first  = pp_sets[0];
+    const set *p_hashed = (void *) 0;
+    bool       roaring  = true,
+               bits     = true,
+               hashed   = true,
+               sorted   = true,
+               address  = ( pfn_is_equal == (void *) 0 || pfn_is_equal == &equals_function );
+    size_t     universe = 0;
+
+    // Test each operand
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Initialized data
+        const set *p_set = pp_sets[i];
+
+        // Accumulate
+        roaring &= p_set->p_roaring != (void *) 0,
+        bits    &= p_set->p_bits    != (void *) 0,
+        hashed  &= p_set->pfn_hash && p_set->pfn_hash == p_first->pfn_hash && p_set->pfn_is_equal == p_first->pfn_is_equal,
+        sorted  &= set_is_mergeable(p_first, p_set),
+        address &= set_is_compact(p_set) || set_is_by_address(p_set);
+
+        // Remember the first hashed operand
+        if ( p_hashed == (void *) 0 && p_set->pfn_hash ) p_hashed = p_set;
+
+        // The result of bitset sets covers the largest universe
+        if ( p_set->universe > universe ) universe = p_set->universe;
+    }
+
+    // Construct the result
+    if ( roaring ) return set_construct_roaring(pp_set);
+    if ( bits    ) return set_construct_bitset(pp_set, universe);
+    if ( hashed  ) return set_construct_hashed(pp_set, size, p_first->pfn_is_equal, p_first->pfn_hash);
+    if ( sorted  ) return set_construct_sorted(pp_set, size, p_first->pfn_compare);
+
+    // If any operand is hashed, and every element is compared by address, the result is hashed like it
+    if ( p_hashed && address ) return set_construct_hashed(pp_set, size, p_hashed->pfn_is_equal, p_hashed->pfn_hash);
+
+    // Default
+    return set_construct(pp_set, size, pfn_is_equal);
+}
+
+/** !
+ * Sort an array of sets by their quantity of elements, in ascending order
+ * 
+ * @param pp_sets the sets
+ * @param count   the quantity of sets
+ * 
+ * @return void
+ */
+static void set_sort_by_count ( const set **const pp_sets, size_t count )
+{
+
+    // Insertion sort. There are only a few operands
+    for (size_t i = 1; i < count; i++)
+    {
+
+        // Initialized data
+        const set *p_set = pp_sets[i];
+        size_t     j     = i;
+
+        // Shift the larger sets up
+        while ( j > 0 && pp_sets[j - 1]->count > p_set->count ) pp_sets[j] = pp_sets[j - 1], j--;
+
+        // Store the set
+        pp_sets[j] = p_set;
+    }
+
+    // Done
+    return;
+}
+
+/** !
+ * Restore the heap order of a k way merge below some position
+ * 
+ * @param p_heap       the heap of operands, ordered by their next element
+ * @param size         the quantity of operands in the heap
+ * @param i            the position
+ * @param ppp_elements the elements of each operand
+ * @param p_positions  the position of the next element of each operand
+ * @param pfn_compare  the comparator
+ * 
+ * @return void
+ */
+static void set_heap_sift ( size_t *const p_heap, size_t size, size_t i, void ***const ppp_elements, const size_t *const p_positions, set_compare_fn *pfn_compare )
+{
+
+    // Sift down
+    for (;;)
+    {
+
+        // Initialized data
+        size_t least = i,
+               l     = 2 * i + 1,
+               r     = 2 * i + 2;
+
+        // Find the least of the node and its children
+        if ( l < size && pfn_compare(ppp_elements[p_heap[l]][p_positions[p_heap[l]]], ppp_elements[p_heap[least]][p_positions[p_heap[least]]]) < 0 ) least = l;
+        if ( r < size && pfn_compare(ppp_elements[p_heap[r]][p_positions[p_heap[r]]], ppp_elements[p_heap[least]][p_positions[p_heap[least]]]) < 0 ) least = r;
+
+        // The heap is in order
+        if ( least == i ) return;
+
+        // Swap, and continue from the child
+        {
+            size_t t = p_heap[i];
+            p_heap[i] = p_heap[least], p_heap[least] = t;
+        }
+        i = least;
+    }
+}
+
+/** !
+ * Merge many sorted sets into a sorted result in one pass, with a heap of
+ * operands ordered by their next element. Costs O(n log k), where n is the
+ * quantity of elements, and k is the quantity of operands. The result
+ * must be empty, and have room for every element of every operand
+ * 
+ * @param p_result the result
+ * @param pp_sets  the sorted operands
+ * @param count    the quantity of operands
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_sorted_union_n ( set *const p_result, const set *const *const pp_sets, size_t count )
+{
+
+    // Initialized data
+    set_compare_fn   *pfn_compare  = p_result->pfn_compare;
+    void            **p_block      = SET_CALLOC(count, sizeof(set *) + sizeof(void **) + 2 * sizeof(size_t));
+    set             **pp_copies    = (set **) p_block;
+    void           ***ppp_elements = (void ***) ( pp_copies + count );
+    size_t           *p_positions  = (size_t *) ( ppp_elements + count ),
+                     *p_heap       = p_positions + count,
+                      size         = 0,
+                      k            = 0;
+
+    // Error check
+    if ( p_block == (void *) 0 ) goto no_mem;
+
+    // Get the elements of each operand. Frozen operands are decoded
+    for (size_t i = 0; i < count; i++)
+    {
+
+        // Get the elements
+        ppp_elements[i] = set_elements_of(pp_sets[i], &pp_copies[i]);
+
+        // Error check
+        if ( ppp_elements[i] == (void *) 0 ) goto failed_to_copy;
+
+        // Operands with elements join the heap
+        if ( pp_sets[i]->count ) p_heap[size++] = i;
+    }
+
+    // Order the heap
+    for (size_t i = size / 2; i-- > 0;) set_heap_sift(p_heap, size, i, ppp_elements, p_positions, pfn_compare);
+
+    // Take the least element until every operand is exhausted
+    while ( size )
+    {
+
+        // Initialized data
+        size_t  i         = p_heap[0];
+        void   *p_element = ppp_elements[i][p_positions[i]++];
+
+        // Keep the element, unless it was just kept
+        if ( k == 0 || pfn_compare(p_result->elements[k - 1], p_element) != 0 ) p_result->elements[k++] = p_element;
+
+        // Exhausted operands leave the heap
+        if ( p_positions[i] == pp_sets[i]->count ) p_heap[0] = p_heap[--size];
+
+        // Restore the heap order
+        set_heap_sift(p_heap, size, 0, ppp_elements, p_positions, pfn_compare);
+    }
+
+    // Store the quantity of elements
+    p_result->count = k;
+
+    // Clean up
+    for (size_t i = 0; i < count; i++) if ( pp_copies[i] ) set_destroy(&pp_copies[i]);
+    SET_FREE(p_block);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] Failed to copy set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                for (size_t i = 0; i < count; i++) if ( pp_copies[i] ) set_destroy(&pp_copies[i]);
+                SET_FREE(p_block);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Compute a set operation where either operand is a roaring set or a 
+ * bitset set. Two roaring sets are combined by the roaring bitmap, and 
+ * two bitset sets are combined one word at a time. Otherwise, each such
+ * operand is copied into a sorted set, and the set operation runs on 
+ * the copy
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param keep         which elements to keep. Any of SET_MERGE_A, SET_MERGE_AB, and SET_MERGE_B
+ * @param pfn_roaring  the operation on roaring bitmaps
+ * @param pfn_set      the operation on sets
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_compact_operation ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, int keep, int (*pfn_roaring)(roaring **const, const roaring *const, const roaring *const), int (*pfn_set)(set **const, const set *const, const set *const, set_equal_fn *) )
+{
+
+    // Initialized data
+    set *p_set      = (void *) 0,
+        *p_sorted_a = (void *) 0,
+        *p_sorted_b = (void *) 0;
+    int  result     = 0;
+
+    // Two bitset sets
+    if ( p_a->p_bits && p_b->p_bits ) return set_bitset_combine(pp_set, p_a, p_b, keep);
+
+    // Two roaring sets
+    if ( p_a->p_roaring && p_b->p_roaring )
+    {
+
+        // Construct a set
+        if ( set_construct(&p_set, 0, (void *) 0) == 0 ) goto failed_to_construct_set;
+
+        // Combine the roaring bitmaps
+        if ( pfn_roaring(&p_set->p_roaring, p_a->p_roaring, p_b->p_roaring) == 0 ) goto failed_to_combine;
+
+        // Store the quantity of elements
+        p_set->count = roaring_count(p_set->p_roaring);
+
+        // Return a pointer to the caller
+        *pp_set = p_set;
+
+        // Success
+        return 1;
+    }
+
+    // Copy the compact operands
+    if ( set_is_compact(p_a) && set_sorted_copy(&p_sorted_a, p_a) == 0 ) goto failed_to_construct_set;
+    if ( set_is_compact(p_b) && set_sorted_copy(&p_sorted_b, p_b) == 0 ) goto failed_to_copy;
+
+    // Compute the set operation on the copies
+    result = pfn_set(pp_set, ( p_sorted_a ) ? p_sorted_a : p_a, ( p_sorted_b ) ? p_sorted_b : p_b, pfn_is_equal);
+
+    // Clean up
+    if ( p_sorted_a ) set_destroy(&p_sorted_a);
+    if ( p_sorted_b ) set_destroy(&p_sorted_b);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_sorted_a ) set_destroy(&p_sorted_a);
+
+                // Error
+                return 0;
+
+            failed_to_combine:
+                #ifndef NDEBUG
+                    printf("[set] Failed to combine roaring bitmaps in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Combine one slice of a parallel set operation. Sorted slices are 
+ * merged, and other slices keep elements by testing the other operand
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_slice_combine ( void *const p_argument )
+{
+
+    // Initialized data
+    set_slice  *p_slice = p_argument;
+    const set  *p_a     = p_slice->p_a,
+               *p_b     = p_slice->p_b;
+    void      **p_out   = p_slice->p_result->elements + p_slice->offset;
+    size_t      k       = 0;
+
+    // Sorted slices are merged like whole sets, through views of each range
+    if ( p_slice->p_result->pfn_compare )
+    {
+
+        // Initialized data
+        set a      = *p_a,
+            b      = *p_b,
+            result = *p_slice->p_result;
+
+        // Narrow the views
+        a.elements      = p_a->elements + p_slice->a_begin, a.count = p_slice->a_end - p_slice->a_begin,
+        b.elements      = p_b->elements + p_slice->b_begin, b.count = p_slice->b_end - p_slice->b_begin,
+        result.elements = p_out,                            result.count = 0;
+
+        // Skewed slices are intersected by galloping
+        if ( p_slice->keep == SET_MERGE_AB && set_is_skewed(&a, &b) ) set_sorted_gallop_intersection(&result, &a, &b);
+
+        // Merge
+        else set_sorted_merge(&result, &a, &b, p_slice->keep);
+
+        // Store the quantity of elements
+        p_slice->count = result.count;
+
+        // Success
+        return 1;
+    }
+
+    // Keep the elements of set A ...
+    for (size_t i = p_slice->a_begin; i < p_slice->a_end; i++)
+    {
+
+        // Initialized data
+        void *p_element = p_a->elements[i];
+
+        // ... without testing set B, for unions ...
+        if ( ( p_slice->keep & SET_MERGE_A ) && ( p_slice->keep & SET_MERGE_AB ) ) p_out[k++] = p_element;
+
+        // ... or by testing set B
+        else if ( set_has(p_b, p_element, p_slice->pfn_is_equal) == ( ( p_slice->keep & SET_MERGE_AB ) != 0 ) ) p_out[k++] = p_element;
+    }
+
+    // Keep the elements of set B that are not in set A
+    for (size_t i = p_slice->b_begin; i < p_slice->b_end; i++)
+        if ( set_has(p_a, p_b->elements[i], p_slice->pfn_is_equal) == false ) p_out[k++] = p_b->elements[i];
+
+    // Store the quantity of elements
+    p_slice->count = k;
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Index one slice of the result of a parallel set operation. Slots are 
+ * claimed with compare and swap, so workers share the index without a lock
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_slice_index ( void *const p_argument )
+{
+
+    // Initialized data
+    set_slice *p_slice = p_argument;
+    set       *p_set   = p_slice->p_result;
+    size_t    *p_slots = p_set->index.p_slots,
+               mask    = p_set->index.max - 1;
+
+    // Store the position of each element in the slice
+    for (size_t i = p_slice->offset; i < p_slice->offset + p_slice->count; i++)
+    {
+
+        // Initialized data
+        size_t j        = (size_t) set_hash(p_set, p_set->elements[i]) & mask,
+               expected = SET_INDEX_EMPTY;
+
+        // Claim the first empty slot
+        while ( __atomic_compare_exchange_n(&p_slots[j], &expected, i + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == false )
+            j = ( j + 1 ) & mask, expected = SET_INDEX_EMPTY;
+    }
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Compute a set operation on worker threads. Sorted operands are split 
+ * into key ranges, and other operands into ranges of positions. Each 
+ * worker writes to a disjoint region of one result, and the regions are
+ * closed up when every worker is done. Operations on compact sets, or 
+ * on too few elements to split, run on the calling thread
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * @param threads      the quantity of worker threads IF positive ELSE one per hardware thread
+ * @param keep         which elements to keep. Any of SET_MERGE_A, SET_MERGE_AB, and SET_MERGE_B
+ * @param pfn_set      the single threaded set operation
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_parallel_operation ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads, int keep, int (*pfn_set)(set **const, const set *const, const set *const, set_equal_fn *) )
+{
+
+    // Initialized data
+    set       *p_set    = (void *) 0;
+    set_slice *p_slices = (void *) 0;
+    size_t     total    = p_a->count + p_b->count,
+               size     = ( keep & SET_MERGE_B ) ? total : p_a->count,
+               k        = 0;
+
+    // Default to one worker per hardware thread
+    if ( threads == 0 ) threads = set_parallel_hardware_threads();
+
+    // Give each worker enough elements to be worth a thread
+    if ( threads > total / SET_PARALLEL_GRAIN ) threads = total / SET_PARALLEL_GRAIN;
+
+    // Compact sets, and small sets, are combined on the calling thread
+    if ( threads < 2 || set_is_compact(p_a) || set_is_compact(p_b) ) return pfn_set(pp_set, p_a, p_b, pfn_is_equal);
+
+    // Construct the result, with room for every region
+    if ( set_construct_like(&p_set, ( keep == SET_MERGE_AB && p_b->count < p_a->count ) ? p_b->count : size, p_a, p_b, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+    if ( set_reserve(p_set, size) == 0 ) goto failed_to_allocate;
+
+    // Allocate the slices
+    p_slices = SET_CALLOC(threads, sizeof(set_slice));
+
+    // Error check
+    if ( p_slices == (void *) 0 ) goto no_mem;
+
+    // Split the operands
+    for (size_t t = 0; t < threads; t++)
+    {
+
+        // Initialized data
+        set_slice *p_slice = &p_slices[t];
+        bool       found   = false;
+
+        // Store the operation
+        p_slice->p_a          = p_a,
+        p_slice->p_b          = p_b,
+        p_slice->p_result     = p_set,
+        p_slice->pfn_is_equal = pfn_is_equal,
+        p_slice->keep         = keep;
+
+        // Sorted operands split the larger set evenly, and the smaller set at the same key
+        if ( p_set->pfn_compare )
+        {
+            if ( p_a->count >= p_b->count )
+                p_slice->a_begin = t * p_a->count / threads,
+                p_slice->b_begin = ( t ) ? set_sorted_search(p_b, p_a->elements[p_slice->a_begin], &found) : 0;
+            else
+                p_slice->b_begin = t * p_b->count / threads,
+                p_slice->a_begin = ( t ) ? set_sorted_search(p_a, p_b->elements[p_slice->b_begin], &found) : 0;
+        }
+
+        // Other operands split both sets evenly. Only unions scan set B
+        else
+            p_slice->a_begin = t * p_a->count / threads,
+            p_slice->b_begin = ( keep & SET_MERGE_B ) ? t * p_b->count / threads : 0;
+
+        // Each slice ends where the next begins
+        if ( t ) p_slices[t - 1].a_end = p_slice->a_begin, p_slices[t - 1].b_end = p_slice->b_begin;
+
+        // Each slice can keep at most every element of its ranges that the result keeps
+        p_slice->offset = p_slice->a_begin + ( ( keep & SET_MERGE_B ) ? p_slice->b_begin : 0 );
+    }
+
+    // The last slice ends at the end of each set
+    p_slices[threads - 1].a_end = p_a->count,
+    p_slices[threads - 1].b_end = ( p_set->pfn_compare || ( keep & SET_MERGE_B ) ) ? p_b->count : 0;
+
+    // Combine the slices
+    if ( set_parallel_run(&set_slice_combine, p_slices, sizeof(set_slice), threads) == 0 ) goto failed_to_run;
+
+    // Close up the regions, in order
+    for (size_t t = 0; t < threads; t++)
+    {
+
+        // Move the region
+        memmove(&p_set->elements[k], &p_set->elements[p_slices[t].offset], p_slices[t].count * sizeof(void *));
+
+        // Store the new offset
+        p_slices[t].offset = k,
+        k += p_slices[t].count;
+    }
+
+    // Store the quantity of elements
+    p_set->count = k;
+
+    // Hashed results are indexed on the worker threads
+    if ( p_set->pfn_hash )
+    {
+
+        // Index the slices
+        if ( set_parallel_run(&set_slice_index, p_slices, sizeof(set_slice), threads) == 0 ) goto failed_to_run;
+
+        // Account for the slots
+        p_set->index.used = k;
+    }
+
+    // Clean up
+    SET_FREE(p_slices);
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_allocate:
+                #ifndef NDEBUG
+                    printf("[set] Failed to allocate elements in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+
+            failed_to_run:
+                #ifndef NDEBUG
+                    printf("[set] Failed to run worker threads in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_slices);
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Claim an index slot for each element of one slice of a bulk build. 
+ * Slots are claimed with compare and swap. Of two equal elements, the 
+ * slot keeps the one that comes first in the input, and the other is 
+ * marked as a duplicate, so the result does not depend on scheduling
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_build_claim ( void *const p_argument )
+{
+
+    // Initialized data
+    set_build *p_build = p_argument;
+    set       *p_set   = p_build->p_set;
+    size_t    *p_slots = p_set->index.p_slots,
+               mask    = p_set->index.max - 1;
+
+    // Claim a slot for each element
+    for (size_t i = p_build->begin; i < p_build->end; i++)
+    {
+
+        // Initialized data
+        const void         *p_element = p_build->pp_elements[i];
+        unsigned long long  hash      = set_hash(p_set, p_element);
+        size_t              j         = (size_t) hash & mask;
+
+        // Publish the hash, before the slot that refers to it
+        p_build->p_hashes[i] = hash;
+
+        // Linear probe
+        for (;;)
+        {
+
+            // Initialized data
+            size_t slot = __atomic_load_n(&p_slots[j], __ATOMIC_ACQUIRE);
+
+            // Claim an empty slot. If another worker claims it first, test its element
+            if ( slot == SET_INDEX_EMPTY )
+            {
+                if ( __atomic_compare_exchange_n(&p_slots[j], &slot, i + 1, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE) ) break;
+                continue;
+            }
+
+            // Skip different elements
+            if ( p_build->p_hashes[slot - 1] != hash || p_set->pfn_is_equal(p_build->pp_elements[slot - 1], p_element) )
+            {
+                j = ( j + 1 ) & mask;
+                continue;
+            }
+
+            // The earlier element stays
+            if ( slot - 1 < i )
+            {
+                __atomic_store_n(&p_build->p_duplicates[i], true, __ATOMIC_RELAXED);
+                break;
+            }
+
+            // This element replaces a later one. If another worker replaces it first, test the replacement
+            if ( __atomic_compare_exchange_n(&p_slots[j], &slot, i + 1, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE) )
+            {
+                __atomic_store_n(&p_build->p_duplicates[slot - 1], true, __ATOMIC_RELAXED);
+                break;
+            }
+        }
+    }
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Count the elements of one slice of a bulk build that are not duplicates
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_build_count ( void *const p_argument )
+{
+
+    // Initialized data
+    set_build *p_build = p_argument;
+    size_t     k       = 0;
+
+    // Count the elements that stay
+    for (size_t i = p_build->begin; i < p_build->end; i++) k += p_build->p_duplicates[i] == false;
+
+    // Store the quantity of elements
+    p_build->count = k;
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Store the elements of one slice of a bulk build, in input order, from 
+ * the slice's offset in the elements array, and remember where each went
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_build_place ( void *const p_argument )
+{
+
+    // Initialized data
+    set_build *p_build = p_argument;
+    size_t     k       = p_build->offset;
+
+    // Store each element that stays
+    for (size_t i = p_build->begin; i < p_build->end; i++)
+    {
+
+        // Skip duplicates
+        if ( p_build->p_duplicates[i] ) continue;
+
+        // Store the element, and its position
+        p_build->p_set->elements[k] = (void *) p_build->pp_elements[i],
+        p_build->p_positions[i]     = k++;
+    }
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Point one range of index slots at the positions of their elements in
+ * the elements array, instead of in the input
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_build_remap ( void *const p_argument )
+{
+
+    // Initialized data
+    set_build *p_build = p_argument;
+    size_t    *p_slots = p_build->p_set->index.p_slots;
+
+    // Rewrite each occupied slot
+    for (size_t j = p_build->slot_begin; j < p_build->slot_end; j++)
+        if ( p_slots[j] != SET_INDEX_EMPTY ) p_slots[j] = p_build->p_positions[p_slots[j] - 1] + 1;
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Fill an empty hashed set from an array of elements, on worker threads,
+ * without locking. The set keeps the first of each group of equal 
+ * elements, in input order. The set's index must have room for every 
+ * element of the input
+ * 
+ * @param p_set       the empty hashed set
+ * @param pp_elements the elements
+ * @param size        the quantity of elements
+ * @param threads     the quantity of worker threads IF positive ELSE one per hardware thread
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_build_hashed ( set *const p_set, const void *const *const pp_elements, size_t size, size_t threads )
+{
+
+    // Initialized data
+    set_build          *p_builds     = (void *) 0;
+    unsigned long long *p_hashes     = (void *) 0;
+    bool               *p_duplicates = (void *) 0;
+    size_t              k            = 0;
+
+    // Default to one worker per hardware thread, with enough elements to be worth a thread
+    if ( threads == 0 ) threads = set_parallel_hardware_threads();
+    if ( threads > size / SET_PARALLEL_GRAIN ) threads = size / SET_PARALLEL_GRAIN;
+    if ( threads == 0 ) threads = 1;
+
+    // Make room for every element
+    if ( set_reserve(p_set, size) == 0 ) goto failed_to_allocate;
+
+    // Allocate the slices, the hashes, and the duplicate flags. Positions reuse the hashes
+    p_builds     = SET_CALLOC(threads, sizeof(set_build)),
+    p_hashes     = SET_CALLOC(size + 1, sizeof(unsigned long long)),
+    p_duplicates = SET_CALLOC(size + 1, sizeof(bool));
+
+    // Error check
+    if ( p_builds     == (void *) 0 ) goto no_mem;
+    if ( p_hashes     == (void *) 0 ) goto no_mem;
+    if ( p_duplicates == (void *) 0 ) goto no_mem;
+
+    // Split the input, and the index, evenly
+    for (size_t t = 0; t < threads; t++)
+        p_builds[t] = (set_build)
+        {
+            .p_set        = p_set,
+            .pp_elements  = pp_elements,
+            .p_hashes     = p_hashes,
+            .p_positions  = (size_t *) p_hashes,
+            .p_duplicates = p_duplicates,
+            .begin        = t * size / threads,
+            .end          = ( t + 1 ) * size / threads,
+            .slot_begin   = t * p_set->index.max / threads,
+            .slot_end     = ( t + 1 ) * p_set->index.max / threads
+        };
+
+    // Claim a slot for each distinct element, and count the elements of each slice
+    if ( set_parallel_run(&set_build_claim, p_builds, sizeof(set_build), threads) == 0 ) goto failed_to_run;
+    if ( set_parallel_run(&set_build_count, p_builds, sizeof(set_build), threads) == 0 ) goto failed_to_run;
+
+    // Each slice stores its elements after the elements of the slices before it
+    for (size_t t = 0; t < threads; t++) p_builds[t].offset = k, k += p_builds[t].count;
+
+    // Store the elements, then point the index at them
+    if ( set_parallel_run(&set_build_place, p_builds, sizeof(set_build), threads) == 0 ) goto failed_to_run;
+    if ( set_parallel_run(&set_build_remap, p_builds, sizeof(set_build), threads) == 0 ) goto failed_to_run;
+
+    // Store the quantity of elements
+    p_set->count      = k,
+    p_set->index.used = k;
+
+    // Clean up
+    SET_FREE(p_builds);
+    SET_FREE(p_hashes);
+    SET_FREE(p_duplicates);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_allocate:
+                #ifndef NDEBUG
+                    printf("[set] Failed to allocate elements in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_run:
+                #ifndef NDEBUG
+                    printf("[set] Failed to run worker threads in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_builds);
+                SET_FREE(p_hashes);
+                SET_FREE(p_duplicates);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_builds);
+                SET_FREE(p_hashes);
+                SET_FREE(p_duplicates);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Merge two adjacent sorted runs of an array into another array
+ * 
+ * @param p_source      the runs
+ * @param p_destination return. The merged run is written at the same position
+ * @param begin         the start of the first run
+ * @param middle        the end of the first run, and the start of the second run
+ * @param end           the end of the second run
+ * @param pfn_compare   function for ordering elements
+ * 
+ * @return void
+ */
+static void set_merge_runs ( void *const *const p_source, void **const p_destination, size_t begin, size_t middle, size_t end, set_compare_fn *pfn_compare )
+{
+
+    // Initialized data
+    size_t i = begin,
+           j = middle,
+           k = begin;
+
+    // Merge. Ties take from the first run, so the merge is stable
+    while ( i < middle && j < end ) p_destination[k++] = ( pfn_compare(p_source[j], p_source[i]) < 0 ) ? p_source[j++] : p_source[i++];
+
+    // Copy the rest of each run
+    while ( i < middle ) p_destination[k++] = p_source[i++];
+    while ( j < end    ) p_destination[k++] = p_source[j++];
+
+    // Done
+    return;
+}
+
+/** !
+ * Sort one slice of a bulk build in place, with a bottom up merge sort
+ * through the scratch array
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_build_sort ( void *const p_argument )
+{
+
+    // Initialized data
+    set_build       *p_build      = p_argument;
+    set_compare_fn  *pfn_compare  = p_build->p_set->pfn_compare;
+    void           **p_source     = p_build->p_set->elements,
+                   **p_destination = p_build->p_scratch;
+
+    // Merge runs of doubling width, alternating between the arrays
+    for (size_t width = 1; width < p_build->end - p_build->begin; width *= 2)
+    {
+
+        // Merge each pair of runs
+        for (size_t i = p_build->begin; i < p_build->end; i += 2 * width)
+        {
+
+            // Initialized data
+            size_t middle = ( i + width     < p_build->end ) ? i + width     : p_build->end,
+                   end    = ( i + 2 * width < p_build->end ) ? i + 2 * width : p_build->end;
+
+            // Merge
+            set_merge_runs(p_source, p_destination, i, middle, end, pfn_compare);
+        }
+
+        // Swap the arrays
+        { void **p_swap = p_source; p_source = p_destination, p_destination = p_swap; }
+    }
+
+    // Leave the sorted slice in the elements array
+    if ( p_source != p_build->p_set->elements ) memcpy(&p_build->p_set->elements[p_build->begin], &p_source[p_build->begin], ( p_build->end - p_build->begin ) * sizeof(void *));
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Merge the two sorted halves of one slice of a bulk build from the 
+ * elements array into the scratch array. The halves meet at offset
+ * 
+ * @param p_argument the slice
+ * 
+ * @return 1
+ */
+static int set_build_merge ( void *const p_argument )
+{
+
+    // Initialized data
+    set_build *p_build = p_argument;
+
+    // Merge
+    set_merge_runs(p_build->p_set->elements, p_build->p_scratch, p_build->begin, p_build->offset, p_build->end, p_build->p_set->pfn_compare);
+
+    // Success
+    return 1;
+}
+
+/** !
+ * Fill an empty sorted set from an array of elements, on worker threads,
+ * without locking. Each worker sorts a slice, the slices are merged in 
+ * pairs, and equal neighbors are dropped in one last pass
+ * 
+ * @param p_set       the empty sorted set
+ * @param pp_elements the elements
+ * @param size        the quantity of elements
+ * @param threads     the quantity of worker threads IF positive ELSE one per hardware thread
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_build_sorted ( set *const p_set, const void *const *const pp_elements, size_t size, size_t threads )
+{
+
+    // Initialized data
+    set_build  *p_builds  = (void *) 0;
+    void      **p_scratch = (void *) 0;
+    size_t      k         = 0;
+
+    // Default to one worker per hardware thread, with enough elements to be worth a thread
+    if ( threads == 0 ) threads = set_parallel_hardware_threads();
+    if ( threads > size / SET_PARALLEL_GRAIN ) threads = size / SET_PARALLEL_GRAIN;
+    if ( threads == 0 ) threads = 1;
+
+    // Make room for every element
+    if ( set_reserve(p_set, size) == 0 ) goto failed_to_allocate;
+
+    // Allocate the slices, and the scratch array
+    p_builds  = SET_CALLOC(threads, sizeof(set_build)),
+    p_scratch = SET_REALLOC(0, ( size + 1 ) * sizeof(void *));
+
+    // Error check
+    if ( p_builds  == (void *) 0 ) goto no_mem;
+    if ( p_scratch == (void *) 0 ) goto no_mem;
+
+    // Copy the input
+    if ( size ) memcpy(p_set->elements, pp_elements, size * sizeof(void *));
+
+    // Split the input evenly
+    for (size_t t = 0; t < threads; t++)
+        p_builds[t] = (set_build)
+        {
+            .p_set     = p_set,
+            .p_scratch = p_scratch,
+            .begin     = t * size / threads,
+            .end       = ( t + 1 ) * size / threads
+        };
+
+    // Sort each slice
+    if ( set_parallel_run(&set_build_sort, p_builds, sizeof(set_build), threads) == 0 ) goto failed_to_run;
+
+    // Merge neighboring slices in pairs, until one slice is left
+    for (size_t runs = threads; runs > 1; runs = ( runs + 1 ) / 2)
+    {
+
+        // Initialized data
+        size_t pairs = runs / 2;
+
+        // Pair the slices. The odd slice out is carried over
+        for (size_t t = 0; t < pairs; t++)
+            p_builds[t].offset = p_builds[2 * t].end,
+            p_builds[t].begin  = p_builds[2 * t].begin,
+            p_builds[t].end    = p_builds[2 * t + 1].end;
+
+        // Merge each pair into the scratch array
+        if ( set_parallel_run(&set_build_merge, p_builds, sizeof(set_build), pairs) == 0 ) goto failed_to_run;
+
+        // Copy the merged pairs back
+        memcpy(p_set->elements, p_scratch, p_builds[pairs - 1].end * sizeof(void *));
+
+        // Carry the odd slice over
+        if ( runs & 1 ) p_builds[pairs] = p_builds[runs - 1];
+    }
+
+    // Drop equal neighbors
+    for (size_t i = 0; i < size; i++)
+        if ( k == 0 || p_set->pfn_compare(p_set->elements[k - 1], p_set->elements[i]) ) p_set->elements[k++] = p_set->elements[i];
+
+    // Store the quantity of elements
+    p_set->count = k;
+
+    // Clean up
+    SET_FREE(p_builds);
+    SET_FREE(p_scratch);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            failed_to_allocate:
+                #ifndef NDEBUG
+                    printf("[set] Failed to allocate elements in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_run:
+                #ifndef NDEBUG
+                    printf("[set] Failed to run worker threads in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_builds);
+                SET_FREE(p_scratch);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_builds);
+                SET_FREE(p_scratch);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+void set_init ( void )
+{
+
+    // State check
+    if ( initialized == true ) return;
+
+    // Initialize log
+    log_init();
+
+    // Initialize log
+    sync_init();
+
+    // Select the fastest set kernels
+    set_kernel_init();
+
+    // Set the initialized flag
+    initialized = true;
+
+    // Done
+    return;
+}
+
+int set_create ( set **const pp_set )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    set *p_set = SET_REALLOC(0, sizeof(set));
+
+    // Error checking
+    if ( p_set == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_set, 0, sizeof(set));
+
+    // Return the allocated memory
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_construct ( set **const pp_set, size_t size, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Allocate the set
+    if ( set_create(pp_set) == 0 ) goto failed_to_allocate_set;
+
+    // Get a pointer to the allocated set
+    p_set = *pp_set;
+
+    // Small sets store their elements inline
+    if ( size <= SET_INLINE_MAX )
+        p_set->elements = p_set->inline_elements,
+        p_set->max      = SET_INLINE_MAX;
+
+    // Larger sets allocate memory for their elements
+    else
+    {
+
+        // Set the maximum number of elements in the set
+        p_set->max = size;
+
+        // Allocate memory for set elements
+        p_set->elements = SET_REALLOC(0, size * sizeof(void *));
+
+        // Error checking
+        if ( p_set->elements == (void *) 0 ) goto no_mem;
+    }
+
+    // Create a reader/writer lock
+    set_rwlock_create(&p_set->_lock);
+
+    // If the caller supplied a function for testing equivalence ...
+    if ( pfn_is_equal )
+        
+        // ... set the function
+        p_set->pfn_is_equal = pfn_is_equal;
+    
+    // Default to '==' for comparing elements
+    else
+        p_set->pfn_is_equal = &equals_function;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_allocate_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_create\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_construct_hashed ( set **const pp_set, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Construct a set
+    if ( set_construct(pp_set, size, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Get a pointer to the allocated set
+    p_set = *pp_set;
+
+    // If the caller supplied a hashing function ...
+    if ( pfn_hash )
+
+        // ... set the function
+        p_set->pfn_hash = pfn_hash;
+
+    // Default to hashing the address of the element
+    else
+        p_set->pfn_hash = &hash_function;
+
+    // Allocate the index
+    if ( set_index_construct(&p_set->index, set_index_size(size)) == 0 ) goto failed_to_allocate_index;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_allocate_index:
+                #ifndef NDEBUG
+                    printf("[set] Failed to allocate index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(pp_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_construct_sorted ( set **const pp_set, size_t size, set_compare_fn *pfn_compare )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Default to comparing the addresses of elements
+    if ( pfn_compare == (void *) 0 ) pfn_compare = &compare_function;
+
+    // Construct a set. Comparators return zero for equal elements, so they double as equality functions
+    if ( set_construct(pp_set, size, (set_equal_fn *) pfn_compare) == 0 ) goto failed_to_construct_set;
+
+    // Get a pointer to the allocated set
+    p_set = *pp_set;
+
+    // Set the comparator
+    p_set->pfn_compare = pfn_compare;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_construct_roaring ( set **const pp_set )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+
+    // Construct a set. Elements live in the roaring bitmap, so the elements array stays empty
+    if ( set_construct(pp_set, 0, (void *) 0) == 0 ) goto failed_to_construct_set;
+
+    // Construct the roaring bitmap
+    if ( roaring_construct(&(*pp_set)->p_roaring) == 0 ) goto failed_to_construct_roaring;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_construct_roaring:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"roaring_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(pp_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_construct_bitset ( set **const pp_set, size_t universe_size )
+{
+
+    // Argument check
+    if ( pp_set        == (void *) 0 ) goto no_set;
+    if ( universe_size ==          0 ) goto no_universe;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Construct a set. Elements live in the bitset, so the elements array stays empty
+    if ( set_construct(pp_set, 0, (void *) 0) == 0 ) goto failed_to_construct_set;
+
+    // Get a pointer to the allocated set
+    p_set = *pp_set;
+
+    // Allocate a zeroed bitset
+    p_set->p_bits = SET_CALLOC(( universe_size + 63 ) / 64, sizeof(uint64_t));
+
+    // Error check
+    if ( p_set->p_bits == (void *) 0 ) goto no_mem;
+
+    // Store the universe size
+    p_set->universe = universe_size;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_universe:
+                #ifndef NDEBUG
+                    printf("[set] Parameter \"universe_size\" must be greater than zero in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(pp_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Add an element to a set that the caller has locked, with a hash that 
+ * was computed ahead of time
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * @param hash      the mixed hash of the element IF the set is hashed ELSE ignored
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_insert_hash ( set *const p_set, void *const p_element, unsigned long long hash )
+{
+
+    // Frozen sets are immutable
+    if ( p_set->p_frozen ) goto set_is_frozen;
+
+    // Roaring sets
+    if ( p_set->p_roaring )
+    {
+
+        // Roaring sets hold 32 bit integers
+        if ( (uintptr_t) p_element > UINT32_MAX ) goto element_out_of_range;
+
+        // Add the integer to the roaring bitmap
+        if ( roaring_add(p_set->p_roaring, (uint32_t) (uintptr_t) p_element) == 0 ) goto failed_to_add_to_roaring;
+
+        // Store the quantity of elements
+        p_set->count = roaring_count(p_set->p_roaring);
+
+        // Done
+        goto done;
+    }
+
+    // Bitset sets
+    if ( p_set->p_bits )
+    {
+
+        // Initialized data
+        uintptr_t i   = (uintptr_t) p_element;
+        uint64_t  bit = 1ULL << ( i & 63 );
+
+        // Bitset sets hold integers less than the universe size
+        if ( i >= p_set->universe ) goto element_out_of_range;
+
+        // Count the element, unless it is a duplicate
+        p_set->count += ( p_set->p_bits[i >> 6] & bit ) == 0;
+
+        // Set the bit
+        p_set->p_bits[i >> 6] |= bit;
+
+        // Done
+        goto done;
+    }
+
+    // If the set is full, grow the elements array
+    if ( p_set->count == p_set->max )
+        if ( set_grow(p_set) == 0 ) goto failed_to_grow_set;
+
+    // Hashed sets
+    if ( p_set->pfn_hash )
+    {
+
+        // Initialized data
+        set_index *p_index = (void *) 0;
+        size_t     slot    = 0;
+
+        // Continue rehashing
+        set_index_migrate(p_set, SET_REHASH_STEP);
+
+        // If the element is a duplicate, there is nothing to do
+        if ( set_hashed_find(p_set, p_element, hash, &p_index, &slot) != SET_INDEX_NOT_FOUND ) goto done;
+
+        // If the index is too full, start rehashing into a bigger one
+        if ( p_set->index.used + 1 > p_set->index.max / 4 * 3 )
+        {
+
+            // Grow the index
+            if ( set_index_grow(p_set) == 0 ) goto failed_to_grow_index;
+
+            // Find the insertion slot in the new index
+            (void)set_index_find(p_set, &p_set->index, p_element, hash, &slot);
+        }
+
+        // Account for the slot, unless it is a recycled tombstone
+        if ( p_set->index.p_slots[slot] == SET_INDEX_EMPTY ) p_set->index.used++;
+
+        // Store the position of the element
+        p_set->index.p_slots[slot] = p_set->count + 1;
+    }
+
+    // Sorted sets
+    else if ( p_set->pfn_compare )
+    {
+
+        // Initialized data
+        bool   found = false;
+        size_t i     = set_sorted_search(p_set, p_element, &found);
+
+        // If the element is a duplicate, there is nothing to do
+        if ( found ) goto done;
+
+        // Make room for the element
+        memmove(&p_set->elements[i + 1], &p_set->elements[i], ( p_set->count - i ) * sizeof(void *));
+
+        // Store the element
+        p_set->elements[i] = p_element;
+
+        // Increment the element quantity
+        p_set->count++;
+
+        // Done
+        goto done;
+    }
+
+    // Linear sets
+    else
+    {
+        
+        // If the element is a duplicate, there is nothing to do
+        if ( set_find(p_set, p_element) != SET_INDEX_NOT_FOUND ) goto done;
+    }
+    
+    // Store the element 
+    p_set->elements[p_set->count] = p_element;
+
+    // Increment the element quantity
+    p_set->count++;
+
+    done:
+
+    // Keep the Bloom filter, the sketch, and the signature in sync
+    set_filters_add(p_set, p_element);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Set errors
+        {
+            set_is_frozen:
+                #ifndef NDEBUG
+                    printf("[set] Can not add to a frozen set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            element_out_of_range:
+                #ifndef NDEBUG
+                    printf("[set] Element is out of range for roaring or bitset set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_add_to_roaring:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"roaring_add\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_grow_index:
+                #ifndef NDEBUG
+                    printf("[set] Failed to grow index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_grow_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to grow set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Add an element to a set that the caller has locked
+ * 
+ * @param p_set     the set
+ * @param p_element the element
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_insert ( set *const p_set, void *const p_element )
+{
+
+    // Hash the element, IF the set is hashed
+    return set_insert_hash(p_set, p_element, ( p_set->pfn_hash ) ? set_hash(p_set, p_element) : 0);
+}
+
+int set_from_elements ( set **const pp_set, const void **const pp_elements, size_t size, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Elements compared by address are deduplicated through a temporary 
+    // index, on worker threads, and the index is dropped afterwards
+    if ( pfn_is_equal == (void *) 0 )
+    {
+
+        // Construct a hashed set
+        if ( set_construct_hashed(&p_set, size, (void *) 0, (void *) 0) == 0 ) goto failed_to_construct_set;
+
+        // Fill the set
+        if ( set_build_hashed(p_set, pp_elements, size, 0) == 0 ) goto failed_to_build_set;
+
+        // Drop the index
+        SET_FREE(p_set->index.p_slots);
+        memset(&p_set->index, 0, sizeof(set_index));
+        p_set->pfn_hash = (void *) 0;
+
+        // Return a pointer to the set to the caller
+        *pp_set = p_set;
+
+        // Success
+        return 1;
+    }
+
+    // Construct a set
+    if ( set_construct(pp_set, size, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Get a pointer to the allocated set
+    p_set = *pp_set;
+
+    // Iterate over each element
+    for (size_t i = 0; i < size; i++)
+    {
+        
+        // Add the element to the set. No other thread can see the set yet, so it is not locked
+        if ( set_insert(p_set, (void *) pp_elements[i]) == 0 ) goto no_mem;
+    }
+    
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_from_elements\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_build_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to fill set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(pp_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_from_elements_hashed ( set **const pp_set, const void **const pp_elements, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash, size_t threads )
+{
+
+    // Argument check
+    if ( pp_set      == (void *) 0          ) goto no_set;
+    if ( pp_elements == (void *) 0 && size ) goto no_elements;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Construct a set
+    if ( set_construct_hashed(&p_set, size, pfn_is_equal, pfn_hash) == 0 ) goto failed_to_construct_set;
+
+    // Fill the set, on worker threads
+    if ( set_build_hashed(p_set, pp_elements, size, threads) == 0 ) goto failed_to_build_set;
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_elements:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_elements\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_build_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to fill set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_from_elements_sorted ( set **const pp_set, const void **const pp_elements, size_t size, set_compare_fn *pfn_compare, size_t threads )
+{
+
+    // Argument check
+    if ( pp_set      == (void *) 0          ) goto no_set;
+    if ( pp_elements == (void *) 0 && size ) goto no_elements;
+
+    // Initialized data
+    set *p_set = (void *) 0;
+
+    // Construct a set
+    if ( set_construct_sorted(&p_set, size, pfn_compare) == 0 ) goto failed_to_construct_set;
+
+    // Fill the set, on worker threads
+    if ( set_build_sorted(p_set, pp_elements, size, threads) == 0 ) goto failed_to_build_set;
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_elements:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_elements\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_build_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to fill set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_contents ( const set *const p_set, void **const pp_contents )
+{
+
+    // Argument check
+    if ( p_set       == (void *) 0 ) goto no_set;
+
+    // Count branch
+    if ( pp_contents == (void *) 0 ) goto return_count;
+
+
+    // Lock
+    set_rwlock_read_lock((set_rwlock *) &p_set->_lock);
+
+    // Copy the elements
+    if      ( p_set->p_roaring ) (void)roaring_contents(p_set->p_roaring, pp_contents);
+    else if ( p_set->p_bits    ) (void)set_bitset_contents(p_set, pp_contents);
+    else if ( p_set->p_frozen  ) (void)frozen_contents(p_set->p_frozen, pp_contents);
+    else                         memcpy(pp_contents, p_set->elements, sizeof(void *) * p_set->count);
+
+    // Unlock
+    set_rwlock_read_unlock((set_rwlock *) &p_set->_lock);
+    
+    // Success
+    return 1;
+
+    // Count branch
+    return_count:
+
+        // Success. The count is read under the lock
+        return set_count(p_set);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_add ( set *const p_set, void *const p_element )
+{
+
+    // Argument check
+    if ( p_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    int result = 0;
+
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
+
+    // Add the element
+    result = set_insert(p_set, p_element);
+
+    // Unlock
+    set_rwlock_write_unlock(&p_set->_lock);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_add_many ( set *const p_set, void *const *const pp_elements, size_t count )
+{
+
+    // Argument check
+    if ( p_set       == (void *) 0           ) goto no_set;
+    if ( pp_elements == (void *) 0 && count ) goto no_elements;
+
+    // Initialized data
+    void **pp_sorted = (void *) 0;
+
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
+
+    // Frozen sets are immutable
+    if ( p_set->p_frozen ) goto set_is_frozen;
+
+    // Sorted sets with the default comparator merge a sorted copy of the batch in one pass
+    if ( p_set->pfn_compare == &compare_function && count > 1 )
+    {
+
+        // Initialized data
+        size_t k = 0;
+
+        // Allocate memory for a copy of the batch
+        pp_sorted = SET_REALLOC(0, count * sizeof(void *));
+
+        // Error check
+        if ( pp_sorted == (void *) 0 ) goto no_mem;
+
+        // Sort the copy, and drop duplicates
+        memcpy(pp_sorted, pp_elements, count * sizeof(void *));
+        qsort(pp_sorted, count, sizeof(void *), &set_qsort_compare);
+        for (size_t i = 0; i < count; i++) if ( k == 0 || pp_sorted[k - 1] != pp_sorted[i] ) pp_sorted[k++] = pp_sorted[i];
+
+        // Grow geometrically, so a stream of batches does not reallocate for every batch
+        if ( p_set->count + k > p_set->max && set_reserve(p_set, ( p_set->count + k > 2 * p_set->max ) ? p_set->count + k : 2 * p_set->max) == 0 ) goto failed_to_grow_set;
+
+        // Merge
+        if ( set_sorted_merge_update(p_set, pp_sorted, k) == 0 ) goto failed_to_grow_set;
+
+        // Keep the Bloom filter, the sketch, and the signature in sync
+        for (size_t i = 0; i < k; i++) set_filters_add(p_set, pp_sorted[i]);
+
+        // Clean up
+        SET_FREE(pp_sorted);
+
+        // Done
+        goto done;
+    }
+
+    // Hashed sets
+    if ( p_set->pfn_hash )
+    {
+
+        // Make room for every element at once, so adding them never rehashes. Grow 
+        // geometrically, so a stream of batches does not reallocate for every batch
+        if ( p_set->count + count > p_set->max && set_reserve(p_set, ( p_set->count + count > 2 * p_set->max ) ? p_set->count + count : 2 * p_set->max) == 0 ) goto failed_to_grow_set;
+        if ( p_set->index.max / 4 * 3 < p_set->index.used + count && set_index_rebuild(p_set, 2 * ( p_set->count + count )) == 0 ) goto failed_to_grow_set;
+
+        // Add each block of keys
+        for (size_t i = 0; i < count; i += SET_BATCH)
+        {
+
+            // Initialized data
+            unsigned long long hashes[SET_BATCH];
+            size_t             n = ( count - i < SET_BATCH ) ? count - i : SET_BATCH;
+
+            // Hash every key in the block up front
+            for (size_t j = 0; j < n; j++) hashes[j] = set_hash(p_set, pp_elements[i + j]);
+
+            // Add each key, while the slots of later keys load
+            for (size_t j = 0; j < n; j++)
+            {
+
+                // Prefetch
+                if ( j + SET_PREFETCH_DISTANCE < n ) __builtin_prefetch(&p_set->index.p_slots[hashes[j + SET_PREFETCH_DISTANCE] & ( p_set->index.max - 1 )]);
+
+                // Add the element
+                if ( set_insert_hash(p_set, pp_elements[i + j], hashes[j]) == 0 ) goto failed_to_add;
+            }
+        }
+
+        // Done
+        goto done;
+    }
+
+    // Add each element
+    for (size_t i = 0; i < count; i++)
+        if ( set_insert(p_set, pp_elements[i]) == 0 ) goto failed_to_add;
+
+    done:
+
+    // Unlock
+    set_rwlock_write_unlock(&p_set->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_elements:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_elements\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            set_is_frozen:
+                #ifndef NDEBUG
+                    printf("[set] Can not add to a frozen set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_grow_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to grow set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(pp_sorted);
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_add:
+                #ifndef NDEBUG
+                    printf("[set] Failed to add element in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Compute the union of two sets. The caller holds the read lock of each set
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_union_unlocked ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Roaring sets and bitset sets
+    if ( set_is_compact(p_a) || set_is_compact(p_b) ) return set_compact_operation(pp_set, p_a, p_b, pfn_is_equal, SET_MERGE_A | SET_MERGE_AB | SET_MERGE_B, &roaring_union, &set_union_unlocked);
+
+    // Initialized data
+    set    *p_set        = 0;
+    size_t  max_set_size = p_a->count + p_b->count;
+    
+    // Construct a set
+    if ( set_construct_like(&p_set, max_set_size, p_a, p_b, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Sorted sets are merged in one pass
+    if ( set_is_mergeable(p_a, p_b) )
+        set_sorted_merge(p_set, p_a, p_b, SET_MERGE_A | SET_MERGE_AB | SET_MERGE_B);
+
+    // Default
+    else
+    {
+
+        // Iterate through set a
+        for (size_t i = 0; i < p_a->count; i++)
+
+            // Add each element to the new set
+            set_add(p_set, p_a->elements[i]);
+        
+        // Iterate through set b
+        for (size_t i = 0; i < p_b->count; i++)
+
+            // Add each element to the new set
+            set_add(p_set, p_b->elements[i]);
+    }
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_union ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the union
+    result = set_union_unlocked(pp_set, p_a, p_b, pfn_is_equal);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Compute the difference of two sets. The caller holds the read lock of each set
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_difference_unlocked ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Roaring sets and bitset sets
+    if ( set_is_compact(p_a) || set_is_compact(p_b) ) return set_compact_operation(pp_set, p_a, p_b, pfn_is_equal, SET_MERGE_A, &roaring_difference, &set_difference_unlocked);
+
+    // Initialized data
+    set    *p_set        = 0;
+    size_t  max_set_size = p_a->count;
+    
+    // Construct a set
+    if ( set_construct_like(&p_set, max_set_size, p_a, p_b, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Sorted sets are merged in one pass
+    if ( set_is_mergeable(p_a, p_b) )
+        set_sorted_merge(p_set, p_a, p_b, SET_MERGE_A);
+
+    // Default
+    else
+
+        // Iterate through set a
+        for (size_t i = 0; i < p_a->count; i++)
+
+            // If a[i] is not in b, add it to the new set
+            if ( set_has(p_b, p_a->elements[i], pfn_is_equal) == false ) set_add(p_set, p_a->elements[i]);
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_difference ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the difference
+    result = set_difference_unlocked(pp_set, p_a, p_b, pfn_is_equal);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Compute the intersection of two sets. The caller holds the read lock of each set
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_intersection_unlocked ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Frozen sets intersect without thawing
+    if ( p_a->p_frozen && p_b->p_frozen )
+    {
+
+        // Initialized data
+        set *p_set = (void *) 0;
+
+        // Construct a sorted set with room for the smaller operand
+        if ( set_construct_sorted(&p_set, ( p_a->count < p_b->count ) ? p_a->count : p_b->count, (void *) 0) == 0 ) goto failed_to_construct_set;
+
+        // Leapfrog through the skip tables
+        p_set->count = frozen_intersection(p_a->p_frozen, p_b->p_frozen, p_set->elements);
+
+        // Return a pointer to the caller
+        *pp_set = p_set;
+
+        // Success
+        return 1;
+    }
+
+    // Roaring sets, bitset sets, and frozen sets
+    if ( set_is_compact(p_a) || set_is_compact(p_b) ) return set_compact_operation(pp_set, p_a, p_b, pfn_is_equal, SET_MERGE_AB, &roaring_intersection, &set_intersection_unlocked);
+
+    // Initialized data
+    set    *p_set        = 0;
+    size_t  max_set_size = ( p_a->count < p_b->count ) ? p_a->count : p_b->count;
+    
+    // Construct a set
+    if ( set_construct_like(&p_set, max_set_size, p_a, p_b, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Sorted sets of skewed sizes are intersected by galloping through the larger set
+    if ( set_is_mergeable(p_a, p_b) && set_is_skewed(p_a, p_b) )
+        set_sorted_gallop_intersection(p_set, p_a, p_b);
+
+    // Sorted sets are merged in one pass
+    else if ( set_is_mergeable(p_a, p_b) )
+        set_sorted_merge(p_set, p_a, p_b, SET_MERGE_AB);
+
+    // Default
+    else
+
+        // Iterate through set a
+        for (size_t i = 0; i < p_a->count; i++)
+
+            // If a[i] is in b, add it to the new set
+            if ( set_has(p_b, p_a->elements[i], pfn_is_equal) ) set_add(p_set, p_a->elements[i]);
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_intersection ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the intersection
+    result = set_intersection_unlocked(pp_set, p_a, p_b, pfn_is_equal);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Compute the symmetric difference of two sets. The caller holds the read lock of each set
+ * 
+ * @param pp_set       return
+ * @param p_a          set A
+ * @param p_b          set B
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_symmetric_difference_unlocked ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Roaring sets and bitset sets
+    if ( set_is_compact(p_a) || set_is_compact(p_b) ) return set_compact_operation(pp_set, p_a, p_b, pfn_is_equal, SET_MERGE_A | SET_MERGE_B, &roaring_symmetric_difference, &set_symmetric_difference_unlocked);
+
+    // Initialized data
+    set    *p_set        = 0;
+    size_t  max_set_size = p_a->count + p_b->count;
+    
+    // Construct a set
+    if ( set_construct_like(&p_set, max_set_size, p_a, p_b, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Sorted sets are merged in one pass
+    if ( set_is_mergeable(p_a, p_b) )
+        set_sorted_merge(p_set, p_a, p_b, SET_MERGE_A | SET_MERGE_B);
+
+    // Default
+    else
+    {
+
+        // Iterate through set a
+        for (size_t i = 0; i < p_a->count; i++)
+
+            // If a[i] is not in b, add it to the new set
+            if ( set_has(p_b, p_a->elements[i], pfn_is_equal) == false ) set_add(p_set, p_a->elements[i]);
+        
+        // Iterate through set b
+        for (size_t i = 0; i < p_b->count; i++)
+
+            // If b[i] is not in a, add it to the new set
+            if ( set_has(p_a, p_b->elements[i], pfn_is_equal) == false ) set_add(p_set, p_b->elements[i]);
+    }
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_symmetric_difference ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the symmetric difference
+    result = set_symmetric_difference_unlocked(pp_set, p_a, p_b, pfn_is_equal);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Compute the union of any quantity of sets. The caller holds the read lock of each set
+ * 
+ * @param pp_set       return
+ * @param pp_sets      the sets
+ * @param count        the quantity of sets
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_union_n_unlocked ( set **const pp_set, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set  == (void *) 0 ) goto no_set;
+    if ( pp_sets == (void *) 0 ) goto no_sets;
+    if ( count   == 0          ) goto no_operands;
+    for (size_t i = 0; i < count; i++) if ( pp_sets[i] == (void *) 0 ) goto no_operand;
+
+    // Initialized data
+    set    *p_set = (void *) 0;
+    size_t  total = 0;
+
+    // Count every element of every operand
+    for (size_t i = 0; i < count; i++) total += pp_sets[i]->count;
+
+    // Construct the result, with room for every element
+    if ( set_construct_like_n(&p_set, ( total ) ? total : 1, pp_sets, count, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Sorted sets are merged in one pass, with a heap
+    if ( p_set->pfn_compare )
+    {
+        if ( set_reserve(p_set, total) == 0 ) goto failed_to_update_set;
+        if ( set_sorted_union_n(p_set, pp_sets, count) == 0 ) goto failed_to_update_set;
+    }
+
+    // Other sets are added to the result, which already has room for them
+    else
+        for (size_t i = 0; i < count; i++)
+            if ( set_update_unlocked(p_set, pp_sets[i]) == 0 ) goto failed_to_update_set;
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_sets:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_sets\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_operands:
+                #ifndef NDEBUG
+                    printf("[set] Parameter \"count\" must be positive in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_operand:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for an element of parameter \"pp_sets\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_update_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to add an operand to the result in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_union_n ( set **const pp_set, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock every set for reading
+    set_read_lock_sets(pp_sets, count, true);
+
+    // Compute the union
+    result = set_union_n_unlocked(pp_set, pp_sets, count, pfn_is_equal);
+
+    // Unlock
+    set_read_lock_sets(pp_sets, count, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Compute the intersection of any quantity of sets. The caller holds the read lock of each set
+ * 
+ * @param pp_set       return
+ * @param pp_sets      the sets
+ * @param count        the quantity of sets
+ * @param pfn_is_equal function for testing equality of elements in set IF parameter is not null ELSE default
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_intersection_n_unlocked ( set **const pp_set, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal )
+{
+
+    // Argument check
+    if ( pp_set  == (void *) 0 ) goto no_set;
+    if ( pp_sets == (void *) 0 ) goto no_sets;
+    if ( count   == 0          ) goto no_operands;
+    for (size_t i = 0; i < count; i++) if ( pp_sets[i] == (void *) 0 ) goto no_operand;
+
+    // Initialized data
+    set        *p_set    = (void *) 0;
+    const set **pp_order = SET_REALLOC(0, count * sizeof(set *));
+
+    // Error check
+    if ( pp_order == (void *) 0 ) goto no_mem;
+
+    // Process the operands smallest first, so the result starts, and stays, small
+    memcpy(pp_order, pp_sets, count * sizeof(set *));
+    set_sort_by_count(pp_order, count);
+
+    // Construct the result, with room for every element of the smallest operand
+    if ( set_construct_like_n(&p_set, ( pp_order[0]->count ) ? pp_order[0]->count : 1, pp_sets, count, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+
+    // Start from the smallest operand
+    if ( set_update_unlocked(p_set, pp_order[0]) == 0 ) goto failed_to_update_set;
+
+    // Intersect the result with each larger operand, in place, until it is empty
+    for (size_t i = 1; i < count && p_set->count; i++)
+        if ( set_intersection_update_unlocked(p_set, pp_order[i]) == 0 ) goto failed_to_update_set;
+
+    // Clean up
+    SET_FREE(pp_order);
+
+    // Return a pointer to the set to the caller
+    *pp_set = p_set;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_sets:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_sets\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_operands:
+                #ifndef NDEBUG
+                    printf("[set] Parameter \"count\" must be positive in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_operand:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for an element of parameter \"pp_sets\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_construct_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(pp_order);
+
+                // Error
+                return 0;
+
+            failed_to_update_set:
+                #ifndef NDEBUG
+                    printf("[set] Failed to intersect an operand with the result in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(pp_order);
+                set_destroy(&p_set);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_intersection_n ( set **const pp_set, const set *const *const pp_sets, size_t count, set_equal_fn *pfn_is_equal )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock every set for reading
+    set_read_lock_sets(pp_sets, count, true);
+
+    // Compute the intersection
+    result = set_intersection_n_unlocked(pp_set, pp_sets, count, pfn_is_equal);
+
+    // Unlock
+    set_read_lock_sets(pp_sets, count, false);
+
+    // Done
+    return result;
+}
+
+int set_union_parallel ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the set operation on worker threads
+    result = set_parallel_operation(pp_set, p_a, p_b, pfn_is_equal, threads, SET_MERGE_A | SET_MERGE_AB | SET_MERGE_B, &set_union_unlocked);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_difference_parallel ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the set operation on worker threads
+    result = set_parallel_operation(pp_set, p_a, p_b, pfn_is_equal, threads, SET_MERGE_A, &set_difference_unlocked);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_intersection_parallel ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal, size_t threads )
+{
+
+    // Argument check
+    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a    == (void *) 0 ) goto no_a;
+    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Initialized data
+    int result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Compute the set operation on worker threads
+    result = set_parallel_operation(pp_set, p_a, p_b, pfn_is_equal, threads, SET_MERGE_AB, &set_intersection_unlocked);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Test if two sets have no elements in common. The caller holds the read lock of each set
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return true IF the sets are disjoint ELSE false
+ */
+static bool set_isdisjoint_unlocked ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+
+    // An empty set is disjoint from every set
+    if ( p_a->count == 0 || p_b->count == 0 ) return true;
+
+    // Roaring sets
+    if ( p_a->p_roaring && p_b->p_roaring ) return roaring_isdisjoint(p_a->p_roaring, p_b->p_roaring);
+
+    // Frozen sets
+    if ( p_a->p_frozen && p_b->p_frozen ) return frozen_isdisjoint(p_a->p_frozen, p_b->p_frozen);
+
+    // Bitset sets
+    if ( p_a->p_bits && p_b->p_bits )
+    {
+
+        // Initialized data
+        size_t   words = ( ( ( p_a->universe < p_b->universe ) ? p_a->universe : p_b->universe ) + 63 ) / 64;
+        uint64_t any   = 0;
+
+        // Accumulate the common bits
+        for (size_t i = 0; i < words; i++) any |= p_a->p_bits[i] & p_b->p_bits[i];
+
+        // Done
+        return any == 0;
+    }
+
+    // Sorted sets. A frozen sorted set keeps its comparator, but not its elements
+    if ( set_is_mergeable(p_a, p_b) && p_a->p_frozen == (void *) 0 && p_b->p_frozen == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i = 0,
+               j = 0;
+
+        // Sorted sets of skewed sizes are tested by galloping through the larger set
+        if ( set_is_skewed(p_a, p_b) ) return set_sorted_gallop_intersection((void *) 0, p_a, p_b) == 0;
+
+        // Merge, stopping at the first common element
+        while ( i < p_a->count && j < p_b->count )
+        {
+
+            // Initialized data
+            int c = p_a->pfn_compare(p_a->elements[i], p_b->elements[j]);
+
+            // Common element
+            if ( c == 0 ) return false;
+
+            // Advance the lesser element
+            if ( c < 0 ) i++;
+            else         j++;
+        }
+
+        // No common elements
+        return true;
+    }
+
+    // Look up each element of the smaller set in the larger set
+    {
+
+        // Initialized data
+        const set *p_small = ( p_a->count < p_b->count ) ? p_a : p_b,
+                  *p_large = ( p_a->count < p_b->count ) ? p_b : p_a;
+
+        set       *p_sorted = (void *) 0;
+        bool       result   = true;
+
+        // The elements of roaring sets and bitset sets are looked up, not iterated
+        if ( set_is_compact(p_small) ) p_small = p_large, p_large = ( p_small == p_a ) ? p_b : p_a;
+
+        // IF both sets are compact, iterate a sorted copy
+        if ( set_is_compact(p_small) )
+        {
+            if ( set_sorted_copy(&p_sorted, p_small) == 0 ) return false;
+            p_small = p_sorted;
+        }
+
+        // Iterate over each element of the smaller set
+        for (size_t i = 0; i < p_small->count && result; i++)
+
+            // Common element
+            if ( set_has(p_large, p_small->elements[i], (void *) 0) ) result = false;
+
+        // Clean up
+        if ( p_sorted ) set_destroy(&p_sorted);
+
+        // Done
+        return result;
+    }
+
+    // No common elements
+    return true;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+bool set_isdisjoint ( const set *const p_a, const set *const p_b )
+{
+
+    // Initialized data
+    bool result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Test
+    result = set_isdisjoint_unlocked(p_a, p_b);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Test if every element of set A is in set B. The caller holds the read lock of each set
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return true IF set A is a subset of set B ELSE false
+ */
+static bool set_issubset_unlocked ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+
+    // The empty set is a subset of every set, and a larger set is never a subset
+    if ( p_a->count == 0        ) return true;
+    if ( p_a->count > p_b->count ) return false;
+
+    // Roaring sets
+    if ( p_a->p_roaring && p_b->p_roaring ) return roaring_issubset(p_a->p_roaring, p_b->p_roaring);
+
+    // Frozen sets
+    if ( p_a->p_frozen && p_b->p_frozen ) return frozen_issubset(p_a->p_frozen, p_b->p_frozen);
+
+    // Bitset sets
+    if ( p_a->p_bits && p_b->p_bits )
+    {
+
+        // Initialized data
+        size_t a_words = ( p_a->universe + 63 ) / 64,
+               b_words = ( p_b->universe + 63 ) / 64;
+
+        // Every bit of set A must be set in set B, and set B has no bits past its universe
+        for (size_t i = 0; i < a_words; i++)
+            if ( p_a->p_bits[i] & ~( ( i < b_words ) ? p_b->p_bits[i] : 0 ) ) return false;
+
+        // Every element of set A is in set B
+        return true;
+    }
+
+    // Sorted sets. A frozen sorted set keeps its comparator, but not its elements
+    if ( set_is_mergeable(p_a, p_b) && p_a->p_frozen == (void *) 0 && p_b->p_frozen == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t j = 0;
+
+        // Iterate over each element of set A, stopping at the first one that is missing
+        for (size_t i = 0; i < p_a->count; i++)
+        {
+
+            // Initialized data
+            bool found = false;
+
+            // Set B is much larger, so gallop
+            if ( set_is_skewed(p_a, p_b) ) j = set_sorted_gallop(p_b, j, p_a->elements[i], &found);
+
+            // Skip the lesser elements of set B
+            else
+            {
+                while ( j < p_b->count && p_a->pfn_compare(p_b->elements[j], p_a->elements[i]) < 0 ) j++;
+                found = j < p_b->count && p_a->pfn_compare(p_b->elements[j], p_a->elements[i]) == 0;
+            }
+
+            // Missing element
+            if ( found == false ) return false;
+
+            // Next element
+            j++;
+
+            // Set B has too few elements left
+            if ( p_a->count - i - 1 > p_b->count - j ) return false;
+        }
+
+        // Every element of set A is in set B
+        return true;
+    }
+
+    // Look up each element of set A in set B
+    {
+
+        // Initialized data
+        const set *p_iterate = p_a;
+        set       *p_sorted  = (void *) 0;
+        bool       result    = true;
+
+        // IF set A is compact, iterate a sorted copy
+        if ( set_is_compact(p_a) )
+        {
+            if ( set_sorted_copy(&p_sorted, p_a) == 0 ) return false;
+            p_iterate = p_sorted;
+        }
+
+        // Iterate over each element of set A, stopping at the first one that is missing
+        for (size_t i = 0; i < p_iterate->count && result; i++)
+            if ( set_has(p_b, p_iterate->elements[i], (void *) 0) == false ) result = false;
+
+        // Clean up
+        if ( p_sorted ) set_destroy(&p_sorted);
+
+        // Done
+        return result;
+    }
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+bool set_issubset ( const set *const p_a, const set *const p_b )
+{
+
+    // Initialized data
+    bool result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Test
+    result = set_issubset_unlocked(p_a, p_b);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+bool set_issuperset ( const set *const p_a, const set *const p_b )
+{
+
+    // Set A is a superset of set B IF set B is a subset of set A
+    return set_issubset(p_b, p_a);
+}
+
+/** !
+ * Count the elements that two sets have in common. The caller holds the read lock of each set
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return the quantity of common elements
+ */
+static size_t set_intersection_count_unlocked ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+
+    // Roaring sets
+    if ( p_a->p_roaring && p_b->p_roaring ) return roaring_intersection_count(p_a->p_roaring, p_b->p_roaring);
+
+    // Frozen sets
+    if ( p_a->p_frozen && p_b->p_frozen ) return frozen_intersection(p_a->p_frozen, p_b->p_frozen, (void *) 0);
+
+    // Bitset sets
+    if ( p_a->p_bits && p_b->p_bits )
+    {
+
+        // Initialized data
+        size_t words = ( ( ( p_a->universe < p_b->universe ) ? p_a->universe : p_b->universe ) + 63 ) / 64,
+               count = 0;
+
+        // Count the common bits
+        for (size_t i = 0; i < words; i++) count += (size_t) __builtin_popcountll(p_a->p_bits[i] & p_b->p_bits[i]);
+
+        // Done
+        return count;
+    }
+
+    // Sorted sets. A frozen sorted set keeps its comparator, but not its elements
+    if ( set_is_mergeable(p_a, p_b) && p_a->p_frozen == (void *) 0 && p_b->p_frozen == (void *) 0 )
+    {
+
+        // Initialized data
+        size_t i     = 0,
+               j     = 0,
+               count = 0;
+
+        // Sorted sets of skewed sizes are counted by galloping through the larger set
+        if ( set_is_skewed(p_a, p_b) )
+        {
+
+            // Initialized data
+            const set *p_small = ( p_a->count < p_b->count ) ? p_a : p_b,
+                      *p_large = ( p_a->count < p_b->count ) ? p_b : p_a;
+
+            // Gallop forward through the larger set, once for each element of the smaller set
+            for (i = 0; i < p_small->count && j < p_large->count; i++)
+            {
+
+                // Initialized data
+                bool found = false;
+
+                // Gallop
+                j = set_sorted_gallop(p_large, j, p_small->elements[i], &found);
+
+                // Count the common element
+                count += found;
+            }
+
+            // Done
+            return count;
+        }
+
+        // The default comparator orders elements as unsigned integers, which the kernels count in vectors
+        if ( p_a->pfn_compare == &compare_function )
+        {
+            if ( sizeof(void *) == sizeof(uint64_t) ) return set_kernel_intersection_count_u64((const uint64_t *) p_a->elements, p_a->count, (const uint64_t *) p_b->elements, p_b->count);
+            if ( sizeof(void *) == sizeof(uint32_t) ) return set_kernel_intersection_count_u32((const uint32_t *) p_a->elements, p_a->count, (const uint32_t *) p_b->elements, p_b->count);
+        }
+
+        // Merge
+        while ( i < p_a->count && j < p_b->count )
+        {
+
+            // Initialized data
+            int c = p_a->pfn_compare(p_a->elements[i], p_b->elements[j]);
+
+            // Advance the lesser element, or both
+            if      ( c < 0 ) i++;
+            else if ( c > 0 ) j++;
+            else              count++, i++, j++;
+        }
+
+        // Done
+        return count;
+    }
+
+    // Look up each element of the smaller set in the larger set
+    {
+
+        // Initialized data
+        const set *p_small = ( p_a->count < p_b->count ) ? p_a : p_b,
+                  *p_large = ( p_a->count < p_b->count ) ? p_b : p_a;
+
+        set       *p_sorted = (void *) 0;
+        size_t     count    = 0;
+
+        // The elements of compact sets are looked up, not iterated
+        if ( set_is_compact(p_small) ) p_small = p_large, p_large = ( p_small == p_a ) ? p_b : p_a;
+
+        // IF both sets are compact, iterate a sorted copy
+        if ( set_is_compact(p_small) )
+        {
+            if ( set_sorted_copy(&p_sorted, p_small) == 0 ) return 0;
+            p_small = p_sorted;
+        }
+
+        // Count each element of the smaller set that is in the larger set
+        for (size_t i = 0; i < p_small->count; i++)
+            count += set_has(p_large, p_small->elements[i], (void *) 0);
+
+        // Clean up
+        if ( p_sorted ) set_destroy(&p_sorted);
+
+        // Done
+        return count;
+    }
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+size_t set_intersection_count ( const set *const p_a, const set *const p_b )
+{
+
+    // Initialized data
+    size_t result = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Count
+    result = set_intersection_count_unlocked(p_a, p_b);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+size_t set_union_count ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return 0;
+    if ( p_b == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t count = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Inclusion and exclusion
+    count = p_a->count + p_b->count - set_intersection_count_unlocked(p_a, p_b);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return count;
+}
+
+size_t set_difference_count ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return 0;
+    if ( p_b == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t count = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Every element of set A that is not in set B
+    count = p_a->count - set_intersection_count_unlocked(p_a, p_b);
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return count;
+}
+
+double set_jaccard ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return -1;
+    if ( p_b == (void *) 0 ) return -1;
+
+    // Initialized data
+    size_t common = 0,
+           all    = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Count the common elements, and every element
+    common = set_intersection_count_unlocked(p_a, p_b),
+    all    = p_a->count + p_b->count - common;
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return ( all ) ? (double) common / (double) all : 0;
+}
+
+double set_overlap_coefficient ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) return -1;
+    if ( p_b == (void *) 0 ) return -1;
+
+    // Initialized data
+    size_t smaller = 0,
+           common  = 0;
+
+    // Lock both sets for reading
+    set_read_lock_pair(p_a, p_b, true);
+
+    // Count the common elements, and the elements of the smaller set
+    smaller = ( p_a->count < p_b->count ) ? p_a->count : p_b->count,
+    common  = ( smaller ) ? set_intersection_count_unlocked(p_a, p_b) : 0;
+
+    // Unlock
+    set_read_lock_pair(p_a, p_b, false);
+
+    // Done
+    return ( smaller ) ? (double) common / (double) smaller : 0;
+}
+
+size_t set_count ( const set *const p_set )
+{
+    
+    // Argument check
+    if ( p_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    size_t count = 0;
+
+    // Read the count under the lock, so it is never read in the middle of a write
+    set_rwlock_read_lock((set_rwlock *) &p_set->_lock);
+    count = p_set->count;
+    set_rwlock_read_unlock((set_rwlock *) &p_set->_lock);
+
+    // Return
+    return count;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool set_contains ( const set *const p_set, const void *const p_element )
+{
+
+    // Argument check
+    if ( p_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    bool result = false;
+
+    // Lock
+    set_rwlock_read_lock((set_rwlock *) &p_set->_lock);
+
+    // Most misses stop at the Bloom filter
+    if ( p_set->p_bloom && set_bloom_test(p_set->p_bloom, p_set->bloom_blocks, set_element_hash(p_set, p_element)) == false ) goto done;
+
+    // Search the set
+    result = set_has(p_set, p_element, (void *) 0);
+
+    done:
+
+    // Unlock
+    set_rwlock_read_unlock((set_rwlock *) &p_set->_lock);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return false;
+        }
+    }
+}
+
+size_t set_contains_many ( const set *const p_set, const void *const *const pp_elements, size_t count, bool *const p_results )
+{
+
+    // Argument check
+    if ( p_set       == (void *) 0           ) goto no_set;
+    if ( pp_elements == (void *) 0 && count ) goto no_elements;
+
+    // Initialized data
+    size_t result = 0;
+
+    // Lock
+    set_rwlock_read_lock((set_rwlock *) &p_set->_lock);
+
+    // Test each block of keys
+    for (size_t i = 0; i < count; i += SET_BATCH)
+    {
+
+        // Initialized data
+        unsigned long long hashes[SET_BATCH];
+        size_t             n = ( count - i < SET_BATCH ) ? count - i : SET_BATCH;
+
+        // Hash every key in the block up front, IF the set or its Bloom filter uses hashes
+        if ( p_set->pfn_hash || p_set->p_bloom )
+            for (size_t j = 0; j < n; j++) hashes[j] = set_element_hash(p_set, pp_elements[i + j]);
+
+        // Test each key
+        for (size_t j = 0; j < n; j++)
+        {
+
+            // Initialized data
+            const void *p_element = pp_elements[i + j];
+            bool        found     = false;
+
+            // Prefetch the Bloom filter block, and the index slot, of a later key
+            if ( j + SET_PREFETCH_DISTANCE < n )
+            {
+
+                // Initialized data
+                unsigned long long hash = hashes[j + SET_PREFETCH_DISTANCE];
+
+                // Prefetch
+                if ( p_set->p_bloom  ) __builtin_prefetch(&p_set->p_bloom[( ( hash >> 32 ) * p_set->bloom_blocks >> 32 ) * 8]);
+                if ( p_set->pfn_hash ) __builtin_prefetch(&p_set->index.p_slots[hash & ( p_set->index.max - 1 )]);
+            }
+
+            // Most misses stop at the Bloom filter
+            if ( p_set->p_bloom && set_bloom_test(p_set->p_bloom, p_set->bloom_blocks, hashes[j]) == false ) found = false;
+
+            // Hashed sets search their index with the hash
+            else if ( p_set->pfn_hash && set_is_compact(p_set) == false ) found = set_hashed_find(p_set, p_element, hashes[j], (void *) 0, (void *) 0) != SET_INDEX_NOT_FOUND;
+
+            // Search the set
+            else found = set_has(p_set, p_element, (void *) 0);
+
+            // Store the result
+            if ( p_results ) p_results[i + j] = found;
+
+            // Count the elements that are in the set
+            result += found;
+        }
+    }
+
+    // Unlock
+    set_rwlock_read_unlock((set_rwlock *) &p_set->_lock);
+
+    // Done
+    return result;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_elements:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"pp_elements\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_enable_bloom ( set *const p_set )
+{
+
+    // Argument check
+    if ( p_set == (void *) 0 ) goto no_set;
+
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
+
+    // State check
+    if ( set_is_compact(p_set) ) goto set_is_compact;
+    if ( p_set->pfn_hash == (void *) 0 && p_set->pfn_is_equal != &equals_function && p_set->pfn_is_equal != (set_equal_fn *) &compare_function ) goto no_hash;
+
+    // Build the Bloom filter, with room to grow
+    if ( set_bloom_build(p_set, ( p_set->count * 2 > 64 ) ? p_set->count * 2 : 64) == 0 ) goto failed_to_build;
+
+    // Unlock
+    set_rwlock_write_unlock(&p_set->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            set_is_compact:
+                #ifndef NDEBUG
+                    printf("[set] Roaring, bitset, and frozen sets can not have a Bloom filter in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            no_hash:
+                #ifndef NDEBUG
+                    printf("[set] Set with a custom equality function must be hashed to have a Bloom filter in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_build:
+                #ifndef NDEBUG
+                    printf("[set] Failed to build Bloom filter in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int set_enable_sketch ( set *const p_set, int precision )
+{
+
+    // Argument check
+    if ( p_set == (void *) 0 ) goto no_set;
+
+    // Initialized data
+    hll   *p_sketch   = (void *) 0;
+    set   *p_sorted   = (void *) 0;
+    void **pp_elements = (void *) 0;
+
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
+
+    // State check
+    if ( p_set->pfn_hash == (void *) 0 && p_set->pfn_is_equal != &equals_function && p_set->pfn_is_equal != (set_equal_fn *) &compare_function ) goto no_hash;
+
+    // Construct the sketch
+    if ( hll_construct(&p_sketch, precision) == 0 ) goto failed_to_construct_sketch;
+
+    // Get the elements
+    pp_elements = set_elements_of(p_set, &p_sorted);
+
+    // Error check
+    if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+    // Add each element
+    for (size_t i = 0; i < p_set->count; i++) hll_add(p_sketch, set_element_hash(p_set, pp_elements[i]));
+
+    // Clean up
+    if ( p_sorted ) set_destroy(&p_sorted);
+
+    // Replace the old sketch
+    if ( p_set->p_sketch ) hll_destroy(&p_set->p_sketch);
+    p_set->p_sketch = p_sketch;
+
+    // Unlock
+    set_rwlock_write_unlock(&p_set->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_set:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            no_hash:
+                #ifndef NDEBUG
+                    printf("[set] Set with a custom equality function must be hashed to have a sketch in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_construct_sketch:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct sketch in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] Failed to copy set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                hll_destroy(&p_sketch);
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+const hll *set_sketch ( const set *const p_set )
+{
+
+    // Done
+    return ( p_set ) ? p_set->p_sketch : (void *) 0;
+}
+
+double set_union_estimate ( const set *const p_a, const set *const p_b )
+{
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+
+    // State check
+    if ( p_a->p_sketch == (void *) 0 || p_b->p_sketch == (void *) 0 ) goto no_sketch;
+
+    // Done
+    return hll_union_estimate(p_a->p_sketch, p_b->p_sketch);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return -1;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return -1;
+        }
+
+        // Set errors
+        {
+            no_sketch:
+                #ifndef NDEBUG
+                    printf("[set] Both sets must have a sketch in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return -1;
+        }
+    }
 }
 
-void set_init ( void )
+double set_intersection_estimate ( const set *const p_a, const set *const p_b )
 {
 
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
+
     // State check
-    if ( initialized == true ) return;
+    if ( p_a->p_sketch == (void *) 0 || p_b->p_sketch == (void *) 0 ) goto no_sketch;
 
-    // Initialize log
-    log_init();
+    // Done
+    return hll_intersection_estimate(p_a->p_sketch, p_b->p_sketch);
 
-    // Initialize log
-    sync_init();
+    // Error handling
+    {
 
-    // Set the initialized flag
-    initialized = true;
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Done
-    return;
+                // Error
+                return -1;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return -1;
+        }
+
+        // Set errors
+        {
+            no_sketch:
+                #ifndef NDEBUG
+                    printf("[set] Both sets must have a sketch in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return -1;
+        }
+    }
 }
 
-int set_create ( set **const pp_set )
+int set_enable_minhash ( set *const p_set, size_t k )
 {
 
     // Argument check
-    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_set == (void *) 0 ) goto no_set;
 
     // Initialized data
-    set *p_set = SET_REALLOC(0, sizeof(set));
+    minhash  *p_minhash   = (void *) 0;
+    set      *p_sorted    = (void *) 0;
+    void    **pp_elements = (void *) 0;
 
-    // Error checking
-    if ( p_set == (void *) 0 ) goto no_mem;
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
 
-    // Zero set
-    memset(p_set, 0, sizeof(set));
+    // State check
+    if ( p_set->pfn_hash == (void *) 0 && p_set->pfn_is_equal != &equals_function && p_set->pfn_is_equal != (set_equal_fn *) &compare_function ) goto no_hash;
 
-    // Return the allocated memory
-    *pp_set = p_set;
+    // Construct the signature
+    if ( minhash_construct(&p_minhash, k) == 0 ) goto failed_to_construct_minhash;
+
+    // Get the elements
+    pp_elements = set_elements_of(p_set, &p_sorted);
+
+    // Error check
+    if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+    // Add each element
+    for (size_t i = 0; i < p_set->count; i++) minhash_add(p_minhash, set_element_hash(p_set, pp_elements[i]));
+
+    // Clean up
+    if ( p_sorted ) set_destroy(&p_sorted);
+
+    // Replace the old signature
+    if ( p_set->p_minhash ) minhash_destroy(&p_set->p_minhash);
+    p_set->p_minhash = p_minhash;
+
+    // Unlock
+    set_rwlock_write_unlock(&p_set->_lock);
 
     // Success
     return 1;
@@ -76,62 +5827,204 @@ int set_create ( set **const pp_set )
         {
             no_set:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
 
-        // Standard library errors
+        // Set errors
         {
-            no_mem:
+            no_hash:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Set with a custom equality function must be hashed to have a signature in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_construct_minhash:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct signature in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] Failed to copy set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Clean up
+                minhash_destroy(&p_minhash);
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int set_construct ( set **const pp_set, size_t size, set_equal_fn *pfn_is_equal )
+const minhash *set_minhash ( const set *const p_set )
+{
+
+    // Done
+    return ( p_set ) ? p_set->p_minhash : (void *) 0;
+}
+
+double set_jaccard_estimate ( const set *const p_a, const set *const p_b )
 {
 
     // Argument check
-    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
 
-    // Initialized data
-    set *p_set = (void *) 0;
+    // State check
+    if ( p_a->p_minhash == (void *) 0 || p_b->p_minhash == (void *) 0 ) goto no_minhash;
 
-    // Allocate the set
-    if ( set_create(pp_set) == 0 ) goto failed_to_allocate_set;
+    // Done
+    return minhash_jaccard(p_a->p_minhash, p_b->p_minhash);
 
-    // Get a pointer to the allocated set
-    p_set = *pp_set;
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Set the maximum number of elements in the set
-    p_set->max = size;
+                // Error
+                return -1;
 
-    // Allocate memory for set elements
-    p_set->elements = SET_REALLOC(0, size * sizeof(void *));
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Error checking
-    if ( p_set->elements == (void *) 0 ) goto no_mem;
+                // Error
+                return -1;
+        }
 
-    // Create a mutex
-    mutex_create(&p_set->_lock);
+        // Set errors
+        {
+            no_minhash:
+                #ifndef NDEBUG
+                    printf("[set] Both sets must have a signature in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // If the caller supplied a function for testing equivalence ...
-    if ( pfn_is_equal )
-        
-        // ... set the function
-        p_set->pfn_is_equal = pfn_is_equal;
+                // Error
+                return -1;
+        }
+    }
+}
+
+int set_pop ( set *const p_set, void **const pp_value )
+{
     
-    // Default to '==' for comparing elements
-    else
-        p_set->pfn_is_equal = &equals_function;
+    // Argument check
+    if ( p_set == (void *) 0 ) goto no_set;
+
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
+
+    // Frozen sets are immutable
+    if ( p_set->p_frozen ) goto set_is_frozen;
+
+    // Roaring sets pop their greatest element
+    if ( p_set->p_roaring )
+    {
+
+        // Initialized data
+        uint32_t value = 0;
+
+        // Pop the integer
+        if ( roaring_pop(p_set->p_roaring, &value) == 0 ) goto no_elements;
+
+        // Store the quantity of elements
+        p_set->count = roaring_count(p_set->p_roaring);
+
+        // Return the value to the caller
+        *pp_value = (void *) (uintptr_t) value;
+
+        // Unlock
+        set_rwlock_write_unlock(&p_set->_lock);
+
+        // Success
+        return 1;
+    }
+
+    // Bitset sets pop their greatest element
+    if ( p_set->p_bits )
+    {
+
+        // Initialized data
+        size_t i = ( p_set->universe + 63 ) / 64;
+
+        // Find the last word with a set bit
+        while ( i && p_set->p_bits[i - 1] == 0 ) i--;
+
+        // Error check
+        if ( i-- == 0 ) goto no_elements;
+
+        // Return the value to the caller
+        *pp_value = (void *) ( i * 64 + 63 - (size_t) __builtin_clzll(p_set->p_bits[i]) );
+
+        // Clear the bit
+        p_set->p_bits[i] &= ~( 1ULL << ( (uintptr_t) *pp_value & 63 ) );
+        p_set->count--;
+
+        // Unlock
+        set_rwlock_write_unlock(&p_set->_lock);
+
+        // Success
+        return 1;
+    }
+
+    // Error check
+    if ( p_set->count == 0 ) goto no_elements;
+
+    // Hashed sets
+    if ( p_set->pfn_hash )
+    {
+
+        // Initialized data
+        set_index *p_index = (void *) 0;
+        size_t     slot    = 0;
+
+        // Continue rehashing
+        set_index_migrate(p_set, SET_REHASH_STEP);
+
+        // Tombstone the index slot of the last element
+        slot = set_hashed_slot_of(p_set, p_set->count - 1, &p_index);
+        p_index->p_slots[slot] = SET_INDEX_TOMBSTONE;
+    }
+
+    // Decrement the quantity of elements in the set
+    p_set->count--;
+
+    // The element stays in the Bloom filter until it is rebuilt
+    p_set->bloom_removed++;
+
+    // Return the value to the caller
+    *pp_value = p_set->elements[p_set->count];
+
+    // Zero set the pop()'d element
+    p_set->elements[p_set->count] = (void *)0;
+
+    // ... unlock the mutex 
+    set_rwlock_write_unlock(&p_set->_lock);
 
     // Success
     return 1;
@@ -152,50 +6045,142 @@ int set_construct ( set **const pp_set, size_t size, set_equal_fn *pfn_is_equal
 
         // Set errors
         {
-            failed_to_allocate_set:
+            set_is_frozen:
                 #ifndef NDEBUG
-                    printf("[set] Call to \"set_create\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Can not pop from a frozen set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
-        }
 
-        // Standard library errors
-        {
-            no_mem:
+            no_elements:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Set is empty in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int set_from_elements ( set **const pp_set, const void **const pp_elements, size_t size, set_equal_fn *pfn_is_equal )
+int set_remove ( set *const p_set , void *const p_element )
 {
-
+    
     // Argument check
-    if ( pp_set == (void *) 0 ) goto no_set;
+    if ( p_set == (void *) 0 ) goto no_set;
 
     // Initialized data
-    set *p_set = (void *) 0;
+    set_index *p_index = (void *) 0;
+    size_t     i       = 0,
+               slot    = 0;
 
-    // Construct a set
-    if ( set_construct(pp_set, size, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
+
+    // Frozen sets are immutable
+    if ( p_set->p_frozen ) goto set_is_frozen;
+
+    // Roaring sets
+    if ( p_set->p_roaring )
+    {
+
+        // Remove the integer from the roaring bitmap
+        if ( (uintptr_t) p_element > UINT32_MAX || roaring_remove(p_set->p_roaring, (uint32_t) (uintptr_t) p_element) == 0 ) goto no_element;
+
+        // Store the quantity of elements
+        p_set->count = roaring_count(p_set->p_roaring);
+
+        // Unlock
+        set_rwlock_write_unlock(&p_set->_lock);
+
+        // Success
+        return 1;
+    }
+
+    // Bitset sets
+    if ( p_set->p_bits )
+    {
+
+        // Error check
+        if ( set_has(p_set, p_element, (void *) 0) == false ) goto no_element;
+
+        // Clear the bit
+        p_set->p_bits[(uintptr_t) p_element >> 6] &= ~( 1ULL << ( (uintptr_t) p_element & 63 ) );
+        p_set->count--;
+
+        // Unlock
+        set_rwlock_write_unlock(&p_set->_lock);
+
+        // Success
+        return 1;
+    }
+
+    // Hashed sets
+    if ( p_set->pfn_hash )
+    {
+
+        // Continue rehashing
+        set_index_migrate(p_set, SET_REHASH_STEP);
+
+        // Find the element
+        i = set_hashed_find(p_set, p_element, set_hash(p_set, p_element), &p_index, &slot);
+
+        // If the element is in the set, tombstone the slot
+        if ( i != SET_INDEX_NOT_FOUND ) p_index->p_slots[slot] = SET_INDEX_TOMBSTONE;
+    }
+
+    // Linear sets
+    else
+        i = set_find(p_set, p_element);
+
+    // Error check
+    if ( i == SET_INDEX_NOT_FOUND ) goto no_element;
+
+    // Decrement the element quantity
+    p_set->count--;
+
+    // The element stays in the Bloom filter until it is rebuilt
+    p_set->bloom_removed++;
+
+    // Sorted sets close the gap, so the elements stay in order
+    if ( p_set->pfn_compare )
+    {
+
+        // Shift the following elements down
+        memmove(&p_set->elements[i], &p_set->elements[i + 1], ( p_set->count - i ) * sizeof(void *));
+
+        // Zero set the last element
+        p_set->elements[p_set->count] = (void *) 0;
+
+        // Unlock
+        set_rwlock_write_unlock(&p_set->_lock);
 
-    // Get a pointer to the allocated set
-    p_set = *pp_set;
+        // Success
+        return 1;
+    }
 
-    // Iterate over each element
-    for (size_t i = 0; i < size; i++)
+    // If the last element is moving into the hole, repoint its index slot
+    if ( p_set->pfn_hash && i != p_set->count )
     {
-        
-        // Add the element to the set
-        set_add(p_set, pp_elements[i]);
+        slot = set_hashed_slot_of(p_set, p_set->count, &p_index);
+        p_index->p_slots[slot] = i + 1;
     }
+
+    // Move the last element into the hole
+    p_set->elements[i] = p_set->elements[p_set->count];
+
+    // Zero set the last element
+    p_set->elements[p_set->count] = (void *) 0;
+
+    // Unlock
+    set_rwlock_write_unlock(&p_set->_lock);
     
     // Success
     return 1;
@@ -216,21 +6201,21 @@ int set_from_elements ( set **const pp_set, const void **const pp_elements, size
 
         // Set errors
         {
-            failed_to_construct_set:
+            set_is_frozen:
                 #ifndef NDEBUG
-                    printf("[set] Call to \"set_from_elements\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Can not remove from a frozen set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
-        }
 
-        // Standard library errors
-        {
-            no_mem:
-                #ifndef NDEBUG
-                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+            no_element:
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
 
                 // Error
                 return 0;
@@ -238,34 +6223,46 @@ int set_from_elements ( set **const pp_set, const void **const pp_elements, size
     }
 }
 
-int set_contents ( const set *const p_set, void **const pp_contents )
+int set_freeze ( set *const p_set )
 {
 
     // Argument check
-    if ( p_set       == (void *) 0 ) goto no_set;
+    if ( p_set == (void *) 0 ) goto no_set;
 
-    // Count branch
-    if ( pp_contents == (void *) 0 ) goto return_count;
+    // Lock
+    set_rwlock_write_lock(&p_set->_lock);
 
+    // State check
+    if ( set_is_compact(p_set) ) goto set_is_compact;
+    if ( p_set->pfn_compare && p_set->pfn_compare != &compare_function ) goto not_integer_set;
+    if ( p_set->pfn_is_equal != &equals_function && p_set->pfn_is_equal != (set_equal_fn *) &compare_function ) goto not_integer_set;
 
-    // Lock
-    mutex_lock(&p_set->_lock);
+    // Sort the elements, unless they are already sorted
+    if ( p_set->pfn_compare == (void *) 0 ) qsort(p_set->elements, p_set->count, sizeof(void *), &set_qsort_compare);
 
-    // Copy the elements
-    memcpy(pp_contents, p_set->elements, sizeof(void *) * p_set->count);
+    // Encode the elements
+    if ( frozen_construct(&p_set->p_frozen, p_set->elements, p_set->count) == 0 ) goto failed_to_freeze;
+
+    // Free the elements
+    if ( p_set->elements != p_set->inline_elements ) SET_FREE(p_set->elements);
+
+    // Free the indices
+    SET_FREE(p_set->index.p_slots);
+    SET_FREE(p_set->old_index.p_slots);
+
+    // Store the state
+    p_set->elements      = (void *) 0,
+    p_set->max           = 0,
+    p_set->index         = (set_index) { 0 },
+    p_set->old_index     = (set_index) { 0 },
+    p_set->rehash_cursor = 0;
 
     // Unlock
-    mutex_unlock(&p_set->_lock);
-    
+    set_rwlock_write_unlock(&p_set->_lock);
+
     // Success
     return 1;
 
-    // Count branch
-    return_count:
-
-        // Success
-        return p_set->count;
-
     // Error handling
     {
 
@@ -273,57 +6270,111 @@ int set_contents ( const set *const p_set, void **const pp_contents )
         {
             no_set:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            set_is_compact:
+                #ifndef NDEBUG
+                    printf("[set] Can not freeze a roaring, bitset, or frozen set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            not_integer_set:
+                #ifndef NDEBUG
+                    printf("[set] Can not freeze a set with a custom equality or comparison function in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
+        }
 
-            no_return:
+        // Frozen errors
+        {
+            failed_to_freeze:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"pp_contents\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Call to \"frozen_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int set_add ( set *const p_set, void *const p_element )
+int set_thaw ( set *const p_set )
 {
 
     // Argument check
     if ( p_set == (void *) 0 ) goto no_set;
 
+    // Initialized data
+    void      **elements = (void *) 0;
+    set_index   index    = { 0 };
+
     // Lock
-    mutex_lock(&p_set->_lock);
+    set_rwlock_write_lock(&p_set->_lock);
 
-    // Iterate over each element
-    for (size_t i = 0; i < p_set->count; i++)
+    // State check
+    if ( p_set->p_frozen == (void *) 0 ) goto set_is_not_frozen;
+
+    // Small sets store their elements inline
+    if ( p_set->count <= SET_INLINE_MAX )
+        elements = p_set->inline_elements,
+        (void)frozen_contents(p_set->p_frozen, elements);
+
+    // Larger sets allocate their elements
+    else
     {
 
-        // If the element is a duplicate ...
-        if ( p_set->pfn_is_equal(p_set->elements[i], p_element) == 0 )
-        {
-            
-            // ... unlock the mutex 
-            mutex_unlock(&p_set->_lock);
+        // Allocate memory for the elements
+        elements = SET_REALLOC(0, p_set->count * sizeof(void *));
 
-            // Success
-            return 1;
-        }
+        // Error check
+        if ( elements == (void *) 0 ) goto no_mem;
+
+        // Decode the elements
+        (void)frozen_contents(p_set->p_frozen, elements);
     }
-    
-    // Store the element 
-    p_set->elements[p_set->count] = p_element;
 
-    // Increment the element quantity
-    p_set->count++;
+    // Hashed sets rebuild their index
+    if ( p_set->pfn_hash )
+    {
+
+        // Construct the index
+        if ( set_index_construct(&index, set_index_size(p_set->count)) == 0 ) goto failed_to_construct_index;
+
+        // Store the position of each element
+        for (size_t i = 0; i < p_set->count; i++) set_index_insert(&index, set_hash(p_set, elements[i]), i);
+    }
+
+    // Free the frozen sequence
+    frozen_destroy(&p_set->p_frozen);
+
+    // Store the state
+    p_set->elements = elements,
+    p_set->max      = ( elements == p_set->inline_elements ) ? SET_INLINE_MAX : p_set->count,
+    p_set->index    = index;
 
     // Unlock
-    mutex_unlock(&p_set->_lock);
-    
+    set_rwlock_write_unlock(&p_set->_lock);
+
     // Success
     return 1;
 
@@ -334,7 +6385,7 @@ int set_add ( set *const p_set, void *const p_element )
         {
             no_set:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -343,11 +6394,28 @@ int set_add ( set *const p_set, void *const p_element )
 
         // Set errors
         {
-            failed_to_construct_set:
+            set_is_not_frozen:
                 #ifndef NDEBUG
-                    printf("[set] Call to \"set_from_elements\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Can not thaw a set that is not frozen in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_construct_index:
+                #ifndef NDEBUG
+                    printf("[set] Failed to construct index in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Clean up
+                if ( elements != p_set->inline_elements ) SET_FREE(elements);
+
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
         }
@@ -359,137 +6427,245 @@ int set_add ( set *const p_set, void *const p_element )
                     printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Unlock
+                set_rwlock_write_unlock(&p_set->_lock);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int set_union ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+/** !
+ * Call a function on each element of a set. The caller holds the read lock of the set
+ * 
+ * @param p_set    the set
+ * @param function pointer to a function of type void (*)(void *value, size_t index)
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_foreach_i_unlocked ( const set *const p_set, void (*const function)(void *const value, size_t index) )
 {
 
     // Argument check
-    if ( pp_set == (void *) 0 ) goto no_set;
-    if ( p_a    == (void *) 0 ) goto no_a;
-    if ( p_b    == (void *) 0 ) goto no_b;
+    if ( p_set    == (void *) 0 ) goto no_set;
+    if ( function == (void *) 0 ) goto no_free_func;
 
-    // Initialized data
-    set    *p_set        = 0;
-    size_t  max_set_size = p_a->count + p_b->count;
-    
-    // Construct a set
-    if ( set_construct(&p_set, max_set_size, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+    // Roaring sets iterate in ascending order
+    if ( p_set->p_roaring ) return roaring_foreach_i(p_set->p_roaring, function);
 
-    // Iterate through set a
-    for (size_t i = 0; i < p_a->count; i++)
+    // So do frozen sets
+    if ( p_set->p_frozen ) return frozen_foreach_i(p_set->p_frozen, function);
 
-        // Add each element to the new set
-        set_add(p_set, p_a->elements[i]);
-    
-    // Iterate through set b
-    for (size_t i = 0; i < p_b->count; i++)
+    // So do bitset sets
+    if ( p_set->p_bits )
+    {
 
-        // Add each element to the new set
-        set_add(p_set, p_b->elements[i]);
+        // Initialized data
+        size_t k = 0;
 
-    // Return a pointer to the set to the caller
-    *pp_set = p_set;
+        // Call the function on the index of each set bit
+        for (size_t i = 0; i < ( p_set->universe + 63 ) / 64; i++)
+            for (uint64_t w = p_set->p_bits[i]; w; w &= w - 1)
+                function((void *) ( i * 64 + (size_t) __builtin_ctzll(w) ), k++);
+
+        // Success
+        return 1;
+    }
+
+    // Iterate over each element in the set
+    for (size_t i = 0; i < p_set->count; i++)
+        
+        // Call the function
+        function(p_set->elements[i], i);
 
     // Success
     return 1;
 
     // Error handling
     {
-
+        
         // Argument errors
         {
             no_set:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-
-            no_a:
+            
+            no_free_func:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[array] Null pointer provided for \"function\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
+        }
+    }
+}
 
-            no_b:
-                #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+int set_foreach_i ( const set *const p_set, void (*const function)(void *const value, size_t index) )
+{
 
-                // Error
-                return 0;
+    // Initialized data
+    int result = 0;
 
-        }
+    // Lock the set for reading
+    set_read_lock_pair(p_set, (void *) 0, true);
 
-        // Set errors
-        {
-            failed_to_construct_set:
-                #ifndef NDEBUG
-                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
-                #endif
+    // Call the function on each element
+    result = set_foreach_i_unlocked(p_set, function);
 
-                // Error
-                return 0;
-        }
-    }
+    // Unlock
+    set_read_lock_pair(p_set, (void *) 0, false);
+
+    // Done
+    return result;
 }
 
-int set_difference ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+/** !
+ * Add each element of set B to set A. The caller holds the write lock of set A, and the read lock of set B
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_update_unlocked ( set *const p_a, const set *const p_b )
 {
-        // Argument check
-    if ( pp_set == (void *) 0 ) goto no_set;
-    if ( p_a    == (void *) 0 ) goto no_a;
-    if ( p_b    == (void *) 0 ) goto no_b;
+
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
 
     // Initialized data
-    set    *p_set        = 0;
-    size_t  max_set_size = p_a->count + p_b->count;
-    
-    // Construct a set
-    if ( set_construct(&p_set, max_set_size, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+    set   *p_copy      = (void *) 0;
+    void **pp_elements = (void *) 0,
+         **pp_sorted   = (void *) 0;
 
-    // Iterate through set a
-    for (size_t i = 0; i < p_a->count; i++)
+    // A set updated with itself is unchanged
+    if ( p_a == p_b ) return 1;
 
-        // Add each element to the new set
-        set_add(p_set, p_a->elements[i]);
-    
-    // Iterate through set b
-    for (size_t i = 0; i < p_b->count; i++)
+    // Frozen sets are immutable
+    if ( p_a->p_frozen ) goto set_is_frozen;
 
-        // Add each element to the new set
-        set_add(p_set, p_b->elements[i]);
+    // Fast exit
+    if ( p_b->count == 0 ) goto done;
 
-    // Iterate through set a
-    for (size_t i = 0; i < p_a->count; i++)
+    // Roaring sets
+    if ( p_a->p_roaring && p_b->p_roaring )
+    {
+
+        // Merge the containers of set B into set A
+        if ( roaring_union_update(p_a->p_roaring, p_b->p_roaring) == 0 ) goto failed_to_update_roaring;
+
+        // Store the quantity of elements
+        p_a->count = roaring_count(p_a->p_roaring);
+
+        // Done
+        goto done;
+    }
+
+    // Bitset sets
+    if ( p_a->p_bits && p_b->p_bits )
     {
 
         // Initialized data
-        bool is_a_i_in_b = false;
+        size_t a_words = ( p_a->universe + 63 ) / 64,
+               b_words = ( p_b->universe + 63 ) / 64;
 
-        // Iterate through set b
-        for (size_t j = 0; j < p_b->count; j++)
+        // Every element of set B must be in the universe of set A
+        for (size_t i = a_words; i < b_words; i++)
+            if ( p_b->p_bits[i] ) goto element_out_of_range;
+        if ( b_words >= a_words && a_words && ( p_a->universe & 63 ) && ( p_b->p_bits[a_words - 1] >> ( p_a->universe & 63 ) ) ) goto element_out_of_range;
+
+        // Set the bits of set B, and count the new elements
+        for (size_t i = 0; i < a_words && i < b_words; i++)
+            p_a->count += (size_t) __builtin_popcountll(p_b->p_bits[i] & ~p_a->p_bits[i]),
+            p_a->p_bits[i] |= p_b->p_bits[i];
+
+        // Done
+        goto done;
+    }
+
+    // Get the elements of set B
+    pp_elements = set_elements_of(p_b, &p_copy);
+
+    // Error check
+    if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+    // Sorted sets are merged in place, when the elements of set B are in 
+    // the same order. Compact sets are in ascending order
+    if ( p_a->pfn_compare )
+    {
+
+        // Initialized data
+        bool ordered = ( set_is_mergeable(p_a, p_b) && p_b->p_frozen == (void *) 0 ) || ( p_a->pfn_compare == &compare_function && set_is_compact(p_b) );
+
+        // The elements of other sets are sorted first, IF the default comparator orders them
+        if ( ordered == false && p_a->pfn_compare == &compare_function )
         {
-            // If a[i] is in b
-            if ( pfn_is_equal(p_a->elements[i], p_b->elements[j]) == 0 )
-            {
 
-                // a[i] is in b
-                set_remove(p_set, p_a->elements[i]);
-            }
+            // Allocate memory for a copy of the elements
+            pp_sorted = SET_REALLOC(0, p_b->count * sizeof(void *));
+
+            // Error check
+            if ( pp_sorted == (void *) 0 ) goto no_mem;
+
+            // Sort the copy
+            memcpy(pp_sorted, pp_elements, p_b->count * sizeof(void *));
+            qsort(pp_sorted, p_b->count, sizeof(void *), &set_qsort_compare);
+            pp_elements = pp_sorted,
+            ordered     = true;
+        }
+
+        // Merge
+        if ( ordered )
+        {
+            if ( set_sorted_merge_update(p_a, pp_elements, p_b->count) == 0 ) goto failed_to_grow_set;
+            goto done;
         }
     }
 
-    // Return a pointer to the set to the caller
-    *pp_set = p_set;
+    // Hashed sets make room for every element of set B at once, so adding them never rehashes
+    if ( p_a->pfn_hash )
+    {
+        if ( set_reserve(p_a, p_a->count + p_b->count) == 0 ) goto failed_to_grow_set;
+        if ( p_a->index.max / 4 * 3 < p_a->count + p_b->count && set_index_rebuild(p_a, 2 * ( p_a->count + p_b->count )) == 0 ) goto failed_to_grow_set;
+    }
+
+    // Add each element of set B
+    for (size_t i = 0; i < p_b->count; i++)
+        if ( set_insert(p_a, pp_elements[i]) == 0 ) goto failed_to_add;
+
+    // Clean up
+    if ( p_copy ) set_destroy(&p_copy);
+    SET_FREE(pp_sorted);
+
+    // Success
+    return 1;
+
+    done:
+
+    // Keep the Bloom filter, the sketch, and the signature in sync
+    if ( p_a->p_bloom || p_a->p_sketch || p_a->p_minhash )
+    {
+
+        // Get the elements of set B
+        if ( pp_elements == (void *) 0 ) pp_elements = set_elements_of(p_b, &p_copy);
+
+        // Error check
+        if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+        // Add each element of set B
+        for (size_t i = 0; i < p_b->count; i++) set_filters_add(p_a, pp_elements[i]);
+    }
+
+    // Clean up
+    if ( p_copy ) set_destroy(&p_copy);
+    SET_FREE(pp_sorted);
 
     // Success
     return 1;
@@ -499,82 +6675,240 @@ int set_difference ( set **const pp_set, const set *const p_a, const set *const
 
         // Argument errors
         {
-            no_set:
+            no_a:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_b:
+                #ifndef NDEBUG
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            set_is_frozen:
+                #ifndef NDEBUG
+                    printf("[set] Can not update a frozen set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            element_out_of_range:
+                #ifndef NDEBUG
+                    printf("[set] Element is out of range for bitset set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            failed_to_update_roaring:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Call to \"roaring_union_update\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            no_a:
+            failed_to_copy:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Failed to copy set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
 
-            no_b:
+            failed_to_grow_set:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Failed to grow set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Clean up
+                if ( p_copy ) set_destroy(&p_copy);
+                SET_FREE(pp_sorted);
+
                 // Error
                 return 0;
 
+            failed_to_add:
+                #ifndef NDEBUG
+                    printf("[set] Failed to add element in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                if ( p_copy ) set_destroy(&p_copy);
+                SET_FREE(pp_sorted);
+
+                // Error
+                return 0;
         }
 
-        // Set errors
+        // Standard library errors
         {
-            failed_to_construct_set:
+            no_mem:
                 #ifndef NDEBUG
-                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
+                // Clean up
+                if ( p_copy ) set_destroy(&p_copy);
+
                 // Error
                 return 0;
         }
     }
 }
 
-int set_intersection ( set **const pp_set, const set *const p_a, const set *const p_b, set_equal_fn *pfn_is_equal )
+int set_update ( set *const p_a, const set *const p_b )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock set A for writing, and set B for reading
+    set_lock_update(p_a, p_b, true);
+
+    // Add each element of set B
+    result = set_update_unlocked(p_a, p_b);
+
+    // Unlock
+    set_lock_update(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
+/** !
+ * Remove each element of set B from set A. The caller holds the write lock of set A, and the read lock of set B
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_difference_update_unlocked ( set *const p_a, const set *const p_b )
 {
 
     // Argument check
-    if ( pp_set == (void *) 0 ) goto no_set;
-    if ( p_a    == (void *) 0 ) goto no_a;
-    if ( p_b    == (void *) 0 ) goto no_b;
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
 
     // Initialized data
-    set    *p_set        = 0;
-    size_t  max_set_size = p_a->count + p_b->count;
-    
-    // Construct a set
-    if ( set_construct(&p_set, max_set_size, pfn_is_equal) == 0 ) goto failed_to_construct_set;
+    set   *p_copy      = (void *) 0;
+    void **pp_elements = (void *) 0;
 
-    // Iterate through set a
-    for (size_t i = 0; i < p_a->count; i++)
+    // Frozen sets are immutable
+    if ( p_a->p_frozen ) goto set_is_frozen;
+
+    // Fast exit
+    if ( p_a->count == 0 ) goto done;
+
+    // A set minus itself is empty
+    if ( p_a == p_b && p_a->p_roaring == (void *) 0 && p_a->p_bits == (void *) 0 )
+    {
+
+        // Empty the elements array
+        memset(p_a->elements, 0, p_a->count * sizeof(void *));
+        p_a->bloom_removed += p_a->count;
+        p_a->count = 0;
+
+        // Hashed sets empty their index
+        if ( p_a->pfn_hash && set_index_rebuild(p_a, 0) == 0 ) goto failed_to_rebuild_index;
+
+        // Done
+        goto done;
+    }
+
+    // Roaring sets
+    if ( p_a->p_roaring )
+    {
+
+        // Combine the containers of set B with set A
+        if ( p_b->p_roaring )
+        {
+            if ( roaring_difference_update(p_a->p_roaring, p_b->p_roaring) == 0 ) goto failed_to_update_roaring;
+        }
+
+        // Otherwise, remove each element of set B from set A
+        else
+        {
+
+            // Get the elements of set B
+            pp_elements = set_elements_of(p_b, &p_copy);
+
+            // Error check
+            if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+            // Remove
+            for (size_t i = 0; i < p_b->count; i++)
+                if ( (uintptr_t) pp_elements[i] <= UINT32_MAX )
+                    (void)roaring_remove(p_a->p_roaring, (uint32_t) (uintptr_t) pp_elements[i]);
+        }
+
+        // Store the quantity of elements
+        p_a->count = roaring_count(p_a->p_roaring);
+
+        // Done
+        goto done;
+    }
+
+    // Bitset sets
+    if ( p_a->p_bits )
     {
 
         // Initialized data
-        bool is_a_i_in_b = false;
+        size_t a_words = ( p_a->universe + 63 ) / 64;
 
-        // Iterate through set b
-        for (size_t j = 0; j < p_b->count; j++)
+        // Clear the bits that are set in set B
+        if ( p_b->p_bits )
         {
-            // If a[i] is in b
-            if ( pfn_is_equal(p_a->elements[i], p_b->elements[j]) == 0 )
-            {
 
-                // a[i] is in b
-                set_add(p_set, p_a->elements[i]);
-            }
+            // Initialized data
+            size_t b_words = ( p_b->universe + 63 ) / 64;
+
+            // Subtract one word at a time
+            for (size_t i = 0; i < a_words && i < b_words; i++) p_a->p_bits[i] &= ~p_b->p_bits[i];
+        }
+
+        // Otherwise, clear the bit of each element of set B
+        else
+        {
+
+            // Get the elements of set B
+            pp_elements = set_elements_of(p_b, &p_copy);
+
+            // Error check
+            if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+            // Clear
+            for (size_t i = 0; i < p_b->count; i++)
+                if ( (uintptr_t) pp_elements[i] < p_a->universe )
+                    p_a->p_bits[(uintptr_t) pp_elements[i] >> 6] &= ~( 1ULL << ( (uintptr_t) pp_elements[i] & 63 ) );
         }
+
+        // Count the elements
+        p_a->count = 0;
+        for (size_t i = 0; i < a_words; i++) p_a->count += (size_t) __builtin_popcountll(p_a->p_bits[i]);
+
+        // Done
+        goto done;
     }
 
-    // Return a pointer to the set to the caller
-    *pp_set = p_set;
+    // Keep the elements of set A that are not in set B
+    if ( set_retain(p_a, p_b, false) == 0 ) goto failed_to_rebuild_index;
+
+    done:
+
+    // Clean up
+    if ( p_copy ) set_destroy(&p_copy);
 
     // Success
     return 1;
@@ -584,17 +6918,9 @@ int set_intersection ( set **const pp_set, const set *const p_a, const set *cons
 
         // Argument errors
         {
-            no_set:
-                #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-
-                // Error
-                return 0;
-
             no_a:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"p_a\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -602,44 +6928,42 @@ int set_intersection ( set **const pp_set, const set *const p_a, const set *cons
 
             no_b:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter\"p_b\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-
         }
 
         // Set errors
         {
-            failed_to_construct_set:
+            set_is_frozen:
                 #ifndef NDEBUG
-                    printf("[set] Call to \"set_construct\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Can not update a frozen set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-        }
-    }
-}
 
-size_t set_count ( const set *const p_set )
-{
-    
-    // Argument check
-    if ( p_set == (void *) 0 ) goto no_set;
+            failed_to_update_roaring:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"roaring_difference_update\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Return
-    return p_set->count;
+                // Error
+                return 0;
 
-    // Error handling
-    {
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] Failed to copy set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-        // Argument errors
-        {
-            no_set:
+                // Error
+                return 0;
+
+            failed_to_rebuild_index:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Failed to rebuild index in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -648,103 +6972,133 @@ size_t set_count ( const set *const p_set )
     }
 }
 
-int set_pop ( set *const p_set, void **const pp_value )
+int set_difference_update ( set *const p_a, const set *const p_b )
 {
-    
-    // Argument check
-    if ( p_set == (void *) 0 ) goto no_set;
 
-    // Lock
-    mutex_lock(&p_set->_lock);
+    // Initialized data
+    int result = 0;
 
-    // Decrement the quantity of elements in the set
-    p_set->count--;
+    // Lock set A for writing, and set B for reading
+    set_lock_update(p_a, p_b, true);
 
-    // Return the value to the caller
-    *pp_value = p_set->elements[p_set->count];
+    // Remove each element of set B
+    result = set_difference_update_unlocked(p_a, p_b);
 
-    // Zero set the pop()'d element
-    p_set->elements[p_set->count] = (void *)0;
+    // Unlock
+    set_lock_update(p_a, p_b, false);
 
-    // ... unlock the mutex 
-    mutex_unlock(&p_set->_lock);
+    // Done
+    return result;
+}
 
-    // Success
-    return 1;
+/** !
+ * Remove each element of set A that is not in set B. The caller holds the write lock of set A, and the read lock of set B
+ * 
+ * @param p_a set A
+ * @param p_b set B
+ * 
+ * @return 1 on success, 0 on error
+ */
+static int set_intersection_update_unlocked ( set *const p_a, const set *const p_b )
+{
 
-    // Unlock
-    mutex_unlock(&p_set->_lock);
-    
-    // Success
-    return 1;
+    // Argument check
+    if ( p_a == (void *) 0 ) goto no_a;
+    if ( p_b == (void *) 0 ) goto no_b;
 
-    // Error handling
+    // Initialized data
+    set   *p_copy      = (void *) 0;
+    void **pp_elements = (void *) 0;
+
+    // Frozen sets are immutable
+    if ( p_a->p_frozen ) goto set_is_frozen;
+
+    // Fast exit
+    if ( p_a->count == 0 ) goto done;
+
+    // A set intersected with itself is unchanged
+    if ( p_a == p_b ) goto done;
+
+    // Roaring sets
+    if ( p_a->p_roaring )
     {
 
-        // Argument errors
+        // Combine the containers of set B with set A
+        if ( p_b->p_roaring )
         {
-            no_set:
-                #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
-                #endif
-
-                // Error
-                return 0;
+            if ( roaring_intersection_update(p_a->p_roaring, p_b->p_roaring) == 0 ) goto failed_to_update_roaring;
         }
 
-        // Standard library errors
+        // Otherwise, remove each element of set A that is not in set B
+        else
         {
-            no_mem:
-                #ifndef NDEBUG
-                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
-                #endif
 
-                // Error
-                return 0;
+            // Get the elements of set A
+            pp_elements = set_elements_of(p_a, &p_copy);
+
+            // Error check
+            if ( pp_elements == (void *) 0 ) goto failed_to_copy;
+
+            // Remove
+            for (size_t i = 0; i < p_a->count; i++)
+                if ( set_has(p_b, pp_elements[i], (void *) 0) == false )
+                    (void)roaring_remove(p_a->p_roaring, (uint32_t) (uintptr_t) pp_elements[i]);
         }
-    }
-}
 
-int set_remove ( set *const p_set , void *const p_element )
-{
-    
-    // Argument check
-    if ( p_set == (void *) 0 ) goto no_set;
+        // Store the quantity of elements
+        p_a->count = roaring_count(p_a->p_roaring);
 
-    // Lock
-    mutex_lock(&p_set->_lock);
+        // Done
+        goto done;
+    }
 
-    // Iterate over each element
-    for (size_t i = 0; i < p_set->count; i++)
+    // Bitset sets
+    if ( p_a->p_bits )
     {
 
-        // If the element is a duplicate ...
-        if ( p_set->pfn_is_equal(p_set->elements[i], p_element) == 0 )
+        // Initialized data
+        size_t a_words = ( p_a->universe + 63 ) / 64;
+
+        // Clear the bits of set A that are not set in set B
+        if ( p_b->p_bits )
         {
-            
-            p_set->count--;
 
-            p_set->elements[i] = p_set->elements[p_set->count];
+            // Initialized data
+            size_t b_words = ( p_b->universe + 63 ) / 64;
+
+            // Intersect one word at a time
+            for (size_t i = 0; i < a_words; i++) p_a->p_bits[i] &= ( i < b_words ) ? p_b->p_bits[i] : 0;
+        }
 
-            p_set->elements[p_set->count] = (void *) 0;
+        // Otherwise, look up each element of set A in set B
+        else
+            for (size_t i = 0; i < a_words; i++)
+                for (uint64_t word = p_a->p_bits[i]; word; word &= word - 1)
+                {
 
-            // ... unlock the mutex 
-            mutex_unlock(&p_set->_lock);
+                    // Initialized data
+                    uintptr_t e = ( i << 6 ) + (uintptr_t) __builtin_ctzll(word);
 
-            // Success
-            return 1;
-        }
+                    // Clear the bit
+                    if ( set_has(p_b, (void *) e, (void *) 0) == false ) p_a->p_bits[i] &= ~( 1ULL << ( e & 63 ) );
+                }
+
+        // Count the elements
+        p_a->count = 0;
+        for (size_t i = 0; i < a_words; i++) p_a->count += (size_t) __builtin_popcountll(p_a->p_bits[i]);
+
+        // Done
+        goto done;
     }
-    
-    // Store the element 
-    p_set->elements[p_set->count] = p_element;
 
-    // Increment the element quantity
-    p_set->count++;
+    // Keep the elements of set A that are also in set B
+    if ( set_retain(p_a, p_b, true) == 0 ) goto failed_to_rebuild_index;
+
+    done:
+
+    // Clean up
+    if ( p_copy ) set_destroy(&p_copy);
 
-    // Unlock
-    mutex_unlock(&p_set->_lock);
-    
     // Success
     return 1;
 
@@ -753,60 +7107,52 @@ int set_remove ( set *const p_set , void *const p_element )
 
         // Argument errors
         {
-            no_set:
+            no_a:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for parameter \"pp_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_a\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-        }
 
-        // Standard library errors
-        {
-            no_mem:
+            no_b:
                 #ifndef NDEBUG
-                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Null pointer provided for parameter \"p_b\" in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
         }
-    }
-}
 
-int set_foreach_i ( const set *const p_set, void (*const function)(void *const value, size_t index) )
-{
+        // Set errors
+        {
+            set_is_frozen:
+                #ifndef NDEBUG
+                    printf("[set] Can not update a frozen set in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Argument check
-    if ( p_set    == (void *) 0 ) goto no_set;
-    if ( function == (void *) 0 ) goto no_free_func;
+                // Error
+                return 0;
 
-    // Iterate over each element in the set
-    for (size_t i = 0; i < p_set->count; i++)
-        
-        // Call the function
-        function(p_set->elements[i], i);
+            failed_to_update_roaring:
+                #ifndef NDEBUG
+                    printf("[set] Call to \"roaring_intersection_update\" returned an erroneous value in call to function \"%s\"\n", __FUNCTION__);
+                #endif
 
-    // Success
-    return 1;
+                // Error
+                return 0;
 
-    // Error handling
-    {
-        
-        // Argument errors
-        {
-            no_set:
+            failed_to_copy:
                 #ifndef NDEBUG
-                    printf("[set] Null pointer provided for \"p_set\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Failed to copy set in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
                 return 0;
-            
-            no_free_func:
+
+            failed_to_rebuild_index:
                 #ifndef NDEBUG
-                    printf("[array] Null pointer provided for \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                    printf("[set] Failed to rebuild index in call to function \"%s\"\n", __FUNCTION__);
                 #endif
 
                 // Error
@@ -815,6 +7161,25 @@ int set_foreach_i ( const set *const p_set, void (*const function)(void *const v
     }
 }
 
+int set_intersection_update ( set *const p_a, const set *const p_b )
+{
+
+    // Initialized data
+    int result = 0;
+
+    // Lock set A for writing, and set B for reading
+    set_lock_update(p_a, p_b, true);
+
+    // Keep the common elements
+    result = set_intersection_update_unlocked(p_a, p_b);
+
+    // Unlock
+    set_lock_update(p_a, p_b, false);
+
+    // Done
+    return result;
+}
+
 // TODO: Implement these functions
 /*
 UNION WAS HERE 
@@ -822,9 +7187,6 @@ DIFFERENCE WAS HERE
 INTERSECTION WAS HERE 
 ADD WAS HERE
 void set_discard             ( set        *const p_set , void        *      p_element );
-int  set_difference_update   ( set        *const p_a   , const set   *const p_b );
-int  set_intersection_update ( set        *const p_a   , const set   *const p_b );
-int  set_update              ( set        *const p_a   , const set   *const p_b );
 POP WAS HERE
 REMOVE WAS HERE 
 int  set_clear               ( set        *const p_set );
@@ -844,14 +7206,40 @@ int set_destroy ( set **const pp_set )
     // No more set for caller
     *pp_set = (void *) 0;
 
-    // Lock the mutex
-    mutex_lock(&p_set->_lock);
+    // Lock the set
+    set_rwlock_write_lock(&p_set->_lock);
 
-    // Free the set elements
-    (void)SET_REALLOC(p_set->elements, 0); 
+    // Free the set elements, unless they are inline
+    if ( p_set->elements != p_set->inline_elements ) SET_FREE(p_set->elements);
+
+    // Free the indices
+    SET_FREE(p_set->index.p_slots);
+    SET_FREE(p_set->old_index.p_slots);
+
+    // Free the roaring bitmap
+    if ( p_set->p_roaring ) roaring_destroy(&p_set->p_roaring);
+
+    // Free the bitset
+    SET_FREE(p_set->p_bits);
+
+    // Free the frozen sequence
+    if ( p_set->p_frozen ) frozen_destroy(&p_set->p_frozen);
+
+    // Free the Bloom filter
+    SET_FREE(p_set->p_bloom);
+
+    // Free the sketch and the signature
+    if ( p_set->p_sketch  ) hll_destroy(&p_set->p_sketch);
+    if ( p_set->p_minhash ) minhash_destroy(&p_set->p_minhash);
+
+    // Unlock the set
+    set_rwlock_write_unlock(&p_set->_lock);
 
     // Destroy the lock
-    mutex_destroy(&p_set->_lock);
+    set_rwlock_destroy(&p_set->_lock);
+
+    // Free the set
+    SET_FREE(p_set);
     
     // Success
     return 1;
@@ -10,12 +10,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <math.h>
 
 // Log module
 #include <log/log.h>
 
 // set module
 #include <set/set.h>
+#include <set/kernel.h>
+#include <set/typed.h>
+#include <set/strset.h>
+#include <set/hll.h>
+#include <set/minhash.h>
+#include <set/parallel.h>
+#include <set/sharded.h>
+#include <set/lockfree.h>
+#include <set/epoch.h>
 
 // Enumeration definitions
 enum result_e {
@@ -24,8 +34,26 @@ enum result_e {
     match
 };
 
+// Structure definitions
+struct point_s { int x, y; };
+struct lookup_s { set *p_set, *p_other; size_t index, found; };
+struct writer_s { sharded *p_sharded; size_t index, added, removed; bool remove; };
+struct hammer_s { lockfree *p_lockfree; size_t index, phase, removed; };
+
 // Type definitions
 typedef enum result_e result_t;
+typedef struct point_s point;
+typedef struct lookup_s lookup;
+typedef struct writer_s writer;
+typedef struct hammer_s hammer;
+
+// Hash and equality for points
+#define POINT_HASH(p)      ( (unsigned long long) (unsigned) (p).x << 32 | (unsigned) (p).y )
+#define POINT_EQUALS(a, b) ( (a).x != (b).x || (a).y != (b).y )
+
+// Typed sets
+SET_DECLARE(u64set, uint64_t, SET_HASH_SCALAR, SET_EQUALS_SCALAR)
+SET_DECLARE(pointset, point, POINT_HASH, POINT_EQUALS)
 
 // Global variables
 int total_tests      = 0,
@@ -40,8 +68,8 @@ char  *A_element      = "A",
       *B_element      = "B",
       *C_element      = "C",
       *D_element      = "D",
-      *X_element      = "X",
-      *_elements   [] = { 0x0 },
+      *X_element      = "X";
+void  *_elements   [] = { 0x0 },
       *A_elements  [] = { "A", 0x0 },
       *B_elements  [] = { "B", 0x0 },
       *C_elements  [] = { "C", 0x0 },
@@ -117,6 +145,275 @@ bool test_intersection ( void(*set_constructor)(set **pp_set), void(*set_constru
 
 bool test_difference( void(*set_constructor)(set **pp_set), void(*set_constructor2)(set **pp_set), void **values1, void **values2, result_t expected );
 
+/** !
+ * Test the hashed set
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_hashed_set ( char *name );
+
+/** !
+ * Test the sorted set
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_sorted_set ( char *name );
+
+/** !
+ * Test the roaring set
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_roaring_set ( char *name );
+
+/** !
+ * Test the bitset set
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_bitset_set ( char *name );
+
+/** !
+ * Test frozen sets
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_frozen_set ( char *name );
+
+/** !
+ * Test small sets, which store their elements inline
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_inline_set ( char *name );
+
+/** !
+ * Test type specialized sets
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_typed_set ( char *name );
+
+/** !
+ * Test string sets
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_strset ( char *name );
+
+/** !
+ * Test set_contains, with and without a Bloom filter
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_contains ( char *name );
+
+/** !
+ * Test cardinality sketches
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_sketch ( char *name );
+
+/** !
+ * Test MinHash signatures
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_minhash ( char *name );
+
+/** !
+ * Test count only set operations
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_counts ( char *name );
+
+/** !
+ * Test subsets, supersets, and disjoint sets
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_subset ( char *name );
+
+/** !
+ * Test in place updates
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_update ( char *name );
+
+/** !
+ * Test unions and intersections of many sets
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_many ( char *name );
+
+/** !
+ * Test set operations on worker threads
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_parallel ( char *name );
+
+/** !
+ * Test bulk construction from arrays of elements
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_bulk ( char *name );
+
+/** !
+ * Test batched adds and lookups
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_batch ( char *name );
+
+/** !
+ * Test concurrent readers and writers
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_readers ( char *name );
+
+/** !
+ * Test sharded sets with concurrent writers
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_sharded ( char *name );
+
+/** !
+ * Test lock free sets under many threads
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_lockfree ( char *name );
+
+/** !
+ * Test epoch based reclamation
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_epoch ( char *name );
+
+/** !
+ * Test the set kernels against a scalar merge
+ * 
+ * @param name the name of the test
+ * 
+ * @return void
+ */
+void test_kernels ( char *name );
+
+/** !
+ * Compare two 32 bit keys
+ * 
+ * @param a pointer to key A
+ * @param b pointer to key B
+ * 
+ * @return negative if A < B, 0 if A == B, positive if A > B
+ */
+int compare_u32 ( const void *a, const void *b );
+int compare_descending ( const void *a, const void *b );
+int construct_kind ( set **pp_set, size_t kind, size_t start, size_t step );
+
+/** !
+ * Test if the contents of a set are in strictly ascending order
+ * 
+ * @param p_set the set
+ * 
+ * @return true if the contents are sorted, false otherwise
+ */
+bool is_sorted ( set *p_set );
+
+/** !
+ * Look up keys on a worker thread. The first task adds keys, and the 
+ * rest count the keys they find. Given another set, the rest count the 
+ * keys the two sets share instead
+ * 
+ * @param p_argument the lookup
+ * 
+ * @return 1
+ */
+int lookup_task ( void *const p_argument );
+
+/** !
+ * Add or remove keys of a sharded set on a worker thread. Writers share
+ * half of the keys they add with the next writer
+ * 
+ * @param p_argument the writer
+ * 
+ * @return 1
+ */
+int writer_task ( void *const p_argument );
+
+/** !
+ * Hammer a lock free set on a worker thread. Phase 0 adds every key, 
+ * phase 1 removes every key, phase 2 adds, removes and looks up keys,
+ * and phase 3 adds and removes the same few keys as every other thread
+ * 
+ * @param p_argument the hammer
+ * 
+ * @return 1
+ */
+int hammer_task ( void *const p_argument );
+
+/** !
+ * Hash a null terminated string
+ * 
+ * @param p_string the string
+ * 
+ * @return the hash of the string
+ */
+unsigned long long hash_string ( const void *const p_string );
+
 /** !
  * Test an set with no elements
  * 
@@ -561,6 +858,75 @@ void run_tests ( void )
     // { B, C } -> { A, B, C }
     test_three_element_set(construct_BC_addA_ABC, "{ B, C } -> { A, B, C }", ABC_elements);
 
+    // Hashed
+    test_hashed_set("hashed");
+
+    // Sorted
+    test_sorted_set("sorted");
+
+    // Roaring
+    test_roaring_set("roaring");
+
+    // Bitset
+    test_bitset_set("bitset");
+
+    // Test frozen sets
+    test_frozen_set("frozen");
+
+    // Test small sets
+    test_inline_set("inline");
+
+    // Test type specialized sets
+    test_typed_set("typed");
+
+    // Test string sets
+    test_strset("strset");
+
+    // Test membership
+    test_contains("contains");
+
+    // Test cardinality sketches
+    test_sketch("sketch");
+
+    // Test MinHash signatures
+    test_minhash("minhash");
+
+    // Test count only set operations
+    test_counts("counts");
+
+    // Test subsets, supersets, and disjoint sets
+    test_subset("subset");
+
+    // Test in place updates
+    test_update("update");
+
+    // Test unions and intersections of many sets
+    test_many("many");
+
+    // Test set operations on worker threads
+    test_parallel("parallel");
+
+    // Test bulk construction from arrays of elements
+    test_bulk("bulk");
+
+    // Test batched adds and lookups
+    test_batch("batch");
+
+    // Test concurrent readers and writers
+    test_readers("readers");
+
+    // Test sharded sets
+    test_sharded("sharded");
+
+    // Test lock free sets
+    test_lockfree("lockfree");
+
+    // Test epoch based reclamation
+    test_epoch("epoch");
+
+    // Kernels
+    test_kernels("kernels");
+
     // Done
     return;
 }
@@ -709,13 +1075,13 @@ void test_one_element_set ( void (*set_constructor)(set **), char *name, void **
     print_test(name, "∩ { A, B, C }", test_intersection(set_constructor, construct_AB_addC_ABC, values, _elements, match));
 
     // Difference
-    //print_test(name, "Δ { A }", test_difference(set_constructor, construct_empty_addA_A, values, A_elements, match));
-    //print_test(name, "Δ { B }", test_difference(set_constructor, construct_empty_addB_B, values, B_elements, match));
-    //print_test(name, "Δ { C }", test_difference(set_constructor, construct_empty_addC_C, values, C_elements, match));
-    //print_test(name, "Δ { A, B }", test_difference(set_constructor, construct_A_addB_AB, values, AB_elements, match));
-    //print_test(name, "Δ { A, C }", test_difference(set_constructor, construct_A_addC_AC, values, AC_elements, match));
-    //print_test(name, "Δ { B, C }", test_difference(set_constructor, construct_B_addC_BC, values, BC_elements, match));
-    //print_test(name, "Δ { A, B, C }", test_difference(set_constructor, construct_AB_addC_ABC, values, ABC_elements, match));
+    print_test(name, "Δ { A }", test_difference(set_constructor, construct_empty_addA_A, values, A_elements, match));
+    print_test(name, "Δ { B }", test_difference(set_constructor, construct_empty_addB_B, values, B_elements, match));
+    print_test(name, "Δ { C }", test_difference(set_constructor, construct_empty_addC_C, values, C_elements, match));
+    print_test(name, "Δ { A, B }", test_difference(set_constructor, construct_A_addB_AB, values, AB_elements, match));
+    print_test(name, "Δ { A, C }", test_difference(set_constructor, construct_A_addC_AC, values, AC_elements, match));
+    print_test(name, "Δ { B, C }", test_difference(set_constructor, construct_B_addC_BC, values, BC_elements, match));
+    print_test(name, "Δ { A, B, C }", test_difference(set_constructor, construct_AB_addC_ABC, values, ABC_elements, match));
 
     // Is subset?
     // Is superset?
@@ -760,13 +1126,13 @@ void test_two_element_set ( void (*set_constructor)(set **), char *name, void **
     print_test(name, "∩ { A, B, C }", test_intersection(set_constructor, construct_AB_addC_ABC, values, _elements, match));
 
     // Difference
-    //print_test(name, "Δ { A }", test_difference(set_constructor, construct_empty_addA_A, values, A_elements, match));
-    //print_test(name, "Δ { B }", test_difference(set_constructor, construct_empty_addB_B, values, B_elements, match));
-    //print_test(name, "Δ { C }", test_difference(set_constructor, construct_empty_addC_C, values, C_elements, match));
-    //print_test(name, "Δ { A, B }", test_difference(set_constructor, construct_A_addB_AB, values, AB_elements, match));
-    //print_test(name, "Δ { A, C }", test_difference(set_constructor, construct_A_addC_AC, values, AC_elements, match));
-    //print_test(name, "Δ { B, C }", test_difference(set_constructor, construct_B_addC_BC, values, BC_elements, match));
-    //print_test(name, "Δ { A, B, C }", test_difference(set_constructor, construct_AB_addC_ABC, values, ABC_elements, match));
+    print_test(name, "Δ { A }", test_difference(set_constructor, construct_empty_addA_A, values, A_elements, match));
+    print_test(name, "Δ { B }", test_difference(set_constructor, construct_empty_addB_B, values, B_elements, match));
+    print_test(name, "Δ { C }", test_difference(set_constructor, construct_empty_addC_C, values, C_elements, match));
+    print_test(name, "Δ { A, B }", test_difference(set_constructor, construct_A_addB_AB, values, AB_elements, match));
+    print_test(name, "Δ { A, C }", test_difference(set_constructor, construct_A_addC_AC, values, AC_elements, match));
+    print_test(name, "Δ { B, C }", test_difference(set_constructor, construct_B_addC_BC, values, BC_elements, match));
+    print_test(name, "Δ { A, B, C }", test_difference(set_constructor, construct_AB_addC_ABC, values, ABC_elements, match));
 
     // Is subset?
     // Is superset?
@@ -811,13 +1177,13 @@ void test_three_element_set ( void (*set_constructor)(set **), char *name, void
     print_test(name, "∩ { A, B, C }", test_intersection(set_constructor, construct_AB_addC_ABC, values, _elements, match));
 
     // Difference
-    // print_test(name, "Δ { A }", test_difference(set_constructor, construct_empty_addA_A, values, A_elements, match));
-    // print_test(name, "Δ { B }", test_difference(set_constructor, construct_empty_addB_B, values, B_elements, match));
-    // print_test(name, "Δ { C }", test_difference(set_constructor, construct_empty_addC_C, values, C_elements, match));
-    // print_test(name, "Δ { A, B }", test_difference(set_constructor, construct_A_addB_AB, values, AB_elements, match));
-    // print_test(name, "Δ { A, C }", test_difference(set_constructor, construct_A_addC_AC, values, AC_elements, match));
-    // print_test(name, "Δ { B, C }", test_difference(set_constructor, construct_B_addC_BC, values, BC_elements, match));
-    // print_test(name, "Δ { A, B, C }", test_difference(set_constructor, construct_AB_addC_ABC, values, ABC_elements, match));
+    print_test(name, "Δ { A }", test_difference(set_constructor, construct_empty_addA_A, values, A_elements, match));
+    print_test(name, "Δ { B }", test_difference(set_constructor, construct_empty_addB_B, values, B_elements, match));
+    print_test(name, "Δ { C }", test_difference(set_constructor, construct_empty_addC_C, values, C_elements, match));
+    print_test(name, "Δ { A, B }", test_difference(set_constructor, construct_A_addB_AB, values, AB_elements, match));
+    print_test(name, "Δ { A, C }", test_difference(set_constructor, construct_A_addC_AC, values, AC_elements, match));
+    print_test(name, "Δ { B, C }", test_difference(set_constructor, construct_B_addC_BC, values, BC_elements, match));
+    print_test(name, "Δ { A, B, C }", test_difference(set_constructor, construct_AB_addC_ABC, values, ABC_elements, match));
 
     // Is subset?
     // Is superset?
@@ -890,7 +1256,7 @@ bool test_union ( void(*set_constructor)(set **pp_set), void(*set_constructor2)(
     set_constructor2(&p_set2);
 
     // Compute the union of set1 and set2
-    set_union(&p_set, p_set1, p_set2, strcmp);
+    set_union(&p_set, p_set1, p_set2, (set_equal_fn *) strcmp);
 
     // Get the contents of the set
     set_contents(p_set, contents);
@@ -960,7 +1326,7 @@ bool test_intersection ( void(*set_constructor)(set **pp_set), void(*set_constru
     set_constructor2(&p_set2);
 
     // Compute the union of set1 and set2
-    set_intersection(&p_set, p_set1, p_set2, strcmp);
+    set_intersection(&p_set, p_set1, p_set2, (set_equal_fn *) strcmp);
 
     // Get the contents of the set
     set_contents(p_set, contents);
@@ -1021,14 +1387,15 @@ bool test_difference ( void(*set_constructor)(set **pp_set), void(*set_construct
     void     *contents[4] = { 0 };
     void     *contents1[4] = { 0 };
     void     *contents2[4] = { 0 };
-    bool      found = false;
+    bool      found = false,
+              pass  = true;
 
     // Build the set
     set_constructor(&p_set1);
     set_constructor2(&p_set2);
 
-    // Compute the union of set1 and set2
-    set_difference(&p_set, p_set1, p_set2, strcmp);
+    // Compute the difference of set1 and set2
+    set_difference(&p_set, p_set1, p_set2, (set_equal_fn *) strcmp);
 
     // Get the contents of the set
     set_contents(p_set, contents);
@@ -1040,33 +1407,30 @@ bool test_difference ( void(*set_constructor)(set **pp_set), void(*set_construct
     count1 = set_contents(p_set1, 0);
     count2 = set_contents(p_set2, 0);
 
-    // Check each value
-    for (size_t i = 0; i < count; i++)
+    // Check each value in set 1
+    for (size_t j = 0; j < count1; j++)
     {
-        found = false;
 
-        for (size_t j = 0; j < count1; j++)
-        {
-            found = ( strcmp( contents[i], contents1[j] ) == 0 );
+        // Is the value in set 2?
+        bool in_set2 = false;
 
-            if ( found == true ) break;
-            
-        }
-        
-        if ( found == true ) continue;
+        for (size_t k = 0; k < count2; k++)
+            if ( strcmp(contents1[j], contents2[k]) == 0 ) in_set2 = true;
 
-        for (size_t j = 0; j < count2; j++)
-        {
-            found = ( strcmp( contents[i], contents2[j] ) == 0 );
+        // Is the value in the difference?
+        found = false;
 
-            if ( found == true ) break;
-            
-        }
-        
-        if ( found == false ) break;
+        for (size_t i = 0; i < count; i++)
+            if ( strcmp(contents1[j], contents[i]) == 0 ) found = true;
+
+        // The value must be in the difference IF it is not in set 2
+        if ( found == in_set2 ) pass = false;
     }
+
+    // Every value in the difference must come from set 1
+    if ( count > count1 ) pass = false;
     
-    result = (found) ? match : zero;
+    result = (pass) ? match : zero;
 
     // Free the set
     set_destroy(&p_set1);
@@ -1081,7 +1445,7 @@ void construct_empty ( set **pp_set )
 {
 
     // Construct the set
-    set_construct(pp_set, 4, strcmp);
+    set_construct(pp_set, 4, (set_equal_fn *) strcmp);
 
     // Done
     return;
@@ -1383,3 +1747,1710 @@ void construct_ABC_removeB_AC ( set **pp_set )
     // Done
     return;
 }
+
+unsigned long long hash_string ( const void *const p_string )
+{
+
+    // Initialized data
+    const unsigned char *p = p_string;
+    unsigned long long   h = 0xcbf29ce484222325ULL;
+
+    // FNV-1a
+    while ( *p ) h = ( h ^ *p++ ) * 0x100000001b3ULL;
+
+    // Success
+    return h;
+}
+
+void test_hashed_set ( char *name )
+{
+
+    // Initialized data
+    set    *p_a        = 0,
+           *p_b        = 0,
+           *p_s        = 0,
+           *p_result   = 0;
+    void   *contents[4] = { 0 };
+    bool    found      = true,
+            empty      = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Construct { 1, 2, ..., 4096 } and { 2049, 2050, ..., 6144 }, growing from one element
+    set_construct_hashed(&p_a, 1, 0, 0);
+    set_construct_hashed(&p_b, 1, 0, 0);
+
+    // Add each element twice
+    for (size_t i = 1; i <= 4096; i++) set_add(p_a, (void *) i), set_add(p_a, (void *) i);
+    for (size_t i = 2049; i <= 6144; i++) set_add(p_b, (void *) i), set_add(p_b, (void *) i);
+
+    // Count
+    print_test(name, "count", set_count(p_a) == 4096);
+
+    // Union
+    set_union(&p_result, p_a, p_b, 0);
+    print_test(name, "∪", set_count(p_result) == 6144);
+    set_destroy(&p_result);
+
+    // Intersection
+    set_intersection(&p_result, p_a, p_b, 0);
+    print_test(name, "∩", set_count(p_result) == 2048);
+    set_destroy(&p_result);
+
+    // Disjoint
+    print_test(name, "disjoint", set_isdisjoint(p_a, p_b) == false);
+
+    // Remove the odd elements
+    for (size_t i = 1; i <= 4096; i += 2) set_remove(p_a, (void *) i);
+    print_test(name, "remove", set_count(p_a) == 2048);
+    print_test(name, "remove absent", set_remove(p_a, (void *) 1) == 0);
+
+    // Re-add the odd elements, recycling tombstones
+    for (size_t i = 1; i <= 4096; i += 2) set_add(p_a, (void *) i);
+    print_test(name, "add after remove", set_count(p_a) == 4096);
+
+    // Pop every element
+    for (size_t i = 0; i < 4096; i++) set_pop(p_a, contents);
+    print_test(name, "pop", set_count(p_a) == 0 && set_remove(p_a, (void *) 2) == 0);
+
+    // Pop from an empty set of every kind
+    for (size_t i = 0; i < 7; i++)
+        construct_kind(&p_result, i, 3000, 1),
+        empty &= set_pop(p_result, contents) == 0 && set_count(p_result) == 0,
+        set_destroy(&p_result);
+    print_test(name, "pop empty", empty);
+
+    // Grow a linear set past its initial size
+    set_destroy(&p_b);
+    set_construct(&p_b, 1, 0);
+    for (size_t i = 1; i <= 64; i++) set_add(p_b, (void *) i), set_add(p_b, (void *) i);
+    print_test(name, "linear grow", set_count(p_b) == 64);
+
+    // Construct { A, B, C } from copies of the strings
+    set_construct_hashed(&p_s, 4, (set_equal_fn *) strcmp, hash_string);
+    set_add(p_s, "A"), set_add(p_s, "B"), set_add(p_s, "C");
+    set_add(p_s, (char []) { 'A', '\0' });
+    print_test(name, "strings", set_count(p_s) == 3);
+
+    // Remove B by value
+    set_remove(p_s, (char []) { 'B', '\0' });
+    set_contents(p_s, contents);
+    for (size_t i = 0; i < set_count(p_s); i++) found &= ( strcmp(contents[i], "B") != 0 );
+    print_test(name, "strings remove", found && set_count(p_s) == 2);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+    set_destroy(&p_s);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+bool is_sorted ( set *p_set )
+{
+
+    // Initialized data
+    size_t   count      = set_count(p_set);
+    void   **p_contents = malloc(( count + 1 ) * sizeof(void *));
+    bool     result     = true;
+
+    // Get the contents of the set
+    set_contents(p_set, p_contents);
+
+    // Check each pair of neighbors
+    for (size_t i = 1; i < count; i++) result &= ( p_contents[i - 1] < p_contents[i] );
+
+    // Clean up
+    free(p_contents);
+
+    // Done
+    return result;
+}
+
+void test_sorted_set ( char *name )
+{
+
+    // Initialized data
+    set    *p_a        = 0,
+           *p_b        = 0,
+           *p_s        = 0,
+           *p_result   = 0;
+    void   *contents[4] = { 0 };
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Construct { 1, 2, ..., 4096 } and { 2049, 2050, ..., 6144 } in a scrambled order
+    set_construct_sorted(&p_a, 1, 0);
+    set_construct_sorted(&p_b, 1, 0);
+
+    // Add each element twice
+    for (size_t i = 0; i < 4096; i++) set_add(p_a, (void *) ( ( i * 2897 ) % 4096 + 1 )), set_add(p_a, (void *) ( i + 1 ));
+    for (size_t i = 0; i < 4096; i++) set_add(p_b, (void *) ( ( i * 2897 ) % 4096 + 2049 )), set_add(p_b, (void *) ( i + 2049 ));
+
+    // Count
+    print_test(name, "count", set_count(p_a) == 4096 && is_sorted(p_a));
+
+    // Union
+    set_union(&p_result, p_a, p_b, 0);
+    print_test(name, "∪", set_count(p_result) == 6144 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Intersection
+    set_intersection(&p_result, p_a, p_b, 0);
+    print_test(name, "∩", set_count(p_result) == 2048 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Difference
+    set_difference(&p_result, p_a, p_b, 0);
+    print_test(name, "-", set_count(p_result) == 2048 && is_sorted(p_result) && set_remove(p_result, (void *) 2049) == 0);
+    set_destroy(&p_result);
+
+    // Symmetric difference
+    set_symmetric_difference(&p_result, p_a, p_b, 0);
+    print_test(name, "Δ", set_count(p_result) == 4096 && is_sorted(p_result) && set_remove(p_result, (void *) 4096) == 0);
+    set_destroy(&p_result);
+
+    // Disjoint
+    print_test(name, "disjoint", set_isdisjoint(p_a, p_b) == false);
+
+    // Skewed intersection
+    set_construct_sorted(&p_s, 1, 0);
+    for (size_t i = 0; i < 50; i++) set_add(p_s, (void *) ( i * 97 + 7 ));
+    set_intersection(&p_result, p_s, p_a, 0);
+    print_test(name, "∩ skewed", set_count(p_result) == 43 && is_sorted(p_result));
+    set_destroy(&p_result);
+    set_intersection(&p_result, p_a, p_s, 0);
+    print_test(name, "∩ skewed reversed", set_count(p_result) == 43 && is_sorted(p_result));
+    set_destroy(&p_result);
+    print_test(name, "disjoint skewed", set_isdisjoint(p_s, p_a) == false);
+    set_destroy(&p_s);
+    set_construct_sorted(&p_s, 1, 0);
+    for (size_t i = 0; i < 50; i++) set_add(p_s, (void *) ( i + 10000 ));
+    print_test(name, "disjoint skewed, no common elements", set_isdisjoint(p_a, p_s));
+    set_destroy(&p_s);
+
+    // Remove the odd elements
+    for (size_t i = 1; i <= 4096; i += 2) set_remove(p_a, (void *) i);
+    print_test(name, "remove", set_count(p_a) == 2048 && is_sorted(p_a));
+    print_test(name, "remove absent", set_remove(p_a, (void *) 1) == 0);
+
+    // Construct { A, B, C } out of order
+    set_construct_sorted(&p_s, 1, (set_compare_fn *) strcmp);
+    set_add(p_s, "C"), set_add(p_s, "A"), set_add(p_s, "B");
+    set_add(p_s, (char []) { 'A', '\0' });
+    set_contents(p_s, contents);
+    print_test(name, "strings", set_count(p_s) == 3 && strcmp(contents[0], "A") == 0 && strcmp(contents[2], "C") == 0);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+    set_destroy(&p_s);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_roaring_set ( char *name )
+{
+
+    // Initialized data
+    set  *p_a      = 0,
+         *p_b      = 0,
+         *p_s      = 0,
+         *p_result = 0;
+    void *p_value  = 0;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Construct a dense range { 0, 1, ..., 199999 } and a sparse range { 150000, 150003, ..., 449997 }
+    set_construct_roaring(&p_a);
+    set_construct_roaring(&p_b);
+    for (size_t i = 200000; i-- > 0;) set_add(p_a, (void *) i);
+    for (size_t i = 0; i < 100000; i++) set_add(p_b, (void *) ( 150000 + i * 3 )), set_add(p_b, (void *) ( 150000 + i * 3 ));
+
+    // Count
+    print_test(name, "count", set_count(p_a) == 200000 && set_count(p_b) == 100000 && is_sorted(p_a) && is_sorted(p_b));
+
+    // Union
+    set_union(&p_result, p_a, p_b, 0);
+    print_test(name, "∪", set_count(p_result) == 200000 + 100000 - 16667 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Intersection
+    set_intersection(&p_result, p_a, p_b, 0);
+    print_test(name, "∩", set_count(p_result) == 16667 && is_sorted(p_result) && set_remove(p_result, (void *) 150003) == 1);
+    set_destroy(&p_result);
+
+    // Difference
+    set_difference(&p_result, p_a, p_b, 0);
+    print_test(name, "-", set_count(p_result) == 200000 - 16667 && is_sorted(p_result) && set_remove(p_result, (void *) 150003) == 0);
+    set_destroy(&p_result);
+
+    // Symmetric difference
+    set_symmetric_difference(&p_result, p_a, p_b, 0);
+    print_test(name, "Δ", set_count(p_result) == 200000 + 100000 - 2 * 16667 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Disjoint
+    print_test(name, "disjoint", set_isdisjoint(p_a, p_b) == false);
+
+    // Roaring and sorted sets
+    set_construct_sorted(&p_s, 1, 0);
+    for (size_t i = 0; i < 50; i++) set_add(p_s, (void *) ( i * 9973 ));
+    set_intersection(&p_result, p_s, p_b, 0);
+    print_test(name, "∩ sorted", set_count(p_result) == 10 && is_sorted(p_result));
+    set_destroy(&p_result);
+    print_test(name, "disjoint sorted", set_isdisjoint(p_b, p_s) == false && set_isdisjoint(p_s, p_b) == false);
+    set_destroy(&p_s);
+
+    // Remove every other element of the dense range
+    for (size_t i = 0; i < 200000; i += 2) set_remove(p_a, (void *) i);
+    print_test(name, "remove", set_count(p_a) == 100000 && is_sorted(p_a));
+    print_test(name, "remove absent", set_remove(p_a, (void *) 0) == 0);
+
+    // Pop the greatest element
+    print_test(name, "pop", set_pop(p_a, &p_value) == 1 && p_value == (void *) 199999 && set_count(p_a) == 99999);
+
+    // Elements must be 32 bit integers
+    if ( sizeof(void *) > sizeof(uint32_t) )
+        print_test(name, "add out of range", set_add(p_a, (void *) ( (uintptr_t) UINT32_MAX + 1 )) == 0);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_bitset_set ( char *name )
+{
+
+    // Initialized data
+    set  *p_a      = 0,
+         *p_b      = 0,
+         *p_s      = 0,
+         *p_result = 0;
+    void *p_value  = 0;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Construct the multiples of 2 below 1000, and the multiples of 3 below 1500
+    set_construct_bitset(&p_a, 1000);
+    set_construct_bitset(&p_b, 1500);
+    for (size_t i = 0; i < 1000; i += 2) set_add(p_a, (void *) i), set_add(p_a, (void *) i);
+    for (size_t i = 0; i < 1500; i += 3) set_add(p_b, (void *) i);
+
+    // Count
+    print_test(name, "count", set_count(p_a) == 500 && set_count(p_b) == 500 && is_sorted(p_a));
+
+    // Union
+    set_union(&p_result, p_a, p_b, 0);
+    print_test(name, "∪", set_count(p_result) == 500 + 500 - 167 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Intersection
+    set_intersection(&p_result, p_a, p_b, 0);
+    print_test(name, "∩", set_count(p_result) == 167 && is_sorted(p_result) && set_remove(p_result, (void *) 6) == 1);
+    set_destroy(&p_result);
+
+    // Difference
+    set_difference(&p_result, p_a, p_b, 0);
+    print_test(name, "-", set_count(p_result) == 500 - 167 && set_remove(p_result, (void *) 6) == 0);
+    set_destroy(&p_result);
+
+    // Symmetric difference
+    set_symmetric_difference(&p_result, p_a, p_b, 0);
+    print_test(name, "Δ", set_count(p_result) == 500 + 500 - 2 * 167 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Disjoint
+    print_test(name, "disjoint", set_isdisjoint(p_a, p_b) == false);
+
+    // Bitset and hashed sets
+    set_construct_hashed(&p_s, 1, 0, 0);
+    set_add(p_s, (void *) 1), set_add(p_s, (void *) 999), set_add(p_s, (void *) 1200);
+    set_union(&p_result, p_a, p_s, 0);
+    print_test(name, "∪ hashed", set_count(p_result) == 503);
+    set_destroy(&p_result);
+    print_test(name, "disjoint hashed", set_isdisjoint(p_a, p_s) && set_isdisjoint(p_s, p_b) == false);
+    set_destroy(&p_s);
+
+    // Remove
+    print_test(name, "remove", set_remove(p_a, (void *) 998) == 1 && set_count(p_a) == 499);
+    print_test(name, "remove absent", set_remove(p_a, (void *) 998) == 0 && set_remove(p_a, (void *) 5000) == 0);
+
+    // Pop the greatest element
+    print_test(name, "pop", set_pop(p_a, &p_value) == 1 && p_value == (void *) 996 && set_count(p_a) == 498);
+
+    // Elements must be less than the universe size
+    print_test(name, "add out of range", set_add(p_a, (void *) 1000) == 0);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+int compare_u32 ( const void *a, const void *b )
+{
+
+    // Done
+    return ( *(const uint32_t *) a > *(const uint32_t *) b ) - ( *(const uint32_t *) a < *(const uint32_t *) b );
+}
+
+int compare_descending ( const void *a, const void *b )
+{
+
+    // Done
+    return ( a < b ) - ( a > b );
+}
+
+int lookup_task ( void *const p_argument )
+{
+
+    // Initialized data
+    lookup *p_lookup = p_argument;
+
+    // The writer adds the odd keys
+    if ( p_lookup->index == 0 )
+        for (size_t i = 1; i < 3000; i += 2) set_add(p_lookup->p_set, (void *) i);
+
+    // Readers intersect the other set with the set, many times over
+    else if ( p_lookup->p_other )
+        for (size_t round = 0; round < 20; round++) p_lookup->found += set_intersection_count(p_lookup->p_other, p_lookup->p_set);
+
+    // Readers look up the even keys, many times over
+    else
+        for (size_t round = 0; round < 20; round++)
+            for (size_t i = 0; i < 3000; i += 2) p_lookup->found += set_contains(p_lookup->p_set, (void *) i);
+
+    // Success
+    return 1;
+}
+
+int writer_task ( void *const p_argument )
+{
+
+    // Initialized data
+    writer *p_writer = p_argument;
+    size_t  start    = p_writer->index * 5000;
+
+    // Remove the odd keys of the first half
+    if ( p_writer->remove )
+        for (size_t i = start + 1; i < start + 5000; i += 2) p_writer->removed += sharded_remove(p_writer->p_sharded, (void *) i);
+
+    // Add 10000 keys. The second half are the first half of the next writer
+    else
+        for (size_t i = start; i < start + 10000; i++) p_writer->added += sharded_add(p_writer->p_sharded, (void *) i);
+
+    // Success
+    return 1;
+}
+
+int hammer_task ( void *const p_argument )
+{
+
+    // Initialized data
+    hammer *p_hammer = p_argument;
+    size_t  start    = p_hammer->index * 6250;
+
+    // Every thread adds every key, starting at a different place
+    if ( p_hammer->phase == 0 )
+        for (size_t i = 0; i < 50000; i++) lockfree_add(p_hammer->p_lockfree, (void *) ( ( start + i ) % 50000 ));
+
+    // Every thread removes every key, and counts the keys it removed
+    else if ( p_hammer->phase == 1 )
+        for (size_t i = 0; i < 50000; i++) p_hammer->removed += lockfree_remove(p_hammer->p_lockfree, (void *) ( ( start + i ) % 50000 ));
+
+    // Every thread adds and removes the same few keys, over and over
+    else if ( p_hammer->phase == 3 )
+        for (size_t i = 0; i < 50000; i++)
+            lockfree_add(p_hammer->p_lockfree, (void *) ( ( start + i ) % 64 )),
+            (void)lockfree_remove(p_hammer->p_lockfree, (void *) ( ( start + i + 1 ) % 64 ));
+
+    // Each thread adds its own keys, removes the odd ones, and looks up the keys of the next thread
+    else
+        for (size_t i = p_hammer->index; i < 50000; i += 8)
+            lockfree_add(p_hammer->p_lockfree, (void *) i),
+            (void)lockfree_contains(p_hammer->p_lockfree, (void *) ( ( i + 1 ) % 50000 )),
+            ( i % 2 ) ? lockfree_remove(p_hammer->p_lockfree, (void *) i) : 0;
+
+    // Success
+    return 1;
+}
+
+int construct_kind ( set **pp_set, size_t kind, size_t start, size_t step )
+{
+
+    // Construct a linear, hashed, sorted, reverse sorted, roaring, bitset, or frozen set
+    switch ( kind )
+    {
+        case 0: set_construct(pp_set, 1, 0); break;
+        case 1: set_construct_hashed(pp_set, 1, 0, 0); break;
+        case 2: set_construct_sorted(pp_set, 1, 0); break;
+        case 3: set_construct_sorted(pp_set, 1, compare_descending); break;
+        case 4: set_construct_roaring(pp_set); break;
+        case 5: set_construct_bitset(pp_set, 3000); break;
+        default: set_construct_sorted(pp_set, 1, 0); break;
+    }
+
+    // Add the elements
+    for (size_t i = start; i < 3000; i += step) set_add(*pp_set, (void *) i);
+
+    // Compress the last kind
+    if ( kind == 6 ) set_freeze(*pp_set);
+
+    // Done
+    return *pp_set != 0;
+}
+
+void test_many ( char *name )
+{
+
+    // Initialized data
+    set  *p_sets[4]    = { 0 },
+         *p_pair       = 0,
+         *p_union      = 0,
+         *p_common     = 0,
+         *p_result     = 0;
+    bool  union_ok     = true,
+          intersection = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // The union of the multiples of 2, 3, and 5, below 3000, has 2200 elements, and the intersection has 100
+    construct_kind(&p_sets[0], 1, 0, 2), construct_kind(&p_sets[1], 1, 0, 3), construct_kind(&p_sets[2], 1, 0, 5);
+    set_union(&p_pair, p_sets[0], p_sets[1], 0), set_union(&p_union, p_pair, p_sets[2], 0), set_destroy(&p_pair);
+    set_intersection(&p_pair, p_sets[0], p_sets[1], 0), set_intersection(&p_common, p_pair, p_sets[2], 0), set_destroy(&p_pair);
+    for (size_t k = 0; k < 3; k++) set_destroy(&p_sets[k]);
+
+    // Operands of the same kind, and of mixed kinds
+    for (size_t i = 0; i < 7; i++)
+        for (size_t mixed = 0; mixed < 2; mixed++)
+        {
+
+            // Construct the operands, largest first
+            construct_kind(&p_sets[0], i, 0, 2);
+            construct_kind(&p_sets[1], ( i + mixed ) % 7, 0, 3);
+            construct_kind(&p_sets[2], ( i + 2 * mixed ) % 7, 0, 5);
+
+            // Union
+            union_ok &= set_union_n(&p_result, (const set **) p_sets, 3, 0) == 1 && set_count(p_result) == 2200 && set_issubset(p_union, p_result);
+            set_destroy(&p_result);
+
+            // Intersection
+            intersection &= set_intersection_n(&p_result, (const set **) p_sets, 3, 0) == 1 && set_count(p_result) == 100 && set_issubset(p_common, p_result);
+            set_destroy(&p_result);
+
+            // Clean up
+            for (size_t k = 0; k < 3; k++) set_destroy(&p_sets[k]);
+        }
+    print_test(name, "union", union_ok);
+    print_test(name, "intersection", intersection);
+
+    // Sorted sets are merged in order
+    {
+
+        // Initialized data
+        void *contents[2200] = { 0 };
+        bool  ordered        = true;
+
+        // Merge three descending sets
+        construct_kind(&p_sets[0], 3, 0, 2), construct_kind(&p_sets[1], 3, 0, 3), construct_kind(&p_sets[2], 3, 0, 5);
+        set_union_n(&p_result, (const set **) p_sets, 3, 0);
+        set_contents(p_result, contents);
+        for (size_t i = 1; i < 2200; i++) ordered &= contents[i - 1] > contents[i];
+        print_test(name, "sorted", set_count(p_result) == 2200 && ordered);
+        set_destroy(&p_result);
+        for (size_t k = 0; k < 3; k++) set_destroy(&p_sets[k]);
+    }
+
+    // An empty operand empties the intersection
+    construct_kind(&p_sets[0], 1, 0, 2), construct_kind(&p_sets[1], 1, 0, 3), set_construct_hashed(&p_sets[2], 1, 0, 0);
+    print_test(name, "empty", set_intersection_n(&p_result, (const set **) p_sets, 3, 0) == 1 && set_count(p_result) == 0 && set_add(p_result, (void *) 7) && set_contains(p_result, (void *) 7));
+    set_destroy(&p_result);
+
+    // One operand is a copy
+    print_test(name, "one", set_union_n(&p_result, (const set **) p_sets, 1, 0) == 1 && set_count(p_result) == 1500 && set_issubset(p_sets[0], p_result));
+    set_destroy(&p_result);
+
+    // Argument errors
+    p_sets[3] = 0;
+    print_test(name, "null", set_union_n(&p_result, (const set **) p_sets, 4, 0) == 0 && set_intersection_n(&p_result, (const set **) p_sets, 0, 0) == 0 && set_union_n(0, (const set **) p_sets, 1, 0) == 0);
+    for (size_t k = 0; k < 3; k++) set_destroy(&p_sets[k]);
+
+    // Free the sets
+    set_destroy(&p_union);
+    set_destroy(&p_common);
+
+    // Done
+    return;
+}
+
+void test_parallel ( char *name )
+{
+
+    // Initialized data
+    set  *p_a            = 0,
+         *p_b            = 0,
+         *p_union        = 0,
+         *p_difference   = 0,
+         *p_intersection = 0,
+         *p_result       = 0;
+    bool  union_ok       = true,
+          difference     = true,
+          intersection   = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Hashed, sorted, reverse sorted, and mixed operands, large enough to split
+    for (size_t i = 0; i < 4; i++)
+    {
+
+        // Construct the operands
+        switch ( i )
+        {
+            case 0: set_construct_hashed(&p_a, 1, 0, 0), set_construct_hashed(&p_b, 1, 0, 0); break;
+            case 1: set_construct_sorted(&p_a, 1, 0), set_construct_sorted(&p_b, 1, 0); break;
+            case 2: set_construct_sorted(&p_a, 1, compare_descending), set_construct_sorted(&p_b, 1, compare_descending); break;
+            case 3: set_construct_hashed(&p_a, 1, 0, 0), set_construct_sorted(&p_b, 1, 0); break;
+        }
+
+        // Set A holds the multiples of 2, and set B the multiples of 3, below 200000. Sorted sets append
+        for (size_t j = 0; j < 200000; j++)
+        {
+
+            // Initialized data
+            size_t k = ( i == 2 ) ? 199999 - j : j;
+
+            // Add the element
+            if ( k % 2 == 0 ) set_add(p_a, (void *) k);
+            if ( k % 3 == 0 ) set_add(p_b, (void *) k);
+        }
+
+        // Compute the expected results on the calling thread
+        if ( i == 0 ) set_union(&p_union, p_a, p_b, 0), set_difference(&p_difference, p_a, p_b, 0), set_intersection(&p_intersection, p_a, p_b, 0);
+
+        // Compare each operation with the expected result, on 2 threads, and on 5 threads
+        for (size_t threads = 2; threads < 8; threads += 3)
+        {
+            union_ok &= set_union_parallel(&p_result, p_a, p_b, 0, threads) == 1 && set_count(p_result) == 133333 && set_issubset(p_result, p_union);
+            set_destroy(&p_result);
+
+            difference &= set_difference_parallel(&p_result, p_a, p_b, 0, threads) == 1 && set_count(p_result) == 66666 && set_issubset(p_result, p_difference);
+            set_destroy(&p_result);
+
+            intersection &= set_intersection_parallel(&p_result, p_a, p_b, 0, threads) == 1 && set_count(p_result) == 33334 && set_issubset(p_result, p_intersection);
+            set_destroy(&p_result);
+        }
+
+        // Clean up
+        set_destroy(&p_a), set_destroy(&p_b);
+    }
+    print_test(name, "union", union_ok);
+    print_test(name, "difference", difference);
+    print_test(name, "intersection", intersection);
+
+    // Sorted results stay in order, and hashed results are indexed
+    {
+
+        // Initialized data
+        static void *contents[133333] = { 0 };
+        bool         ordered          = true;
+
+        // Merge two sorted sets
+        set_construct_sorted(&p_a, 1, 0), set_construct_sorted(&p_b, 1, 0);
+        for (size_t j = 0; j < 200000; j += 2) set_add(p_a, (void *) j);
+        for (size_t j = 0; j < 200000; j += 3) set_add(p_b, (void *) j);
+        set_union_parallel(&p_result, p_a, p_b, 0, 7);
+        set_contents(p_result, contents);
+        for (size_t j = 1; j < 133333; j++) ordered &= contents[j - 1] < contents[j];
+        print_test(name, "sorted", set_count(p_result) == 133333 && ordered);
+        set_destroy(&p_result), set_destroy(&p_a), set_destroy(&p_b);
+
+        // Grow and shrink the union of two hashed sets
+        set_intersection_parallel(&p_result, p_union, p_union, 0, 3);
+        print_test(name, "hashed", set_add(p_result, (void *) 1) && set_contains(p_result, (void *) 1) && set_contains(p_result, (void *) 199998) && set_remove(p_result, (void *) 0) && set_contains(p_result, (void *) 0) == false && set_count(p_result) == 133333);
+        set_destroy(&p_result);
+    }
+
+    // Small sets, and compact sets, are combined on the calling thread
+    construct_kind(&p_a, 1, 0, 2), construct_kind(&p_b, 4, 0, 3);
+    print_test(name, "small", set_union_parallel(&p_result, p_a, p_b, 0, 64) == 1 && set_count(p_result) == 2000);
+    set_destroy(&p_result);
+    print_test(name, "null", set_union_parallel(0, p_a, p_b, 0, 2) == 0 && set_intersection_parallel(&p_result, 0, p_b, 0, 2) == 0 && set_difference_parallel(&p_result, p_a, 0, 0, 2) == 0);
+    set_destroy(&p_a), set_destroy(&p_b);
+
+    // Free the sets
+    set_destroy(&p_union);
+    set_destroy(&p_difference);
+    set_destroy(&p_intersection);
+
+    // Done
+    return;
+}
+
+void test_bulk ( char *name )
+{
+
+    // Initialized data
+    static void *elements[300000] = { 0 },
+                *contents[100000] = { 0 };
+    const void  *small[6]         = { (void *) 3, (void *) 1, (void *) 3, (void *) 2, (void *) 1, (void *) 0 };
+    set         *p_set            = 0;
+    bool         ordered          = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Each of 100000 elements appears three times. The first 100000 are a permutation
+    for (size_t i = 0; i < 300000; i++) elements[i] = (void *) ( ( i * 7919 ) % 100000 );
+
+    // Linear sets keep the first of each group of equal elements, in input order
+    set_from_elements(&p_set, (const void **) elements, 300000, 0);
+    set_contents(p_set, contents);
+    for (size_t i = 0; i < 100000; i++) ordered &= contents[i] == elements[i];
+    print_test(name, "linear", set_count(p_set) == 100000 && ordered && set_add(p_set, (void *) 100000) && set_count(p_set) == 100001);
+    set_destroy(&p_set);
+
+    // Hashed sets
+    set_from_elements_hashed(&p_set, (const void **) elements, 300000, 0, 0, 4);
+    set_contents(p_set, contents);
+    ordered = true;
+    for (size_t i = 0; i < 100000; i++) ordered &= contents[i] == elements[i];
+    print_test(name, "hashed", set_count(p_set) == 100000 && ordered && set_contains(p_set, (void *) 99999) && set_contains(p_set, (void *) 100000) == false);
+    print_test(name, "hashed add", set_add(p_set, (void *) 5) && set_count(p_set) == 100000 && set_add(p_set, (void *) 100000) && set_remove(p_set, (void *) 7) && set_contains(p_set, (void *) 7) == false && set_count(p_set) == 100000);
+    set_destroy(&p_set);
+
+    // Sorted sets, with an odd quantity of slices
+    set_from_elements_sorted(&p_set, (const void **) elements, 300000, compare_descending, 3);
+    set_contents(p_set, contents);
+    ordered = true;
+    for (size_t i = 0; i < 100000; i++) ordered &= contents[i] == (void *) ( 99999 - i );
+    print_test(name, "sorted", set_count(p_set) == 100000 && ordered && set_contains(p_set, (void *) 0));
+    set_destroy(&p_set);
+
+    // Small arrays are built on the calling thread
+    set_from_elements_sorted(&p_set, small, 6, 0, 0);
+    set_contents(p_set, contents);
+    print_test(name, "small", set_count(p_set) == 4 && contents[0] == (void *) 0 && contents[3] == (void *) 3);
+    set_destroy(&p_set);
+
+    // Equality functions fall back to adding each element
+    {
+
+        // Initialized data
+        char        a[]        = "A";
+        const void *strings[4] = { "A", "B", a, "B" };
+
+        // Equal strings at different addresses are duplicates
+        set_from_elements(&p_set, strings, 4, (set_equal_fn *) strcmp);
+        print_test(name, "equality", set_count(p_set) == 2);
+        set_destroy(&p_set);
+    }
+
+    // Argument errors
+    print_test(name, "null", set_from_elements_hashed(0, small, 6, 0, 0, 0) == 0 && set_from_elements_sorted(&p_set, 0, 6, 0, 0) == 0 && set_from_elements_sorted(&p_set, 0, 0, 0, 0) == 1 && set_count(p_set) == 0);
+    set_destroy(&p_set);
+
+    // Done
+    return;
+}
+
+void test_batch ( char *name )
+{
+
+    // Initialized data
+    void *batch[1000]   = { 0 },
+         *keys[3000]    = { 0 };
+    bool  results[3000] = { 0 };
+    set  *p_set         = 0;
+    bool  add           = true,
+          contains      = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // The batch holds the multiples of 3 below 2100, some of them twice, out of order
+    for (size_t i = 0; i < 1000; i++) batch[i] = (void *) ( ( ( i * 337 ) % 700 ) * 3 );
+    for (size_t i = 0; i < 3000; i++) keys[i]  = (void *) i;
+
+    // Add the batch to every kind of set, except frozen sets, that holds the multiples of 2
+    for (size_t i = 0; i < 6; i++)
+    {
+
+        // Construct the set
+        construct_kind(&p_set, i, 0, 2);
+
+        // Add the batch. Multiples of 6 are already in the set
+        add &= set_add_many(p_set, batch, 1000) == 1 && set_count(p_set) == 1500 + 700 - 350;
+
+        // Test every key against set_contains
+        contains &= set_contains_many(p_set, (const void **) keys, 3000, results) == 1850;
+        for (size_t j = 0; j < 3000; j++) contains &= results[j] == set_contains(p_set, keys[j]);
+
+        // Clean up
+        set_destroy(&p_set);
+    }
+    print_test(name, "add", add);
+    print_test(name, "contains", contains);
+
+    // Sorted sets stay in order
+    construct_kind(&p_set, 2, 0, 2);
+    set_add_many(p_set, batch, 1000);
+    print_test(name, "sorted", is_sorted(p_set));
+    set_destroy(&p_set);
+
+    // Bloom filters reject the keys that were never added
+    construct_kind(&p_set, 1, 0, 2);
+    set_enable_bloom(p_set);
+    set_add_many(p_set, batch, 1000);
+    print_test(name, "bloom", set_contains_many(p_set, (const void **) keys, 3000, 0) == 1850 && set_contains(p_set, (void *) 2097));
+    set_destroy(&p_set);
+
+    // Frozen sets are immutable. Half of the batch is even
+    construct_kind(&p_set, 6, 0, 2);
+    print_test(name, "frozen", set_add_many(p_set, batch, 1000) == 0 && set_contains_many(p_set, (const void **) batch, 1000, 0) == 500);
+    print_test(name, "null", set_add_many(0, batch, 1) == 0 && set_add_many(p_set, 0, 1) == 0 && set_contains_many(p_set, 0, 1, 0) == 0);
+    set_destroy(&p_set);
+
+    // Done
+    return;
+}
+
+void test_readers ( char *name )
+{
+
+    // Initialized data
+    lookup     lookups[6] = { 0 };
+    set_rwlock rwlock     = { 0 };
+    set       *p_set      = 0,
+              *p_evens    = 0;
+    bool       readers    = true,
+               writer     = true,
+               operands   = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Read hashed and sorted sets on five threads, while a sixth thread adds to them
+    for (size_t i = 1; i < 3; i++)
+    {
+
+        // Construct a set of the even keys below 3000
+        construct_kind(&p_set, i, 0, 2);
+
+        // Run the lookups
+        for (size_t j = 0; j < 6; j++) lookups[j] = (lookup) { .p_set = p_set, .index = j, .found = 0 };
+        set_parallel_run(lookup_task, lookups, sizeof(lookup), 6);
+
+        // Every reader finds every even key, every time
+        for (size_t j = 1; j < 6; j++) readers &= lookups[j].found == 1500 * 20;
+
+        // The writer adds the odd keys
+        writer &= set_count(p_set) == 3000 && set_contains(p_set, (void *) 2999);
+
+        // Clean up
+        set_destroy(&p_set);
+    }
+    print_test(name, "readers", readers);
+    print_test(name, "writer", writer);
+
+    // Intersect a set with hashed and sorted sets on five threads, while a sixth thread adds to them
+    construct_kind(&p_evens, 1, 0, 2);
+    for (size_t i = 1; i < 3; i++)
+    {
+
+        // Construct a set of the even keys below 3000
+        construct_kind(&p_set, i, 0, 2);
+
+        // Run the intersections
+        for (size_t j = 0; j < 6; j++) lookups[j] = (lookup) { .p_set = p_set, .p_other = p_evens, .index = j, .found = 0 };
+        set_parallel_run(lookup_task, lookups, sizeof(lookup), 6);
+
+        // Every reader shares every even key, every time
+        for (size_t j = 1; j < 6; j++) operands &= lookups[j].found == 1500 * 20;
+
+        // Clean up
+        set_destroy(&p_set);
+    }
+    set_destroy(&p_evens);
+    print_test(name, "operands", operands);
+
+    // Locks
+    print_test(name, "lock", 
+        set_rwlock_create(&rwlock)       == 1 &&
+        set_rwlock_read_lock(&rwlock)    == 1 && set_rwlock_read_unlock(&rwlock)  == 1 &&
+        set_rwlock_write_lock(&rwlock)   == 1 && set_rwlock_write_unlock(&rwlock) == 1 &&
+        set_rwlock_destroy(&rwlock)      == 1 &&
+        set_rwlock_create(0)             == 0
+    );
+
+    // Done
+    return;
+}
+
+void test_sharded ( char *name )
+{
+
+    // Initialized data
+    writer   writers[4] = { 0 };
+    sharded *p_sharded  = 0;
+    bool     add        = true,
+             contains   = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Shards are rounded up to a power of two
+    sharded_construct(&p_sharded, 5, 0, 0, 0);
+    print_test(name, "shards", sharded_shards(p_sharded) == 8);
+
+    // Four writers add the keys below 25000, then remove the odd keys below 20000
+    for (size_t i = 0; i < 4; i++) writers[i] = (writer) { .p_sharded = p_sharded, .index = i };
+    set_parallel_run(writer_task, writers, sizeof(writer), 4);
+    for (size_t i = 0; i < 4; i++) writers[i].remove = true;
+    set_parallel_run(writer_task, writers, sizeof(writer), 4);
+    for (size_t i = 0; i < 4; i++) add &= writers[i].added == 10000 && writers[i].removed == 2500;
+    print_test(name, "add", add);
+    print_test(name, "count", sharded_count(p_sharded) == 25000 - 10000);
+
+    // Odd keys below 20000 are gone, and the rest are there
+    for (size_t i = 0; i < 25000; i++) contains &= sharded_contains(p_sharded, (void *) i) == ( i >= 20000 || i % 2 == 0 );
+    print_test(name, "contains", contains);
+
+    // Clean up
+    sharded_destroy(&p_sharded);
+
+    // The default is four shards per hardware thread
+    sharded_construct(&p_sharded, 0, 100, 0, 0);
+    print_test(name, "default", sharded_shards(p_sharded) >= 4 && sharded_add(p_sharded, (void *) 1) && sharded_count(p_sharded) == 1);
+    sharded_destroy(&p_sharded);
+    print_test(name, "null", sharded_construct(0, 1, 1, 0, 0) == 0 && sharded_add(0, 0) == 0 && sharded_count(0) == 0 && sharded_contains(0, 0) == false);
+
+    // Done
+    return;
+}
+
+void test_lockfree ( char *name )
+{
+
+    // Initialized data
+    hammer    hammers[8]  = { 0 };
+    lockfree *p_lockfree  = 0;
+    size_t    removed     = 0,
+              left        = 0;
+    bool      contains    = true,
+              gone        = true,
+              mixed       = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Start small, so the table is resized many times under the threads
+    lockfree_construct(&p_lockfree, 1, 0, 0);
+    for (size_t i = 0; i < 8; i++) hammers[i] = (hammer) { .p_lockfree = p_lockfree, .index = i };
+
+    // Eight threads add the same 50000 keys
+    set_parallel_run(hammer_task, hammers, sizeof(hammer), 8);
+    for (size_t i = 0; i < 50000; i++) contains &= lockfree_contains(p_lockfree, (void *) i);
+    print_test(name, "add", lockfree_count(p_lockfree) == 50000 && contains);
+
+    // Eight threads remove the same 50000 keys. Each key is removed exactly once
+    for (size_t i = 0; i < 8; i++) hammers[i].phase = 1;
+    set_parallel_run(hammer_task, hammers, sizeof(hammer), 8);
+    for (size_t i = 0; i < 8; i++) removed += hammers[i].removed;
+    for (size_t i = 0; i < 50000; i++) gone &= lockfree_contains(p_lockfree, (void *) i) == false;
+    print_test(name, "remove", removed == 50000 && lockfree_count(p_lockfree) == 0 && gone);
+
+    // Eight threads add, remove and look up keys at once. The even keys are left
+    for (size_t i = 0; i < 8; i++) hammers[i].phase = 2;
+    set_parallel_run(hammer_task, hammers, sizeof(hammer), 8);
+    for (size_t i = 0; i < 50000; i++) mixed &= lockfree_contains(p_lockfree, (void *) i) == ( i % 2 == 0 );
+    print_test(name, "mixed", lockfree_count(p_lockfree) == 25000 && mixed);
+
+    // Removed keys are not there to remove again
+    print_test(name, "tombstone", lockfree_remove(p_lockfree, (void *) 1) == 0 && lockfree_add(p_lockfree, (void *) 1) && lockfree_contains(p_lockfree, (void *) 1));
+
+    // Clean up
+    lockfree_destroy(&p_lockfree);
+
+    // Eight threads add and remove the same keys at once. Each key is left
+    // in or out, and the count agrees with the keys that are left
+    lockfree_construct(&p_lockfree, 1, 0, 0);
+    for (size_t i = 0; i < 8; i++) hammers[i] = (hammer) { .p_lockfree = p_lockfree, .index = i, .phase = 3 };
+    set_parallel_run(hammer_task, hammers, sizeof(hammer), 8);
+    for (size_t i = 0; i < 64; i++) left += lockfree_contains(p_lockfree, (void *) i);
+    print_test(name, "contended", lockfree_count(p_lockfree) == left);
+    lockfree_destroy(&p_lockfree);
+
+    // Null arguments
+    print_test(name, "null", lockfree_construct(0, 1, 0, 0) == 0 && lockfree_add(0, 0) == 0 && lockfree_count(0) == 0 && lockfree_contains(0, 0) == false);
+
+    // Done
+    return;
+}
+
+void test_epoch ( char *name )
+{
+
+    // Initialized data
+    epoch        *p_epoch  = 0;
+    epoch_record *p_record = 0;
+    bool          held     = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Retire an allocation inside the first epoch
+    epoch_construct(&p_epoch);
+    p_record = epoch_enter(p_epoch);
+    print_test(name, "retire", epoch_retire(p_epoch, SET_REALLOC(0, 16)) == 1 && epoch_pending(p_epoch) == 1);
+
+    // The epoch advances once, then waits for the thread to exit. The allocation is held
+    held &= epoch_reclaim(p_epoch) == 0 && epoch_reclaim(p_epoch) == 0 && epoch_pending(p_epoch) == 1;
+    epoch_exit(p_record);
+    print_test(name, "held", held);
+
+    // Once the thread enters again, the epoch advances, and frees the allocation
+    p_record = epoch_enter(p_epoch);
+    print_test(name, "reclaim", epoch_reclaim(p_epoch) == 1 && epoch_pending(p_epoch) == 0);
+    epoch_exit(p_record);
+
+    // Destroying the domain frees anything still retired
+    p_record = epoch_enter(p_epoch);
+    epoch_retire(p_epoch, SET_REALLOC(0, 16));
+    epoch_exit(p_record);
+    print_test(name, "destroy", epoch_destroy(&p_epoch) == 1 && p_epoch == 0);
+
+    // Null arguments
+    print_test(name, "null", epoch_construct(0) == 0 && epoch_enter(0) == 0 && epoch_retire(0, &held) == 0 && epoch_pending(0) == 0);
+
+    // Done
+    return;
+}
+
+void test_kernels ( char *name )
+{
+
+    // Initialized data
+    uint32_t a32[512], b32[512], result32[1024];
+    uint64_t a64[512], b64[512], result64[1024];
+    bool     intersection_ok = true,
+             count_ok        = true,
+             union_ok        = true,
+             difference_ok   = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Try many operands. Sizes straddle the vector width, and keys straddle 32 bits
+    for (size_t trial = 0; trial < 64; trial++)
+    {
+
+        // Initialized data
+        size_t   a_count = 0,
+                 b_count = 0,
+                 common  = 0,
+                 k       = 0;
+        uint32_t high    = ( trial & 1 ) ? 0x80000000u : 0;
+        int      shift   = (int) ( trial & 32 );
+
+        // Construct sorted operands of varying density
+        for (uint32_t key = 0; key < 1024 && a_count < 512; key++)
+            if ( ( key * 2654435761u + trial ) % ( 2 + trial % 5 ) == 0 ) a32[a_count++] = key | high;
+        for (uint32_t key = 0; key < 1024 && b_count < 512; key++)
+            if ( ( key * 40503u + trial * 7 ) % ( 2 + trial % 3 ) == 0 ) b32[b_count++] = key | high;
+        a_count = ( trial * 37 ) % ( a_count + 1 );
+        for (size_t i = 0; i < a_count; i++) a64[i] = (uint64_t) a32[i] << shift;
+        for (size_t i = 0; i < b_count; i++) b64[i] = (uint64_t) b32[i] << shift;
+
+        // Intersection
+        k = set_kernel_intersection_u32(a32, a_count, b32, b_count, result32);
+        for (size_t i = 0; i < a_count; i++)
+            if ( bsearch(&a32[i], b32, b_count, sizeof(uint32_t), compare_u32) )
+                intersection_ok &= ( common < k && result32[common++] == a32[i] );
+        intersection_ok &= ( k == common );
+        k = set_kernel_intersection_u64(a64, a_count, b64, b_count, result64);
+        intersection_ok &= ( k == common );
+        for (size_t i = 0; i < k; i++) intersection_ok &= ( result64[i] == (uint64_t) result32[i] << shift );
+
+        // Intersection count
+        count_ok &= ( set_kernel_intersection_count_u32(a32, a_count, b32, b_count) == common );
+        count_ok &= ( set_kernel_intersection_count_u64(a64, a_count, b64, b_count) == common );
+
+        // Difference
+        k = set_kernel_difference_u32(a32, a_count, b32, b_count, result32);
+        difference_ok &= ( k == a_count - common );
+        for (size_t i = 0; i < k; i++) difference_ok &= ( bsearch(&result32[i], b32, b_count, sizeof(uint32_t), compare_u32) == 0 ) && ( i == 0 || result32[i - 1] < result32[i] );
+        k = set_kernel_difference_u64(a64, a_count, b64, b_count, result64);
+        difference_ok &= ( k == a_count - common );
+        for (size_t i = 0; i < k; i++) difference_ok &= ( result64[i] == (uint64_t) result32[i] << shift );
+
+        // Union
+        k = set_kernel_union_u32(a32, a_count, b32, b_count, result32);
+        union_ok &= ( k == a_count + b_count - common );
+        for (size_t i = 1; i < k; i++) union_ok &= ( result32[i - 1] < result32[i] );
+        k = set_kernel_union_u64(a64, a_count, b64, b_count, result64);
+        union_ok &= ( k == a_count + b_count - common );
+        for (size_t i = 0; i < k; i++) union_ok &= ( result64[i] == (uint64_t) result32[i] << shift );
+    }
+
+    // Print the results
+    print_test(name, "∩", intersection_ok);
+    print_test(name, "∩ count", count_ok);
+    print_test(name, "∪", union_ok);
+    print_test(name, "-", difference_ok);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_frozen_set ( char *name )
+{
+
+    // Initialized data
+    set  *p_a      = 0,
+         *p_b      = 0,
+         *p_s      = 0,
+         *p_result = 0;
+    void *p_value  = 0;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Construct the multiples of 2 below 100000 in a hashed set, and the multiples of 3 below 150000 in a sorted set
+    set_construct_hashed(&p_a, 1, 0, 0);
+    set_construct_sorted(&p_b, 1, 0);
+    for (size_t i = 100000; i-- > 0;) if ( i % 2 == 0 ) set_add(p_a, (void *) i);
+    for (size_t i = 0; i < 150000; i += 3) set_add(p_b, (void *) i);
+
+    // Freeze
+    print_test(name, "freeze", set_freeze(p_a) == 1 && set_freeze(p_b) == 1 && set_count(p_a) == 50000 && set_count(p_b) == 50000);
+    print_test(name, "sorted", is_sorted(p_a) && is_sorted(p_b));
+    print_test(name, "freeze twice", set_freeze(p_a) == 0);
+
+    // Membership
+    set_construct_sorted(&p_s, 1, 0);
+    set_add(p_s, (void *) 99998), set_add(p_s, (void *) 99999);
+    print_test(name, "disjoint sorted", set_isdisjoint(p_a, p_s) == false && set_remove(p_s, (void *) 99998) && set_isdisjoint(p_a, p_s));
+    set_destroy(&p_s);
+
+    // Intersection of two frozen sets
+    set_intersection(&p_result, p_a, p_b, 0);
+    print_test(name, "∩", set_count(p_result) == 16667 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Union with a frozen set
+    set_union(&p_result, p_a, p_b, 0);
+    print_test(name, "∪", set_count(p_result) == 50000 + 50000 - 16667 && is_sorted(p_result));
+    set_destroy(&p_result);
+
+    // Disjoint
+    print_test(name, "disjoint", set_isdisjoint(p_a, p_b) == false);
+
+    // Frozen sets are immutable
+    print_test(name, "immutable", set_add(p_a, (void *) 1) == 0 && set_remove(p_a, (void *) 2) == 0 && set_pop(p_a, &p_value) == 0);
+
+    // Thaw
+    print_test(name, "thaw", set_thaw(p_a) == 1 && set_thaw(p_a) == 0 && set_count(p_a) == 50000);
+    print_test(name, "thawed add", set_add(p_a, (void *) 1) == 1 && set_add(p_a, (void *) 2) == 1 && set_count(p_a) == 50001);
+    print_test(name, "thawed remove", set_remove(p_a, (void *) 99998) == 1 && set_remove(p_a, (void *) 99998) == 0);
+    print_test(name, "thaw sorted", set_thaw(p_b) == 1 && is_sorted(p_b) && set_add(p_b, (void *) 4) == 1 && is_sorted(p_b));
+
+    // Sets with custom equality can not be frozen
+    set_construct(&p_s, 1, (set_equal_fn *) strcmp);
+    print_test(name, "freeze custom", set_freeze(p_s) == 0);
+    set_destroy(&p_s);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_inline_set ( char *name )
+{
+
+    // Initialized data
+    set  *p_a           = 0,
+         *p_b           = 0;
+    void *p_value       = 0,
+         *contents[32]  = { 0 };
+    bool  in_order      = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Fill a linear set and a sorted set up to their inline capacity
+    set_construct(&p_a, 0, 0);
+    set_construct_sorted(&p_b, 0, 0);
+    for (size_t i = 1; i <= 8; i++) set_add(p_a, (void *) i), set_add(p_b, (void *) ( 9 - i ));
+    print_test(name, "inline", set_count(p_a) == 8 && set_count(p_b) == 8 && is_sorted(p_b));
+
+    // Grow past the inline capacity
+    for (size_t i = 9; i <= 32; i++) set_add(p_a, (void *) i), set_add(p_b, (void *) ( 41 - i ));
+    set_contents(p_a, contents);
+    for (size_t i = 0; i < 32; i++) in_order &= contents[i] == (void *) ( i + 1 );
+    print_test(name, "spill", set_count(p_a) == 32 && in_order && set_count(p_b) == 32 && is_sorted(p_b));
+
+    // Shrink back down, and pop from the heap
+    for (size_t i = 32; i > 4; i--) set_remove(p_a, (void *) i);
+    print_test(name, "shrink", set_count(p_a) == 4 && set_pop(p_a, &p_value) == 1 && p_value == (void *) 4);
+
+    // Freeze and thaw a small set
+    print_test(name, "freeze", set_freeze(p_a) == 1 && set_thaw(p_a) == 1 && set_count(p_a) == 3 && set_add(p_a, (void *) 100) == 1 && set_count(p_a) == 4);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_typed_set ( char *name )
+{
+
+    // Initialized data
+    u64set    *p_u64       = 0;
+    pointset  *p_points    = 0;
+    uint64_t  *p_contents  = 0;
+    uint64_t   sum         = 0;
+    bool       all_found   = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Add the multiples of 7 below 70000, twice
+    u64set_construct(&p_u64, 1);
+    for (uint64_t i = 0; i < 70000; i += 7) u64set_add(p_u64, i), u64set_add(p_u64, i);
+    print_test(name, "add", u64set_count(p_u64) == 10000);
+
+    // Membership
+    for (uint64_t i = 0; i < 70000; i++) all_found &= u64set_contains(p_u64, i) == ( i % 7 == 0 );
+    print_test(name, "contains", all_found);
+
+    // Remove the even multiples, then add them back over the tombstones
+    for (uint64_t i = 0; i < 70000; i += 14) u64set_remove(p_u64, i);
+    print_test(name, "remove", u64set_count(p_u64) == 5000 && u64set_contains(p_u64, 14) == false && u64set_remove(p_u64, 14) == 0);
+    for (uint64_t i = 0; i < 70000; i += 14) u64set_add(p_u64, i);
+
+    // Contents
+    p_contents = malloc(10000 * sizeof(uint64_t));
+    for (size_t i = 0, n = u64set_contents(p_u64, p_contents); i < n; i++) sum += p_contents[i];
+    print_test(name, "contents", u64set_count(p_u64) == 10000 && sum == 7ULL * 9999 * 10000 / 2);
+    free(p_contents);
+
+    // Keys may be structures
+    pointset_construct(&p_points, 0);
+    for (int x = -10; x < 10; x++) for (int y = -10; y < 10; y++) pointset_add(p_points, (point) { x, y });
+    print_test(name, "structures", pointset_count(p_points) == 400 && pointset_contains(p_points, (point) { -10, 9 }) && pointset_contains(p_points, (point) { 10, 0 }) == false);
+
+    // Free the sets
+    u64set_destroy(&p_u64);
+    pointset_destroy(&p_points);
+    print_test(name, "destroy", p_u64 == 0 && p_points == 0 && u64set_destroy(&p_u64) == 1);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_strset ( char *name )
+{
+
+    // Initialized data
+    strset      *p_strset      = 0;
+    char         url[64]       = { 0 };
+    const char **pp_contents   = 0;
+    size_t       count         = 0;
+    bool         all_found     = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Add 20000 URLs, each one twice, from a reused buffer
+    strset_construct(&p_strset, 1);
+    for (int i = 0; i < 40000; i++) snprintf(url, sizeof(url), "https://example.com/page/%d", i % 20000), strset_add(p_strset, url);
+    print_test(name, "add", strset_count(p_strset) == 20000);
+
+    // Membership
+    for (int i = 0; i < 20000; i++) snprintf(url, sizeof(url), "https://example.com/page/%d", i), all_found &= strset_contains(p_strset, url);
+    print_test(name, "contains", all_found && strset_contains(p_strset, "https://example.com/page/") == false && strset_contains(p_strset, "") == false);
+
+    // Keys are copied
+    strcpy(url, "https://example.com/page/7");
+    print_test(name, "copy", strset_contains(p_strset, url) && ( url[0] = 'x', strset_contains(p_strset, url) == false ));
+
+    // Remove
+    print_test(name, "remove", strset_remove(p_strset, "https://example.com/page/7") == 1 && strset_remove(p_strset, "https://example.com/page/7") == 0 && strset_count(p_strset) == 19999);
+    print_test(name, "add after remove", strset_add(p_strset, "https://example.com/page/7") == 1 && strset_count(p_strset) == 20000);
+
+    // The empty string
+    print_test(name, "empty string", strset_add(p_strset, "") == 1 && strset_contains(p_strset, "") && strset_count(p_strset) == 20001);
+
+    // Contents
+    pp_contents = malloc(20001 * sizeof(char *));
+    count = strset_contents(p_strset, pp_contents);
+    for (size_t i = 0; i < count; i++) all_found &= strset_contains(p_strset, pp_contents[i]);
+    print_test(name, "contents", count == 20001 && all_found);
+    free(pp_contents);
+
+    // Free the string set
+    print_test(name, "destroy", strset_destroy(&p_strset) == 1 && p_strset == 0);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_contains ( char *name )
+{
+
+    // Initialized data
+    set  *p_a        = 0,
+         *p_s        = 0;
+    char  keys[4][8] = { "alpha", "beta", "gamma", "delta" },
+          probe[8]   = "beta";
+    bool  hits       = true,
+          misses     = true;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Without a Bloom filter
+    set_construct(&p_a, 0, 0);
+    for (size_t i = 0; i < 1000; i++) set_add(p_a, (void *) i);
+    print_test(name, "contains", set_contains(p_a, (void *) 999) && set_contains(p_a, (void *) 1000) == false);
+
+    // Enable the Bloom filter part way through, and keep adding
+    print_test(name, "enable bloom", set_enable_bloom(p_a) == 1);
+    for (size_t i = 1000; i < 4000; i++) set_add(p_a, (void *) i);
+
+    // No false negatives, and the misses still miss
+    for (size_t i = 0; i < 4000; i++) hits &= set_contains(p_a, (void *) i);
+    for (size_t i = 4000; i < 8000; i++) misses &= set_contains(p_a, (void *) i) == false;
+    print_test(name, "bloom hits", hits && set_count(p_a) == 4000);
+    print_test(name, "bloom misses", misses);
+
+    // Removed elements are not found, and can be added again
+    for (size_t i = 0; i < 4000; i += 2) set_remove(p_a, (void *) i);
+    for (size_t i = 0; i < 4000; i++) misses &= set_contains(p_a, (void *) i) == ( i % 2 == 1 );
+    for (size_t i = 0; i < 4000; i += 4) set_add(p_a, (void *) i);
+    for (size_t i = 0; i < 4000; i++) hits &= set_contains(p_a, (void *) i) == ( i % 2 == 1 || i % 4 == 0 );
+    print_test(name, "bloom remove", misses && hits && set_count(p_a) == 3000);
+
+    // The Bloom filter survives freezing
+    print_test(name, "bloom frozen", set_freeze(p_a) == 1 && set_contains(p_a, (void *) 4) && set_contains(p_a, (void *) 2) == false && set_thaw(p_a) == 1);
+    set_destroy(&p_a);
+
+    // Sets with a custom equality function must be hashed
+    set_construct(&p_s, 4, (set_equal_fn *) strcmp);
+    print_test(name, "bloom unhashed", set_enable_bloom(p_s) == 0);
+    set_destroy(&p_s);
+    set_construct_hashed(&p_s, 4, (set_equal_fn *) strcmp, hash_string);
+    for (size_t i = 0; i < 4; i++) set_add(p_s, keys[i]);
+    print_test(name, "bloom hashed", set_enable_bloom(p_s) == 1 && set_contains(p_s, probe) && set_contains(p_s, "epsilon") == false);
+    set_destroy(&p_s);
+
+    // Compact sets test membership directly
+    set_construct_roaring(&p_s);
+    set_add(p_s, (void *) 7);
+    print_test(name, "bloom roaring", set_enable_bloom(p_s) == 0 && set_contains(p_s, (void *) 7) && set_contains(p_s, (void *) 8) == false);
+    set_destroy(&p_s);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_sketch ( char *name )
+{
+
+    // Initialized data
+    set    *p_a   = 0,
+           *p_b   = 0,
+           *p_c   = 0;
+    hll    *p_all = 0;
+    double  e     = 0;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // Sketch A as it grows, and sketch B after it is full
+    set_construct_hashed(&p_a, 1, 0, 0);
+    set_construct_hashed(&p_b, 1, 0, 0);
+    print_test(name, "enable", set_enable_sketch(p_a, 14) == 1 && set_enable_sketch(p_a, 3) == 0);
+    for (size_t i = 0; i < 100000; i++) set_add(p_a, (void *) i);
+    for (size_t i = 50000; i < 150000; i++) set_add(p_b, (void *) i);
+    print_test(name, "no sketch", set_union_estimate(p_a, p_b) == -1);
+    set_enable_sketch(p_b, 14);
+
+    // Estimates
+    print_test(name, "count", fabs(hll_estimate(set_sketch(p_a)) - 100000) < 3000);
+    print_test(name, "∪ estimate", fabs(set_union_estimate(p_a, p_b) - 150000) < 4500);
+    print_test(name, "∩ estimate", fabs(set_intersection_estimate(p_a, p_b) - 50000) < 5000);
+
+    // A roaring set of the same integers hashes alike
+    set_construct_roaring(&p_c);
+    for (size_t i = 100000; i < 200000; i++) set_add(p_c, (void *) i);
+    set_enable_sketch(p_c, 14);
+    print_test(name, "∪ roaring", fabs(set_union_estimate(p_b, p_c) - 150000) < 4500);
+
+    // Merge the sketches of several sets
+    hll_construct(&p_all, 14);
+    hll_merge(p_all, set_sketch(p_a)), hll_merge(p_all, set_sketch(p_b)), hll_merge(p_all, set_sketch(p_c));
+    e = hll_estimate(p_all);
+    print_test(name, "merge", fabs(e - 200000) < 6000);
+    hll_destroy(&p_all);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+    set_destroy(&p_c);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_minhash ( char *name )
+{
+
+    // Initialized data
+    set     *p_a   = 0,
+            *p_b   = 0,
+            *p_c   = 0;
+    minhash *p_ab  = 0;
+
+    // Log
+    log_scenario("%s\n", name);
+
+    // A and B share 5000 of 15000 elements, so J(A, B) = 1/3
+    set_construct_hashed(&p_a, 1, 0, 0);
+    set_construct_sorted(&p_b, 1, 0);
+    print_test(name, "enable", set_enable_minhash(p_a, 256) == 1 && set_enable_minhash(p_a, 0) == 0);
+    for (size_t i = 0; i < 10000; i++) set_add(p_a, (void *) i);
+    for (size_t i = 5000; i < 15000; i++) set_add(p_b, (void *) i);
+    print_test(name, "no signature", set_jaccard_estimate(p_a, p_b) == -1);
+    set_enable_minhash(p_b, 256);
+
+    // Estimates
+    print_test(name, "J(A, A)", set_jaccard_estimate(p_a, p_a) == 1);
+    print_test(name, "J(A, B)", fabs(set_jaccard_estimate(p_a, p_b) - 1.0 / 3) < 0.1);
+
+    // A disjoint bitset set
+    set_construct_bitset(&p_c, 30000);
+    for (size_t i = 20000; i < 30000; i++) set_add(p_c, (void *) i);
+    set_enable_minhash(p_c, 256);
+    print_test(name, "J(A, C)", set_jaccard_estimate(p_a, p_c) < 0.05);
+
+    // The merged signature of A and B signs their union, which contains A
+    minhash_construct(&p_ab, 256);
+    minhash_merge(p_ab, set_minhash(p_a)), minhash_merge(p_ab, set_minhash(p_b));
+    print_test(name, "merge", fabs(minhash_jaccard(p_ab, set_minhash(p_a)) - 2.0 / 3) < 0.1);
+    minhash_destroy(&p_ab);
+
+    // Free the sets
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+    set_destroy(&p_c);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_counts ( char *name )
+{
+
+    // Initialized data
+    set  *p_a[7]  = { 0 },
+         *p_b[7]  = { 0 },
+         *p_s     = 0;
+    bool  counts  = true,
+          similar = true;
+
+    // Set A holds the multiples of 2, and set B the multiples of 3, below
+    // 3000. | A ∩ B | = 500, | A ∪ B | = 2000, and | A - B | = 1000
+    for (size_t k = 0; k < 2; k++)
+    {
+
+        // Initialized data
+        set **pp = ( k == 0 ) ? p_a : p_b;
+
+        // Construct one set of each kind
+        set_construct(&pp[0], 1, 0);
+        set_construct_hashed(&pp[1], 1, 0, 0);
+        set_construct_sorted(&pp[2], 1, 0);
+        set_construct_sorted(&pp[3], 1, compare_descending);
+        set_construct_roaring(&pp[4]);
+        set_construct_bitset(&pp[5], 3000);
+        set_construct_sorted(&pp[6], 1, 0);
+
+        // Add the multiples
+        for (size_t i = 0; i < 3000; i += 2 + k)
+            for (size_t j = 0; j < 7; j++)
+                set_add(pp[j], (void *) i);
+
+        // Compress the last set
+        set_freeze(pp[6]);
+    }
+
+    // Count every pair of kinds
+    for (size_t i = 0; i < 7; i++)
+        for (size_t j = 0; j < 7; j++)
+            counts &= set_intersection_count(p_a[i], p_b[j]) == 500  &&
+                      set_union_count       (p_a[i], p_b[j]) == 2000 &&
+                      set_difference_count  (p_a[i], p_b[j]) == 1000 &&
+                      set_difference_count  (p_b[j], p_a[i]) == 500;
+    print_test(name, "every kind", counts);
+
+    // Similarity
+    for (size_t i = 0; i < 7; i++)
+        similar &= set_jaccard(p_a[i], p_b[i]) == 0.25 &&
+                   set_overlap_coefficient(p_a[i], p_b[i]) == 0.5 &&
+                   set_jaccard(p_a[i], p_a[i]) == 1;
+    print_test(name, "similarity", similar);
+
+    // A small sorted set is counted by galloping through a large one
+    set_construct_sorted(&p_s, 1, 0);
+    set_add(p_s, (void *) 4), set_add(p_s, (void *) 9), set_add(p_s, (void *) 12), set_add(p_s, (void *) 5000);
+    print_test(name, "gallop", set_intersection_count(p_s, p_a[2]) == 2 && set_intersection_count(p_b[2], p_s) == 2 && set_union_count(p_s, p_a[2]) == 1502);
+
+    // Empty sets
+    set_destroy(&p_s);
+    set_construct_hashed(&p_s, 1, 0, 0);
+    print_test(name, "empty", set_intersection_count(p_s, p_a[1]) == 0 && set_jaccard(p_s, p_s) == 0 && set_overlap_coefficient(p_s, p_a[1]) == 0);
+    print_test(name, "null", set_intersection_count(0, p_a[1]) == 0 && set_jaccard(p_s, 0) == -1);
+
+    // Free the sets
+    set_destroy(&p_s);
+    for (size_t i = 0; i < 7; i++) set_destroy(&p_a[i]), set_destroy(&p_b[i]);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_subset ( char *name )
+{
+
+    // Initialized data
+    set  *p_s[4][7] = { 0 },
+         *p_e       = 0;
+    bool  subset    = true,
+          superset  = true,
+          disjoint  = true;
+
+    // Set 0 holds the multiples of 6, set 1 the multiples of 3, set 2 the
+    // multiples of 2, and set 3 the odd multiples of 5, below 3000
+    for (size_t k = 0; k < 4; k++)
+    {
+
+        // Initialized data
+        size_t start = ( k == 3 ) ? 5 : 0,
+               step  = ( k == 0 ) ? 6 : ( k == 1 ) ? 3 : ( k == 2 ) ? 2 : 10;
+
+        // Construct one set of each kind
+        set_construct(&p_s[k][0], 1, 0);
+        set_construct_hashed(&p_s[k][1], 1, 0, 0);
+        set_construct_sorted(&p_s[k][2], 1, 0);
+        set_construct_sorted(&p_s[k][3], 1, compare_descending);
+        set_construct_roaring(&p_s[k][4]);
+        set_construct_bitset(&p_s[k][5], 3000 * ( k + 1 ));
+        set_construct_sorted(&p_s[k][6], 1, 0);
+
+        // Add the multiples
+        for (size_t i = start; i < 3000; i += step)
+            for (size_t j = 0; j < 7; j++)
+                set_add(p_s[k][j], (void *) i);
+
+        // Compress the last set
+        set_freeze(p_s[k][6]);
+    }
+
+    // Test every pair of kinds
+    for (size_t i = 0; i < 7; i++)
+        for (size_t j = 0; j < 7; j++)
+            subset   &= set_issubset(p_s[0][i], p_s[1][j])   && set_issubset(p_s[0][i], p_s[0][j])   &&
+                        !set_issubset(p_s[1][i], p_s[0][j])  && !set_issubset(p_s[2][i], p_s[1][j])  && !set_issubset(p_s[1][i], p_s[2][j]),
+            superset &= set_issuperset(p_s[1][i], p_s[0][j]) && !set_issuperset(p_s[0][i], p_s[1][j]),
+            disjoint &= set_isdisjoint(p_s[2][i], p_s[3][j]) && !set_isdisjoint(p_s[1][i], p_s[3][j]);
+    print_test(name, "subset", subset);
+    print_test(name, "superset", superset);
+    print_test(name, "disjoint", disjoint);
+
+    // The empty set
+    set_construct_sorted(&p_e, 1, 0);
+    print_test(name, "empty", set_issubset(p_e, p_s[0][2]) && set_issubset(p_e, p_e) && !set_issubset(p_s[0][2], p_e) && set_isdisjoint(p_e, p_s[0][2]));
+
+    // A small sorted set gallops through a large one
+    set_add(p_e, (void *) 6), set_add(p_e, (void *) 2994);
+    print_test(name, "gallop", set_issubset(p_e, p_s[1][2]) && set_add(p_e, (void *) 2995) && !set_issubset(p_e, p_s[1][2]));
+
+    // Null sets
+    print_test(name, "null", set_issubset(0, p_e) == false && set_issuperset(p_e, 0) == false);
+
+    // Free the sets
+    set_destroy(&p_e);
+    for (size_t k = 0; k < 4; k++)
+        for (size_t i = 0; i < 7; i++)
+            set_destroy(&p_s[k][i]);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
+
+void test_update ( char *name )
+{
+
+    // Initialized data
+    set  *p_a           = 0,
+         *p_b           = 0,
+         *p_union       = 0,
+         *p_difference  = 0,
+         *p_common      = 0;
+    bool  update        = true,
+          difference    = true,
+          intersection  = true;
+
+    // Set A holds the multiples of 2, and set B the multiples of 3, below 3000
+    construct_kind(&p_a, 2, 0, 2);
+    construct_kind(&p_b, 2, 0, 3);
+    set_union(&p_union, p_a, p_b, 0);
+    set_difference(&p_difference, p_a, p_b, 0);
+    set_intersection(&p_common, p_a, p_b, 0);
+    set_destroy(&p_a);
+    set_destroy(&p_b);
+
+    // Update every kind of set, except frozen sets, with every kind of set
+    for (size_t i = 0; i < 6; i++)
+        for (size_t j = 0; j < 7; j++)
+        {
+
+            // Union
+            construct_kind(&p_a, i, 0, 2), construct_kind(&p_b, j, 0, 3);
+            update &= set_update(p_a, p_b) == 1 && set_count(p_a) == 2000 && set_issubset(p_union, p_a);
+            set_destroy(&p_a);
+
+            // Difference
+            construct_kind(&p_a, i, 0, 2);
+            difference &= set_difference_update(p_a, p_b) == 1 && set_count(p_a) == 1000 && set_issubset(p_difference, p_a);
+            set_destroy(&p_a);
+
+            // Intersection
+            construct_kind(&p_a, i, 0, 2);
+            intersection &= set_intersection_update(p_a, p_b) == 1 && set_count(p_a) == 500 && set_issubset(p_common, p_a);
+            set_destroy(&p_a), set_destroy(&p_b);
+        }
+    print_test(name, "update", update);
+    print_test(name, "difference update", difference);
+    print_test(name, "intersection update", intersection);
+
+    // Sorted sets stay in order
+    {
+
+        // Initialized data
+        void *contents[2000] = { 0 };
+        bool  ordered        = true;
+
+        // Merge two descending sets
+        construct_kind(&p_a, 3, 0, 2), construct_kind(&p_b, 1, 0, 3);
+        set_update(p_a, p_b);
+        set_contents(p_a, contents);
+        for (size_t i = 1; i < 2000; i++) ordered &= contents[i - 1] > contents[i];
+        print_test(name, "sorted", set_count(p_a) == 2000 && ordered && set_issubset(p_union, p_a));
+        set_destroy(&p_a), set_destroy(&p_b);
+    }
+
+    // Updating a set with itself
+    construct_kind(&p_a, 1, 0, 2);
+    print_test(name, "self", set_update(p_a, p_a) && set_intersection_update(p_a, p_a) && set_count(p_a) == 1500 && set_difference_update(p_a, p_a) && set_count(p_a) == 0 && set_add(p_a, (void *) 7) && set_contains(p_a, (void *) 7));
+    set_destroy(&p_a);
+
+    // Filters stay in sync
+    construct_kind(&p_a, 1, 0, 2), construct_kind(&p_b, 4, 0, 3);
+    set_enable_bloom(p_a), set_enable_sketch(p_a, 12);
+    set_update(p_a, p_b);
+    print_test(name, "bloom", set_contains(p_a, (void *) 2997) && set_contains(p_a, (void *) 2999) == false && fabs(hll_estimate(set_sketch(p_a)) - 2000) < 150);
+    set_difference_update(p_a, p_b);
+    print_test(name, "bloom difference", set_contains(p_a, (void *) 2997) == false && set_contains(p_a, (void *) 2998) && set_count(p_a) == 1000);
+    set_destroy(&p_a), set_destroy(&p_b);
+
+    // Inline sets spill to the heap only when they outgrow the inline array
+    set_construct(&p_a, 4, 0);
+    set_add(p_a, (void *) 1);
+    construct_kind(&p_b, 1, 0, 100);
+    print_test(name, "inline", set_update(p_a, p_b) && set_count(p_a) == 31 && set_intersection_update(p_a, p_b) && set_count(p_a) == 30);
+    set_destroy(&p_a);
+
+    // Frozen sets are immutable, and bitset sets have a universe
+    construct_kind(&p_a, 6, 0, 2);
+    print_test(name, "frozen", set_update(p_a, p_b) == 0 && set_difference_update(p_a, p_b) == 0);
+    set_destroy(&p_a), set_destroy(&p_b);
+    set_construct_bitset(&p_a, 100), construct_kind(&p_b, 5, 0, 7);
+    print_test(name, "universe", set_update(p_a, p_b) == 0 && set_update(p_b, p_a) == 1);
+    print_test(name, "null", set_update(0, p_b) == 0 && set_intersection_update(p_b, 0) == 0);
+    set_destroy(&p_a), set_destroy(&p_b);
+
+    // Free the sets
+    set_destroy(&p_union);
+    set_destroy(&p_difference);
+    set_destroy(&p_common);
+
+    // Print the final summary
+    print_final_summary();
+
+    // Done
+    return;
+}
@@ -0,0 +1,242 @@
+/** !
+ * Lock striped set
+ *
+ * @file sharded.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/sharded.h>
+#include <set/parallel.h>
+
+// Structure definitions
+// The shards follow the structure, in the same allocation. Each shard is
+// its own allocation, so the locks of neighboring shards do not share a
+// cache line
+struct sharded_s
+{
+    set_hash_fn *pfn_hash;
+    size_t       mask;
+    set         *p_shards[];
+};
+
+/** !
+ * Find the shard of an element. Shards are picked by the high half of the
+ * mixed hash, because each shard indexes its elements by the low half
+ *
+ * @param p_sharded the sharded set
+ * @param p_element the element
+ *
+ * @return the shard
+ */
+static set *sharded_shard ( const sharded *const p_sharded, const void *const p_element )
+{
+
+    // Initialized data
+    unsigned long long hash = set_hash_mix(( p_sharded->pfn_hash ) ? p_sharded->pfn_hash(p_element) : (unsigned long long) (uintptr_t) p_element);
+
+    // Done
+    return p_sharded->p_shards[(size_t) ( hash >> 32 ) & p_sharded->mask];
+}
+
+int sharded_construct ( sharded **const pp_sharded, size_t shards, size_t size, set_equal_fn *pfn_is_equal, set_hash_fn *pfn_hash )
+{
+
+    // Argument check
+    if ( pp_sharded == (void *) 0 ) goto no_sharded;
+
+    // Initialized data
+    size_t   quantity  = 1;
+    sharded *p_sharded = (void *) 0;
+
+    // Default to four shards per hardware thread, so concurrent writers rarely meet
+    if ( shards == 0 ) shards = 4 * set_parallel_hardware_threads();
+
+    // Round up to a power of two
+    while ( quantity < shards ) quantity <<= 1;
+
+    // Allocate memory for the sharded set
+    p_sharded = SET_CALLOC(1, sizeof(sharded) + quantity * sizeof(set *));
+
+    // Error check
+    if ( p_sharded == (void *) 0 ) goto no_mem;
+
+    // Store the hash function, and the shard mask
+    p_sharded->pfn_hash = pfn_hash,
+    p_sharded->mask     = quantity - 1;
+
+    // Construct each shard, with room for its part of the elements
+    for (size_t i = 0; i < quantity; i++)
+        if ( set_construct_hashed(&p_sharded->p_shards[i], size / quantity + 1, pfn_is_equal, pfn_hash) == 0 ) goto failed_to_construct_shard;
+
+    // Return a pointer to the caller
+    *pp_sharded = p_sharded;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_sharded:
+                #ifndef NDEBUG
+                    printf("[set] [sharded] Null pointer provided for parameter \"pp_sharded\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // set errors
+        {
+            failed_to_construct_shard:
+                #ifndef NDEBUG
+                    printf("[set] [sharded] Failed to construct shard in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                (void)sharded_destroy(&p_sharded);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool sharded_contains ( const sharded *const p_sharded, const void *const p_element )
+{
+
+    // Argument check
+    if ( p_sharded == (void *) 0 ) return false;
+
+    // Search the shard of the element
+    return set_contains(sharded_shard(p_sharded, p_element), p_element);
+}
+
+size_t sharded_count ( const sharded *const p_sharded )
+{
+
+    // Argument check
+    if ( p_sharded == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t count = 0;
+
+    // Sum the count of each shard
+    for (size_t i = 0; i <= p_sharded->mask; i++) count += set_count(p_sharded->p_shards[i]);
+
+    // Done
+    return count;
+}
+
+size_t sharded_shards ( const sharded *const p_sharded )
+{
+
+    // Done
+    return ( p_sharded ) ? p_sharded->mask + 1 : 0;
+}
+
+int sharded_add ( sharded *const p_sharded, void *const p_element )
+{
+
+    // Argument check
+    if ( p_sharded == (void *) 0 ) goto no_sharded;
+
+    // Add the element to its shard
+    return set_add(sharded_shard(p_sharded, p_element), p_element);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_sharded:
+                #ifndef NDEBUG
+                    printf("[set] [sharded] Null pointer provided for parameter \"p_sharded\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_remove ( sharded *const p_sharded, void *const p_element )
+{
+
+    // Argument check
+    if ( p_sharded == (void *) 0 ) goto no_sharded;
+
+    // Remove the element from its shard
+    return set_remove(sharded_shard(p_sharded, p_element), p_element);
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_sharded:
+                #ifndef NDEBUG
+                    printf("[set] [sharded] Null pointer provided for parameter \"p_sharded\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int sharded_destroy ( sharded **const pp_sharded )
+{
+
+    // Argument check
+    if ( pp_sharded == (void *) 0 ) goto no_sharded;
+
+    // Initialized data
+    sharded *p_sharded = *pp_sharded;
+
+    // Nothing to do
+    if ( p_sharded == (void *) 0 ) return 1;
+
+    // No more sharded set for caller
+    *pp_sharded = (void *) 0;
+
+    // Destroy each shard. Shards that were never constructed are null
+    for (size_t i = 0; i <= p_sharded->mask; i++)
+        if ( p_sharded->p_shards[i] ) set_destroy(&p_sharded->p_shards[i]);
+
+    // Free the sharded set
+    SET_FREE(p_sharded);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_sharded:
+                #ifndef NDEBUG
+                    printf("[set] [sharded] Null pointer provided for parameter \"pp_sharded\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,688 @@
+/** !
+ * Hashed set of null terminated strings
+ *
+ * @file strset.c
+ *
+ * @author Jacob Smith
+ */
+
+// Headers
+#include <set/strset.h>
+#include <set/parallel.h>
+
+// Preprocessor definitions
+// The quantity of bytes in each arena chunk
+#ifndef STRSET_CHUNK_SIZE
+#define STRSET_CHUNK_SIZE 65536
+#endif
+
+// Forward declarations
+struct strset_slot_s;
+struct strset_chunk_s;
+
+// Type definitions
+typedef struct strset_slot_s  strset_slot;
+typedef struct strset_chunk_s strset_chunk;
+
+// Data
+// Removed slots point here
+static const char strset_tombstone[1] = { 0 };
+
+// Structure definitions
+// A slot is empty IF p_key is null ELSE a tombstone IF p_key is strset_tombstone
+struct strset_slot_s
+{
+    uint64_t    hash;
+    size_t      length;
+    const char *p_key;
+};
+
+// Arena chunks are linked, newest first
+struct strset_chunk_s
+{
+    strset_chunk *p_next;
+    size_t        used,
+                  max;
+    char          data[];
+};
+
+struct strset_s
+{
+    strset_slot  *p_slots;
+    size_t        count,
+                  used,
+                  max;
+    strset_chunk *p_chunks;
+    set_rwlock    _lock;
+};
+
+/** !
+ * Hash a string, eight bytes at a time
+ *
+ * @param p_key  the string
+ * @param length the length of the string
+ *
+ * @return the hash
+ */
+static uint64_t strset_hash ( const char *const p_key, size_t length )
+{
+
+    // Initialized data
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ length,
+             word = 0;
+    size_t   i    = 0;
+
+    // Mix each word
+    for (; i + 8 <= length; i += 8)
+    {
+        memcpy(&word, &p_key[i], 8);
+        hash = ( hash ^ word ) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    // Mix the tail
+    if ( i < length )
+    {
+        word = 0;
+        memcpy(&word, &p_key[i], length - i);
+        hash = ( hash ^ word ) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    // Finalize
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    // Done
+    return hash;
+}
+
+/** !
+ * Search a string set for a string
+ *
+ * @param p_strset the string set
+ * @param p_key    the string
+ * @param length   the length of the string
+ * @param hash     the hash of the string
+ * @param p_found  return true IF the string is in the string set ELSE false
+ *
+ * @return the slot of the string IF found ELSE the slot to insert the string at
+ */
+static size_t strset_find ( const strset *const p_strset, const char *const p_key, size_t length, uint64_t hash, bool *const p_found )
+{
+
+    // Initialized data
+    size_t mask      = p_strset->max - 1,
+           i         = (size_t) hash & mask,
+           tombstone = SIZE_MAX;
+
+    // Probe until an empty slot
+    for (;; i = ( i + 1 ) & mask)
+    {
+
+        // Initialized data
+        const strset_slot *p_slot = &p_strset->p_slots[i];
+
+        // Empty slot. Prefer to reuse the first tombstone
+        if ( p_slot->p_key == (void *) 0 )
+        {
+            *p_found = false;
+            return ( tombstone == SIZE_MAX ) ? i : tombstone;
+        }
+
+        // Remember the first tombstone
+        if ( p_slot->p_key == strset_tombstone )
+        {
+            if ( tombstone == SIZE_MAX ) tombstone = i;
+            continue;
+        }
+
+        // Compare the hash and the length before the bytes
+        if ( p_slot->hash == hash && p_slot->length == length && memcmp(p_slot->p_key, p_key, length) == 0 )
+        {
+            *p_found = true;
+            return i;
+        }
+    }
+}
+
+/** !
+ * Move each string of a string set into a new index. The hashes are
+ * cached, so the strings themselves are not touched
+ *
+ * @param p_strset the string set
+ * @param max      the quantity of slots in the new index. Must be a power of two
+ *
+ * @return 1 on success, 0 on error
+ */
+static int strset_resize ( strset *const p_strset, size_t max )
+{
+
+    // Initialized data
+    strset_slot *p_old = p_strset->p_slots,
+                *p_new = SET_CALLOC(max, sizeof(strset_slot));
+    size_t       old   = p_strset->max,
+                 mask  = max - 1;
+
+    // Error check
+    if ( p_new == (void *) 0 ) goto no_mem;
+
+    // Reinsert each string, dropping tombstones
+    for (size_t i = 0; i < old; i++)
+    {
+
+        // Initialized data
+        size_t j = 0;
+
+        // Skip empty slots and tombstones
+        if ( p_old[i].p_key == (void *) 0 || p_old[i].p_key == strset_tombstone ) continue;
+
+        // Find an empty slot
+        for (j = (size_t) p_old[i].hash & mask; p_new[j].p_key; j = ( j + 1 ) & mask);
+
+        // Store the string
+        p_new[j] = p_old[i];
+    }
+
+    // Store the index
+    p_strset->p_slots = p_new,
+    p_strset->max     = max,
+    p_strset->used    = p_strset->count;
+
+    // Free the old index
+    SET_FREE(p_old);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+/** !
+ * Copy a string into the arena of a string set
+ *
+ * @param p_strset the string set
+ * @param p_key    the string
+ * @param length   the length of the string
+ *
+ * @return the copy IF successful ELSE null
+ */
+static const char *strset_arena_copy ( strset *const p_strset, const char *const p_key, size_t length )
+{
+
+    // Initialized data
+    strset_chunk *p_chunk = p_strset->p_chunks;
+    char         *p_copy  = (void *) 0;
+
+    // If the newest chunk is full, start another
+    if ( p_chunk == (void *) 0 || p_chunk->max - p_chunk->used < length + 1 )
+    {
+
+        // Initialized data
+        size_t max = ( length + 1 > STRSET_CHUNK_SIZE ) ? length + 1 : STRSET_CHUNK_SIZE;
+
+        // Allocate a chunk
+        p_chunk = SET_REALLOC(0, sizeof(strset_chunk) + max);
+
+        // Error check
+        if ( p_chunk == (void *) 0 ) goto no_mem;
+
+        // Link the chunk
+        p_chunk->p_next    = p_strset->p_chunks,
+        p_chunk->used      = 0,
+        p_chunk->max       = max,
+        p_strset->p_chunks = p_chunk;
+    }
+
+    // Copy the string, and its null terminator
+    p_copy = &p_chunk->data[p_chunk->used];
+    memcpy(p_copy, p_key, length + 1);
+    p_chunk->used += length + 1;
+
+    // Success
+    return p_copy;
+
+    // Error handling
+    {
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return (void *) 0;
+        }
+    }
+}
+
+int strset_construct ( strset **const pp_strset, size_t size )
+{
+
+    // Argument check
+    if ( pp_strset == (void *) 0 ) goto no_strset;
+
+    // Initialized data
+    strset *p_strset = SET_REALLOC(0, sizeof(strset));
+    size_t  max      = 8;
+
+    // Error check
+    if ( p_strset == (void *) 0 ) goto no_mem;
+
+    // Zero set
+    memset(p_strset, 0, sizeof(strset));
+
+    // Keep the load factor at most one half
+    while ( max < size * 2 ) max <<= 1;
+
+    // Allocate the index
+    if ( strset_resize(p_strset, max) == 0 ) goto failed_to_allocate_index;
+
+    // Create a lock
+    set_rwlock_create(&p_strset->_lock);
+
+    // Return a pointer to the caller
+    *pp_strset = p_strset;
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_strset:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"pp_strset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_allocate_index:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Failed to allocate index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Clean up
+                SET_FREE(p_strset);
+
+                // Error
+                return 0;
+        }
+
+        // Standard library errors
+        {
+            no_mem:
+                #ifndef NDEBUG
+                    printf("[Standard Library] Failed to allocate memory in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+bool strset_contains ( strset *const p_strset, const char *const p_key )
+{
+
+    // Argument check
+    if ( p_strset == (void *) 0 ) return false;
+    if ( p_key    == (void *) 0 ) return false;
+
+    // Initialized data
+    size_t   length = strlen(p_key);
+    uint64_t hash   = strset_hash(p_key, length);
+    bool     found  = false;
+
+    // Lock
+    set_rwlock_read_lock(&p_strset->_lock);
+
+    // Search for the string
+    (void)strset_find(p_strset, p_key, length, hash, &found);
+
+    // Unlock
+    set_rwlock_read_unlock(&p_strset->_lock);
+
+    // Done
+    return found;
+}
+
+size_t strset_count ( const strset *const p_strset )
+{
+
+    // Argument check
+    if ( p_strset == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t count = 0;
+
+    // Read the count under the lock, so it is never read in the middle of a write
+    set_rwlock_read_lock((set_rwlock *) &p_strset->_lock);
+    count = p_strset->count;
+    set_rwlock_read_unlock((set_rwlock *) &p_strset->_lock);
+
+    // Done
+    return count;
+}
+
+size_t strset_contents ( strset *const p_strset, const char **const pp_contents )
+{
+
+    // Argument check
+    if ( p_strset    == (void *) 0 ) return 0;
+    if ( pp_contents == (void *) 0 ) return 0;
+
+    // Initialized data
+    size_t k = 0;
+
+    // Lock
+    set_rwlock_read_lock(&p_strset->_lock);
+
+    // Copy each string pointer
+    for (size_t i = 0; i < p_strset->max; i++)
+        if ( p_strset->p_slots[i].p_key && p_strset->p_slots[i].p_key != strset_tombstone )
+            pp_contents[k++] = p_strset->p_slots[i].p_key;
+
+    // Unlock
+    set_rwlock_read_unlock(&p_strset->_lock);
+
+    // Done
+    return k;
+}
+
+int strset_add ( strset *const p_strset, const char *const p_key )
+{
+
+    // Argument check
+    if ( p_strset == (void *) 0 ) goto no_strset;
+    if ( p_key    == (void *) 0 ) goto no_key;
+
+    // Initialized data
+    size_t      length = strlen(p_key);
+    uint64_t    hash   = strset_hash(p_key, length);
+    bool        found  = false;
+    size_t      slot   = 0;
+    const char *p_copy = (void *) 0;
+
+    // Lock
+    set_rwlock_write_lock(&p_strset->_lock);
+
+    // Search for the string
+    slot = strset_find(p_strset, p_key, length, hash, &found);
+
+    // If the string is a duplicate, there is nothing to do
+    if ( found ) goto done;
+
+    // If the index is too full, grow it, or sweep out its tombstones
+    if ( p_strset->p_slots[slot].p_key == (void *) 0 && p_strset->used + 1 > p_strset->max / 4 * 3 )
+    {
+
+        // Resize the index
+        if ( strset_resize(p_strset, ( p_strset->count + 1 > p_strset->max / 4 ) ? p_strset->max * 2 : p_strset->max) == 0 ) goto failed_to_grow_index;
+
+        // Find the insertion slot in the new index
+        slot = strset_find(p_strset, p_key, length, hash, &found);
+    }
+
+    // Copy the string into the arena
+    p_copy = strset_arena_copy(p_strset, p_key, length);
+
+    // Error check
+    if ( p_copy == (void *) 0 ) goto failed_to_copy;
+
+    // Account for the slot, unless it is a recycled tombstone
+    if ( p_strset->p_slots[slot].p_key == (void *) 0 ) p_strset->used++;
+
+    // Store the string
+    p_strset->p_slots[slot] = (strset_slot) { .hash = hash, .length = length, .p_key = p_copy };
+    p_strset->count++;
+
+    done:
+
+    // Unlock
+    set_rwlock_write_unlock(&p_strset->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_strset:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"p_strset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_key:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"p_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            failed_to_grow_index:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Failed to grow index in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_strset->_lock);
+
+                // Error
+                return 0;
+
+            failed_to_copy:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Failed to copy string in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Unlock
+                set_rwlock_write_unlock(&p_strset->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int strset_remove ( strset *const p_strset, const char *const p_key )
+{
+
+    // Argument check
+    if ( p_strset == (void *) 0 ) goto no_strset;
+    if ( p_key    == (void *) 0 ) goto no_key;
+
+    // Initialized data
+    size_t   length = strlen(p_key);
+    uint64_t hash   = strset_hash(p_key, length);
+    bool     found  = false;
+    size_t   slot   = 0;
+
+    // Lock
+    set_rwlock_write_lock(&p_strset->_lock);
+
+    // Search for the string
+    slot = strset_find(p_strset, p_key, length, hash, &found);
+
+    // Error check
+    if ( found == false ) goto no_element;
+
+    // Tombstone the slot
+    p_strset->p_slots[slot].p_key = strset_tombstone;
+    p_strset->count--;
+
+    // Unlock
+    set_rwlock_write_unlock(&p_strset->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_strset:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"p_strset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_key:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"p_key\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+
+        // Set errors
+        {
+            no_element:
+
+                // Unlock
+                set_rwlock_write_unlock(&p_strset->_lock);
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int strset_foreach_i ( strset *const p_strset, void (*const function)(void *const value, size_t index) )
+{
+
+    // Argument check
+    if ( p_strset == (void *) 0 ) goto no_strset;
+    if ( function == (void *) 0 ) goto no_function;
+
+    // Initialized data
+    size_t k = 0;
+
+    // Lock
+    set_rwlock_read_lock(&p_strset->_lock);
+
+    // Call the function on each string
+    for (size_t i = 0; i < p_strset->max; i++)
+        if ( p_strset->p_slots[i].p_key && p_strset->p_slots[i].p_key != strset_tombstone )
+            function((void *) p_strset->p_slots[i].p_key, k++);
+
+    // Unlock
+    set_rwlock_read_unlock(&p_strset->_lock);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_strset:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"p_strset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+
+            no_function:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"function\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}
+
+int strset_destroy ( strset **const pp_strset )
+{
+
+    // Argument check
+    if ( pp_strset  == (void *) 0 ) goto no_strset;
+    if ( *pp_strset == (void *) 0 ) goto no_strset;
+
+    // Initialized data
+    strset       *p_strset = *pp_strset;
+    strset_chunk *p_chunk  = p_strset->p_chunks;
+
+    // No more string set for caller
+    *pp_strset = (void *) 0;
+
+    // Free the arena
+    while ( p_chunk )
+    {
+
+        // Initialized data
+        strset_chunk *p_next = p_chunk->p_next;
+
+        // Free the chunk
+        SET_FREE(p_chunk);
+
+        // Next chunk
+        p_chunk = p_next;
+    }
+
+    // Free the index
+    SET_FREE(p_strset->p_slots);
+
+    // Destroy the lock
+    set_rwlock_destroy(&p_strset->_lock);
+
+    // Free the string set
+    SET_FREE(p_strset);
+
+    // Success
+    return 1;
+
+    // Error handling
+    {
+
+        // Argument errors
+        {
+            no_strset:
+                #ifndef NDEBUG
+                    printf("[set] [strset] Null pointer provided for parameter \"pp_strset\" in call to function \"%s\"\n", __FUNCTION__);
+                #endif
+
+                // Error
+                return 0;
+        }
+    }
+}